@@ -24,8 +24,10 @@
 
 #include "HandleStatementBridge.h"
 #include "AbstractHandle.hpp"
+#include "ColumnarBatch.hpp"
 #include "HandleStatement.hpp"
 #include "ObjectBridge.hpp"
+#include "RowDecoder.hpp"
 #include "UnsafeData.hpp"
 
 CPPError WCDBHandleStatementGetError(CPPHandleStatement handleStatement)
@@ -220,3 +222,112 @@ bool WCDBHandleStatementIsReadOnly(CPPHandleStatement handleStatement)
     handleStatement, WCDB::HandleStatement, cppHandleStatement, false);
     return cppHandleStatement->isReadOnly();
 }
+
+static_assert(sizeof(WCDBColumnarValue) == sizeof(WCDB::ColumnarBatch::Value), "");
+static_assert(sizeof(WCDB::Syntax::ColumnType) == sizeof(signed char), "");
+static_assert((int) WCDB::Syntax::ColumnType::Null == WCDBColumnarValueTypeNull, "");
+static_assert((int) WCDB::Syntax::ColumnType::Integer == WCDBColumnarValueTypeInteger, "");
+static_assert((int) WCDB::Syntax::ColumnType::Float == WCDBColumnarValueTypeFloat, "");
+static_assert((int) WCDB::Syntax::ColumnType::Text == WCDBColumnarValueTypeString, "");
+static_assert((int) WCDB::Syntax::ColumnType::BLOB == WCDBColumnarValueTypeBLOB, "");
+
+CPPColumnarBatch WCDBColumnarBatchCreate(int capacity)
+{
+    if (capacity <= 0) {
+        capacity = WCDB::ColumnarBatchDefaultNumberOfRows;
+    }
+    return WCDBCreateCPPBridgedObjectWithParameters(
+    CPPColumnarBatch, WCDB::ColumnarBatch, capacity);
+}
+
+bool WCDBHandleStatementStepBatch(CPPHandleStatement handleStatement, CPPColumnarBatch batch)
+{
+    WCDBGetObjectOrReturnValue(
+    handleStatement, WCDB::HandleStatement, cppHandleStatement, false);
+    WCDBGetObjectOrReturnValue(batch, WCDB::ColumnarBatch, cppBatch, false);
+    return cppHandleStatement->stepBatch(*cppBatch);
+}
+
+int WCDBColumnarBatchGetCapacity(CPPColumnarBatch batch)
+{
+    WCDBGetObjectOrReturnValue(batch, WCDB::ColumnarBatch, cppBatch, 0);
+    return cppBatch->getCapacity();
+}
+
+int WCDBColumnarBatchGetRowCount(CPPColumnarBatch batch)
+{
+    WCDBGetObjectOrReturnValue(batch, WCDB::ColumnarBatch, cppBatch, 0);
+    return cppBatch->getNumberOfRows();
+}
+
+int WCDBColumnarBatchGetColumnCount(CPPColumnarBatch batch)
+{
+    WCDBGetObjectOrReturnValue(batch, WCDB::ColumnarBatch, cppBatch, 0);
+    return cppBatch->getNumberOfColumns();
+}
+
+WCDBColumnarColumn WCDBColumnarBatchGetColumn(CPPColumnarBatch batch, int index)
+{
+    WCDBColumnarColumn column = { nullptr, nullptr, nullptr };
+    WCDBGetObjectOrReturnValue(batch, WCDB::ColumnarBatch, cppBatch, column);
+    if (index < 0 || index >= cppBatch->getNumberOfColumns()) {
+        return column;
+    }
+    column.types = reinterpret_cast<const signed char*>(cppBatch->getTypes(index));
+    column.values = reinterpret_cast<const WCDBColumnarValue*>(cppBatch->getValues(index));
+    column.sizes = reinterpret_cast<const unsigned long long*>(cppBatch->getSizes(index));
+    return column;
+}
+
+const unsigned char* _Nullable WCDBColumnarBatchGetBytes(CPPColumnarBatch batch)
+{
+    WCDBGetObjectOrReturnValue(batch, WCDB::ColumnarBatch, cppBatch, nullptr);
+    return cppBatch->getBytes();
+}
+
+static_assert(sizeof(WCDBRowSpan) == sizeof(WCDB::RowDecoder::Span), "");
+static_assert(offsetof(WCDBRowSpan, size) == offsetof(WCDB::RowDecoder::Span, size), "");
+static_assert(sizeof(signed long long) == sizeof(WCDB::RowDecoder::Integer), "");
+static_assert((int) WCDB::RowDecoder::FieldType::Integer == WCDBRowFieldTypeInteger, "");
+static_assert((int) WCDB::RowDecoder::FieldType::Float == WCDBRowFieldTypeFloat, "");
+static_assert((int) WCDB::RowDecoder::FieldType::Text == WCDBRowFieldTypeString, "");
+static_assert((int) WCDB::RowDecoder::FieldType::BLOB == WCDBRowFieldTypeBLOB, "");
+
+CPPRowDecoder WCDBRowDecoderCreate(const WCDBRowField* _Nonnull fields,
+                                   int fieldCount,
+                                   unsigned long long rowSize)
+{
+    if (fields == nullptr || fieldCount < 0 || rowSize == 0) {
+        return CPPRowDecoder();
+    }
+    std::vector<WCDB::RowDecoder::Field> cppFields;
+    cppFields.reserve(fieldCount);
+    for (int i = 0; i < fieldCount; ++i) {
+        cppFields.emplace_back(fields[i].columnIndex,
+                               (size_t) fields[i].offset,
+                               (WCDB::RowDecoder::FieldType) fields[i].type,
+                               (ssize_t) fields[i].nullFlagOffset);
+        if (!WCDB::RowDecoder::isValidField(cppFields.back(), (size_t) rowSize)) {
+            return CPPRowDecoder();
+        }
+    }
+    return WCDBCreateCPPBridgedObjectWithParameters(
+    CPPRowDecoder, WCDB::RowDecoder, cppFields, (size_t) rowSize);
+}
+
+int WCDBHandleStatementStepRows(CPPHandleStatement handleStatement,
+                                CPPRowDecoder decoder,
+                                void* _Nonnull rows,
+                                int capacity)
+{
+    WCDBGetObjectOrReturnValue(handleStatement, WCDB::HandleStatement, cppHandleStatement, -1);
+    WCDBGetObjectOrReturnValue(decoder, WCDB::RowDecoder, cppDecoder, -1);
+    if (rows == nullptr || capacity <= 0) {
+        return -1;
+    }
+    auto numberOfRows = cppHandleStatement->stepRows(*cppDecoder, rows, capacity);
+    if (!numberOfRows.succeed()) {
+        return -1;
+    }
+    return numberOfRows.value();
+}
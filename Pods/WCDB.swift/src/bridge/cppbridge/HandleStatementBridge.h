@@ -30,6 +30,8 @@
 WCDB_EXTERN_C_BEGIN
 
 WCDBDefineCPPBridgedType(CPPHandleStatement)
+WCDBDefineCPPBridgedType(CPPColumnarBatch)
+WCDBDefineCPPBridgedType(CPPRowDecoder)
 
 enum WCDBColumnValueType {
     WCDBColumnValueTypeInterger = 1,
@@ -86,4 +88,70 @@ const char* _Nullable WCDBHandleStatementGetColumnTableName(CPPHandleStatement h
 
 bool WCDBHandleStatementIsReadOnly(CPPHandleStatement handleStatement);
 
+enum WCDBColumnarValueType {
+    WCDBColumnarValueTypeNull = 0,
+    WCDBColumnarValueTypeInteger,
+    WCDBColumnarValueTypeFloat,
+    WCDBColumnarValueTypeString,
+    WCDBColumnarValueTypeBLOB,
+};
+
+typedef union WCDBColumnarValue {
+    signed long long intValue;
+    double doubleValue;
+    // offset of string and blob in the bytes of batch
+    unsigned long long offset;
+} WCDBColumnarValue;
+
+typedef struct WCDBColumnarColumn {
+    // WCDBColumnarValueType of each row
+    const signed char* _Nullable types;
+    const WCDBColumnarValue* _Nullable values;
+    // size of string and blob, excluding the null terminator of string
+    const unsigned long long* _Nullable sizes;
+} WCDBColumnarColumn;
+
+CPPColumnarBatch WCDBColumnarBatchCreate(int capacity);
+// Fill at most capacity rows into batch. Fewer rows than the capacity means that it's done.
+bool WCDBHandleStatementStepBatch(CPPHandleStatement handleStatement, CPPColumnarBatch batch);
+int WCDBColumnarBatchGetCapacity(CPPColumnarBatch batch);
+int WCDBColumnarBatchGetRowCount(CPPColumnarBatch batch);
+int WCDBColumnarBatchGetColumnCount(CPPColumnarBatch batch);
+WCDBColumnarColumn WCDBColumnarBatchGetColumn(CPPColumnarBatch batch, int index);
+const unsigned char* _Nullable WCDBColumnarBatchGetBytes(CPPColumnarBatch batch);
+
+enum WCDBRowFieldType {
+    WCDBRowFieldTypeInteger = 1,
+    WCDBRowFieldTypeFloat,
+    WCDBRowFieldTypeString,
+    WCDBRowFieldTypeBLOB,
+};
+
+typedef struct WCDBRowField {
+    int columnIndex;
+    // byte offset of the value in the row, which is signed long long, double or WCDBRowSpan
+    unsigned long long offset;
+    // byte offset of a bool in the row that tells whether the column is null, or -1 if it's not required
+    long long nullFlagOffset;
+    enum WCDBRowFieldType type;
+} WCDBRowField;
+
+typedef struct WCDBRowSpan {
+    // null-terminated for string
+    const unsigned char* _Nullable bytes;
+    // size excluding the null terminator of string
+    unsigned long long size;
+} WCDBRowSpan;
+
+// The layout is compiled once and can be reused by all the statements with the same result columns.
+CPPRowDecoder WCDBRowDecoderCreate(const WCDBRowField* _Nonnull fields,
+                                   int fieldCount,
+                                   unsigned long long rowSize);
+// Step and decode at most capacity rows into rows, whose spans are valid until the next time the decoder is used.
+// Fewer rows than the capacity means that it's done. It returns -1 on error.
+int WCDBHandleStatementStepRows(CPPHandleStatement handleStatement,
+                                CPPRowDecoder decoder,
+                                void* _Nonnull rows,
+                                int capacity);
+
 WCDB_EXTERN_C_END
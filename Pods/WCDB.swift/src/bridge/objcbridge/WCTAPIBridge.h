@@ -71,8 +71,16 @@ typedef NSArray<WCTBridgeProperty *> WCTBridgeProperties;
 
 + (void)configPinyinDict:(NSDictionary<NSString *, NSArray<NSString *> *> *)pinyinDict;
 
++ (BOOL)configPinyinDictFile:(NSString *)path;
+
++ (BOOL)savePinyinDict:(NSString *)path;
+
 + (void)configTraditionalChineseDict:(NSDictionary<NSString *, NSString *> *)traditionalChineseDict;
 
++ (BOOL)configTraditionalChineseDictFile:(NSString *)path;
+
++ (BOOL)saveTraditionalChineseDict:(NSString *)path;
+
 @end
 
 NS_ASSUME_NONNULL_END
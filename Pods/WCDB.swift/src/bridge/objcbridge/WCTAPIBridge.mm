@@ -150,9 +150,29 @@
     WCTFTSTokenizerUtil::configPinyinDict(pinyinDict);
 }
 
++ (BOOL)configPinyinDictFile:(NSString*)path
+{
+    return WCTFTSTokenizerUtil::configPinyinDictFile(WCDB::UnsafeStringView(path.UTF8String));
+}
+
++ (BOOL)savePinyinDict:(NSString*)path
+{
+    return WCTFTSTokenizerUtil::savePinyinDict(WCDB::UnsafeStringView(path.UTF8String));
+}
+
 + (void)configTraditionalChineseDict:(NSDictionary<NSString*, NSString*>*)traditionalChineseDict
 {
     WCTFTSTokenizerUtil::configTraditionalChineseDict(traditionalChineseDict);
 }
 
++ (BOOL)configTraditionalChineseDictFile:(NSString*)path
+{
+    return WCTFTSTokenizerUtil::configTraditionalChineseDictFile(WCDB::UnsafeStringView(path.UTF8String));
+}
+
++ (BOOL)saveTraditionalChineseDict:(NSString*)path
+{
+    return WCTFTSTokenizerUtil::saveTraditionalChineseDict(WCDB::UnsafeStringView(path.UTF8String));
+}
+
 @end
@@ -0,0 +1,499 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Checksum.hpp"
+#include "Assertion.hpp"
+#include <algorithm>
+#include <limits>
+#include <string.h>
+#include <zlib.h>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define WCDB_CHECKSUM_CRC32C_SSE42 1
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define WCDB_CHECKSUM_CRC32C_ARM64 1
+#include <arm_acle.h>
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace WCDB {
+
+#pragma mark - Algorithm
+bool Checksum::isValid(Algorithm algorithm)
+{
+    switch (algorithm) {
+    case Algorithm::CRC32:
+    case Algorithm::CRC32C:
+    case Algorithm::XXH3:
+        return true;
+    }
+    return false;
+}
+
+Checksum::Algorithm Checksum::defaultAlgorithm()
+{
+    return Algorithm::XXH3;
+}
+
+uint32_t Checksum::calculate(Algorithm algorithm, const unsigned char *buffer, size_t size)
+{
+    switch (algorithm) {
+    case Algorithm::CRC32:
+        return crc32(buffer, size);
+    case Algorithm::CRC32C:
+        return crc32c(buffer, size);
+    case Algorithm::XXH3:
+        return (uint32_t) xxh3(buffer, size);
+    }
+    WCTAssert(false);
+    return 0;
+}
+
+#pragma mark - CRC32
+uint32_t Checksum::crc32(const unsigned char *buffer, size_t size)
+{
+    // crc32 of zlib takes uInt as size.
+    uLong crc = 0;
+    while (size > 0) {
+        uInt length = (uInt) std::min<size_t>(size, std::numeric_limits<uInt>::max());
+        crc = ::crc32(crc, buffer, length);
+        buffer += length;
+        size -= length;
+    }
+    return (uint32_t) crc;
+}
+
+#pragma mark - CRC32C
+uint32_t Checksum::crc32c(const unsigned char *buffer, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    if (isCRC32CAccelerated()) {
+        crc = crc32cByHardware(crc, buffer, size);
+    } else {
+        crc = crc32cBySoftware(crc, buffer, size);
+    }
+    return ~crc;
+}
+
+bool Checksum::isCRC32CAccelerated()
+{
+#if defined(WCDB_CHECKSUM_CRC32C_SSE42)
+    static bool s_supported = __builtin_cpu_supports("sse4.2");
+    return s_supported;
+#elif defined(WCDB_CHECKSUM_CRC32C_ARM64)
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint32_t Checksum::crc32cBySoftware(uint32_t crc, const unsigned char *buffer, size_t size)
+{
+    // Slicing-by-8 with the reflected polynomial 0x82F63B78
+    typedef uint32_t Table[8][256];
+    static const Table *s_table = []() -> const Table * {
+        Table *table = (Table *) malloc(sizeof(Table));
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t value = i;
+            for (int j = 0; j < 8; ++j) {
+                value = (value >> 1) ^ (0x82F63B78 & (0 - (value & 1)));
+            }
+            (*table)[0][i] = value;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int j = 1; j < 8; ++j) {
+                uint32_t previous = (*table)[j - 1][i];
+                (*table)[j][i] = (previous >> 8) ^ (*table)[0][previous & 0xFF];
+            }
+        }
+        return table;
+    }();
+    const Table &table = *s_table;
+
+    while (size > 0 && ((uintptr_t) buffer & 7) != 0) {
+        crc = (crc >> 8) ^ table[0][(crc ^ *buffer++) & 0xFF];
+        --size;
+    }
+    while (size >= 8) {
+        uint32_t low = crc ^ ((uint32_t) buffer[0] | (uint32_t) buffer[1] << 8
+                              | (uint32_t) buffer[2] << 16 | (uint32_t) buffer[3] << 24);
+        crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF]
+              ^ table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24] ^ table[3][buffer[4]]
+              ^ table[2][buffer[5]] ^ table[1][buffer[6]] ^ table[0][buffer[7]];
+        buffer += 8;
+        size -= 8;
+    }
+    while (size > 0) {
+        crc = (crc >> 8) ^ table[0][(crc ^ *buffer++) & 0xFF];
+        --size;
+    }
+    return crc;
+}
+
+#if defined(WCDB_CHECKSUM_CRC32C_SSE42)
+__attribute__((target("sse4.2")))
+#endif
+uint32_t Checksum::crc32cByHardware(uint32_t crc, const unsigned char *buffer, size_t size)
+{
+#if defined(WCDB_CHECKSUM_CRC32C_SSE42)
+    while (size > 0 && ((uintptr_t) buffer & 7) != 0) {
+        crc = _mm_crc32_u8(crc, *buffer++);
+        --size;
+    }
+    uint64_t crc64 = crc;
+    while (size >= 32) {
+        uint64_t values[4];
+        memcpy(values, buffer, sizeof(values));
+        crc64 = _mm_crc32_u64(crc64, values[0]);
+        crc64 = _mm_crc32_u64(crc64, values[1]);
+        crc64 = _mm_crc32_u64(crc64, values[2]);
+        crc64 = _mm_crc32_u64(crc64, values[3]);
+        buffer += 32;
+        size -= 32;
+    }
+    while (size >= 8) {
+        uint64_t value;
+        memcpy(&value, buffer, sizeof(value));
+        crc64 = _mm_crc32_u64(crc64, value);
+        buffer += 8;
+        size -= 8;
+    }
+    crc = (uint32_t) crc64;
+    while (size > 0) {
+        crc = _mm_crc32_u8(crc, *buffer++);
+        --size;
+    }
+    return crc;
+#elif defined(WCDB_CHECKSUM_CRC32C_ARM64)
+    while (size > 0 && ((uintptr_t) buffer & 7) != 0) {
+        crc = __crc32cb(crc, *buffer++);
+        --size;
+    }
+    while (size >= 32) {
+        uint64_t values[4];
+        memcpy(values, buffer, sizeof(values));
+        crc = __crc32cd(crc, values[0]);
+        crc = __crc32cd(crc, values[1]);
+        crc = __crc32cd(crc, values[2]);
+        crc = __crc32cd(crc, values[3]);
+        buffer += 32;
+        size -= 32;
+    }
+    while (size >= 8) {
+        uint64_t value;
+        memcpy(&value, buffer, sizeof(value));
+        crc = __crc32cd(crc, value);
+        buffer += 8;
+        size -= 8;
+    }
+    while (size > 0) {
+        crc = __crc32cb(crc, *buffer++);
+        --size;
+    }
+    return crc;
+#else
+    return crc32cBySoftware(crc, buffer, size);
+#endif
+}
+
+#pragma mark - XXH3
+namespace XXH3 {
+
+static constexpr const uint32_t prime32_1 = 0x9E3779B1U;
+static constexpr const uint32_t prime32_2 = 0x85EBCA77U;
+static constexpr const uint32_t prime32_3 = 0xC2B2AE3DU;
+static constexpr const uint64_t prime64_1 = 0x9E3779B185EBCA87ULL;
+static constexpr const uint64_t prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr const uint64_t prime64_3 = 0x165667B19E3779F9ULL;
+static constexpr const uint64_t prime64_4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr const uint64_t prime64_5 = 0x27D4EB2F165667C5ULL;
+static constexpr const uint64_t primeMX1 = 0x165667919E3779F9ULL;
+static constexpr const uint64_t primeMX2 = 0x9FB21C651E98DF25ULL;
+
+static constexpr const size_t stripeSize = 64;
+static constexpr const size_t secretSize = 192;
+static constexpr const size_t secretConsumeRate = 8;
+static constexpr const size_t numberOfStripesPerBlock
+= (secretSize - stripeSize) / secretConsumeRate;
+static constexpr const size_t blockSize = stripeSize * numberOfStripesPerBlock;
+static constexpr const size_t midSizeMax = 240;
+
+// The default secret of xxHash
+alignas(64) static constexpr const unsigned char secret[secretSize] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+static inline uint64_t swap64(uint64_t value)
+{
+    return ((value << 56) & 0xff00000000000000ULL) | ((value << 40) & 0x00ff000000000000ULL)
+           | ((value << 24) & 0x0000ff0000000000ULL) | ((value << 8) & 0x000000ff00000000ULL)
+           | ((value >> 8) & 0x00000000ff000000ULL) | ((value >> 24) & 0x0000000000ff0000ULL)
+           | ((value >> 40) & 0x000000000000ff00ULL) | ((value >> 56) & 0x00000000000000ffULL);
+}
+
+static inline uint32_t read32(const unsigned char *buffer)
+{
+    uint32_t value;
+    memcpy(&value, buffer, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = (uint32_t) (swap64(value) >> 32);
+#endif
+    return value;
+}
+
+static inline uint64_t read64(const unsigned char *buffer)
+{
+    uint64_t value;
+    memcpy(&value, buffer, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = swap64(value);
+#endif
+    return value;
+}
+
+static inline uint64_t rotl64(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t mul128Fold64(uint64_t lhs, uint64_t rhs)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = (__uint128_t) lhs * rhs;
+    return (uint64_t) product ^ (uint64_t) (product >> 64);
+#else
+    uint64_t loLo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+    uint64_t hiLo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+    uint64_t loHi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+    uint64_t hiHi = (lhs >> 32) * (rhs >> 32);
+    uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+    uint64_t upper = (hiLo >> 32) + (cross >> 32) + hiHi;
+    uint64_t lower = (cross << 32) | (loLo & 0xFFFFFFFF);
+    return lower ^ upper;
+#endif
+}
+
+static inline uint64_t xxh64Avalanche(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= prime64_2;
+    hash ^= hash >> 29;
+    hash *= prime64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+static inline uint64_t avalanche(uint64_t hash)
+{
+    hash ^= hash >> 37;
+    hash *= primeMX1;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+static inline uint64_t rrmxmx(uint64_t hash, uint64_t length)
+{
+    hash ^= rotl64(hash, 49) ^ rotl64(hash, 24);
+    hash *= primeMX2;
+    hash ^= (hash >> 35) + length;
+    hash *= primeMX2;
+    return hash ^ (hash >> 28);
+}
+
+static inline uint64_t mix16Bytes(const unsigned char *input, const unsigned char *key)
+{
+    return mul128Fold64(read64(input) ^ read64(key), read64(input + 8) ^ read64(key + 8));
+}
+
+static uint64_t hashUpTo16Bytes(const unsigned char *input, size_t length)
+{
+    if (length > 8) {
+        uint64_t low = read64(input) ^ (read64(secret + 24) ^ read64(secret + 32));
+        uint64_t high = read64(input + length - 8) ^ (read64(secret + 40) ^ read64(secret + 48));
+        return avalanche(length + swap64(low) + high + mul128Fold64(low, high));
+    } else if (length >= 4) {
+        uint64_t value = read32(input + length - 4) + ((uint64_t) read32(input) << 32);
+        return rrmxmx(value ^ (read64(secret + 8) ^ read64(secret + 16)), length);
+    } else if (length > 0) {
+        uint32_t combined = ((uint32_t) input[0] << 16) | ((uint32_t) input[length >> 1] << 24)
+                            | (uint32_t) input[length - 1] | ((uint32_t) length << 8);
+        return xxh64Avalanche(combined ^ (uint64_t) (read32(secret) ^ read32(secret + 4)));
+    }
+    return xxh64Avalanche(read64(secret + 56) ^ read64(secret + 64));
+}
+
+static uint64_t hashUpTo128Bytes(const unsigned char *input, size_t length)
+{
+    uint64_t acc = length * prime64_1;
+    if (length > 32) {
+        if (length > 64) {
+            if (length > 96) {
+                acc += mix16Bytes(input + 48, secret + 96);
+                acc += mix16Bytes(input + length - 64, secret + 112);
+            }
+            acc += mix16Bytes(input + 32, secret + 64);
+            acc += mix16Bytes(input + length - 48, secret + 80);
+        }
+        acc += mix16Bytes(input + 16, secret + 32);
+        acc += mix16Bytes(input + length - 32, secret + 48);
+    }
+    acc += mix16Bytes(input, secret);
+    acc += mix16Bytes(input + length - 16, secret + 16);
+    return avalanche(acc);
+}
+
+static uint64_t hashUpTo240Bytes(const unsigned char *input, size_t length)
+{
+    uint64_t acc = length * prime64_1;
+    int numberOfRounds = (int) length / 16;
+    for (int i = 0; i < 8; ++i) {
+        acc += mix16Bytes(input + 16 * i, secret + 16 * i);
+    }
+    acc = avalanche(acc);
+    for (int i = 8; i < numberOfRounds; ++i) {
+        acc += mix16Bytes(input + 16 * i, secret + 16 * (i - 8) + 3);
+    }
+    acc += mix16Bytes(input + length - 16, secret + 136 - 17);
+    return avalanche(acc);
+}
+
+static inline void accumulateStripe(uint64_t *acc, const unsigned char *input, const unsigned char *key)
+{
+#if defined(__SSE2__)
+    __m128i *xacc = (__m128i *) acc;
+    for (int i = 0; i < 4; ++i) {
+        __m128i data = _mm_loadu_si128((const __m128i *) input + i);
+        __m128i dataKey = _mm_xor_si128(data, _mm_loadu_si128((const __m128i *) key + i));
+        __m128i dataKeyHigh = _mm_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1));
+        __m128i product = _mm_mul_epu32(dataKey, dataKeyHigh);
+        __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        xacc[i] = _mm_add_epi64(product, _mm_add_epi64(xacc[i], swapped));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (int i = 0; i < 4; ++i) {
+        uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(input + 16 * i));
+        uint64x2_t dataKey = veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(key + 16 * i)));
+        uint64x2_t sum = vaddq_u64(vld1q_u64(acc + 2 * i), vextq_u64(data, data, 1));
+        sum = vmlal_u32(sum, vmovn_u64(dataKey), vshrn_n_u64(dataKey, 32));
+        vst1q_u64(acc + 2 * i, sum);
+    }
+#else
+    for (int i = 0; i < 8; ++i) {
+        uint64_t data = read64(input + 8 * i);
+        uint64_t dataKey = data ^ read64(key + 8 * i);
+        acc[i ^ 1] += data;
+        acc[i] += (dataKey & 0xFFFFFFFF) * (dataKey >> 32);
+    }
+#endif
+}
+
+static inline void scramble(uint64_t *acc, const unsigned char *key)
+{
+#if defined(__SSE2__)
+    __m128i *xacc = (__m128i *) acc;
+    const __m128i prime = _mm_set1_epi32((int) prime32_1);
+    for (int i = 0; i < 4; ++i) {
+        __m128i value = _mm_xor_si128(xacc[i], _mm_srli_epi64(xacc[i], 47));
+        value = _mm_xor_si128(value, _mm_loadu_si128((const __m128i *) key + i));
+        __m128i valueHigh = _mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1));
+        __m128i productLow = _mm_mul_epu32(value, prime);
+        __m128i productHigh = _mm_mul_epu32(valueHigh, prime);
+        xacc[i] = _mm_add_epi64(productLow, _mm_slli_epi64(productHigh, 32));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint32x2_t prime = vdup_n_u32(prime32_1);
+    for (int i = 0; i < 4; ++i) {
+        uint64x2_t value = vld1q_u64(acc + 2 * i);
+        value = veorq_u64(value, vshrq_n_u64(value, 47));
+        value = veorq_u64(value, vreinterpretq_u64_u8(vld1q_u8(key + 16 * i)));
+        uint64x2_t productHigh = vshlq_n_u64(vmull_u32(vshrn_n_u64(value, 32), prime), 32);
+        vst1q_u64(acc + 2 * i, vmlal_u32(productHigh, vmovn_u64(value), prime));
+    }
+#else
+    for (int i = 0; i < 8; ++i) {
+        uint64_t value = acc[i];
+        value ^= value >> 47;
+        value ^= read64(key + 8 * i);
+        acc[i] = value * prime32_1;
+    }
+#endif
+}
+
+static uint64_t hashLong(const unsigned char *input, size_t length)
+{
+    alignas(16) uint64_t acc[8] = { prime32_3, prime64_1, prime64_2, prime64_3,
+                                    prime64_4, prime32_2, prime64_5, prime32_1 };
+    size_t numberOfBlocks = (length - 1) / blockSize;
+    for (size_t n = 0; n < numberOfBlocks; ++n) {
+        const unsigned char *block = input + n * blockSize;
+        for (size_t s = 0; s < numberOfStripesPerBlock; ++s) {
+            accumulateStripe(acc, block + s * stripeSize, secret + s * secretConsumeRate);
+        }
+        scramble(acc, secret + secretSize - stripeSize);
+    }
+    size_t numberOfStripes = ((length - 1) - blockSize * numberOfBlocks) / stripeSize;
+    const unsigned char *block = input + numberOfBlocks * blockSize;
+    for (size_t s = 0; s < numberOfStripes; ++s) {
+        accumulateStripe(acc, block + s * stripeSize, secret + s * secretConsumeRate);
+    }
+    accumulateStripe(acc, input + length - stripeSize, secret + secretSize - stripeSize - 7);
+
+    uint64_t result = length * prime64_1;
+    for (int i = 0; i < 4; ++i) {
+        const unsigned char *key = secret + 11 + 16 * i;
+        result += mul128Fold64(acc[2 * i] ^ read64(key), acc[2 * i + 1] ^ read64(key + 8));
+    }
+    return avalanche(result);
+}
+
+} // namespace XXH3
+
+uint64_t Checksum::xxh3(const unsigned char *buffer, size_t size)
+{
+    if (size <= 16) {
+        return XXH3::hashUpTo16Bytes(buffer, size);
+    } else if (size <= 128) {
+        return XXH3::hashUpTo128Bytes(buffer, size);
+    } else if (size <= XXH3::midSizeMax) {
+        return XXH3::hashUpTo240Bytes(buffer, size);
+    }
+    return XXH3::hashLong(buffer, size);
+}
+
+} // namespace WCDB
@@ -0,0 +1,64 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Macro.h"
+#include "SysTypes.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace WCDB {
+
+// All algorithms are available on every platform, so that the checksums are portable.
+// The hardware instructions are used if they are supported.
+class WCDB_API Checksum final {
+public:
+    Checksum() = delete;
+    Checksum(const Checksum &) = delete;
+    Checksum &operator=(const Checksum &) = delete;
+
+    enum class Algorithm : uint32_t {
+        CRC32 = 0,  // zlib crc32
+        CRC32C = 1, // Castagnoli crc32, accelerated by SSE4.2 or ARMv8 CRC extension
+        XXH3 = 2,   // Lower 32 bits of 64 bits xxHash3
+    };
+    static bool isValid(Algorithm algorithm);
+    // XXH3, which is the fastest one even if CRC32C is accelerated by hardware.
+    static Algorithm defaultAlgorithm();
+
+    static uint32_t calculate(Algorithm algorithm, const unsigned char *buffer, size_t size);
+
+    static uint32_t crc32(const unsigned char *buffer, size_t size);
+    static uint32_t crc32c(const unsigned char *buffer, size_t size);
+    static uint64_t xxh3(const unsigned char *buffer, size_t size);
+
+    static bool isCRC32CAccelerated();
+
+protected:
+    static uint32_t crc32cBySoftware(uint32_t crc, const unsigned char *buffer, size_t size);
+    static uint32_t crc32cByHardware(uint32_t crc, const unsigned char *buffer, size_t size);
+};
+
+} // namespace WCDB
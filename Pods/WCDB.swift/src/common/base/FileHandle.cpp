@@ -28,6 +28,7 @@
 #include "FileManager.hpp"
 #include "Notifier.hpp"
 #include <errno.h>
+#include <climits>
 #include <fcntl.h>
 #ifndef _WIN32
 #include <sys/mman.h>
@@ -339,6 +340,22 @@ UnsafeData FileHandle::mapOrReadAllData()
     return UnsafeData::null();
 }
 
+void FileHandle::prefetch(offset_t offset, size_t size)
+{
+    WCTAssert(isOpened());
+#if defined(F_RDADVISE)
+    struct radvisory advisory;
+    advisory.ra_offset = (off_t) offset;
+    advisory.ra_count = (int) std::min(size, (size_t) INT_MAX);
+    fcntl(m_fd, F_RDADVISE, &advisory);
+#elif defined(POSIX_FADV_WILLNEED)
+    posix_fadvise(m_fd, (off_t) offset, (off_t) size, POSIX_FADV_WILLNEED);
+#else
+    WCDB_UNUSED(offset)
+    WCDB_UNUSED(size)
+#endif
+}
+
 const size_t &FileHandle::memoryPageSize()
 {
 #ifndef _WIN32
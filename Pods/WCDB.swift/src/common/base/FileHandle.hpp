@@ -75,6 +75,8 @@ protected:
 public:
     MappedData map(offset_t offset, size_t size, SharedHighWater highWater = nullptr);
     UnsafeData mapOrReadAllData();
+    // Hint the system to read the range ahead. It's best effort and never fails.
+    void prefetch(offset_t offset, size_t size);
 
 protected:
     static const size_t &memoryPageSize();
@@ -50,82 +50,166 @@ void Conditional::notify(const Thread &thread)
 #endif
 
 #pragma mark - Shared Lock
-SharedLock::SharedLock()
-: m_readers(0), m_writers(0), m_pendingReaders(0), m_threadedReaders(0)
+SharedLock::ReaderStripe::ReaderStripe() : readers(0)
+{
+}
+
+SharedLock::SharedLock() : m_blocking(false), m_writers(0), m_pendingReaders(0)
 {
 }
 
 SharedLock::~SharedLock()
 {
     WCTRemedialAssert(m_writers == 0 && m_pendingWriters.size() == 0, "Unpaired lock", ;);
-    WCTRemedialAssert(m_readers == 0 && m_pendingReaders == 0, "Unpaired shared lock", ;);
+    WCTRemedialAssert(
+    numberOfReaders() == 0 && m_pendingReaders == 0, "Unpaired shared lock", ;);
+}
+
+std::vector<SharedLock::Reentrancy> &SharedLock::threadedReentrancies()
+{
+    // It's expected that a thread holds only a few locks at the same time, so a linear search is faster than a map.
+    thread_local std::vector<Reentrancy> s_reentrancies;
+    return s_reentrancies;
+}
+
+int SharedLock::threadedStripe()
+{
+    static std::atomic<int> *s_numberOfThreads = new std::atomic<int>(0);
+    thread_local int s_stripe
+    = s_numberOfThreads->fetch_add(1, std::memory_order_relaxed) % SharedLockNumberOfReaderStripes;
+    return s_stripe;
+}
+
+SharedLock::Reentrancy *SharedLock::threadedReentrancy() const
+{
+    for (auto &reentrancy : threadedReentrancies()) {
+        if (reentrancy.lock == this) {
+            return &reentrancy;
+        }
+    }
+    return nullptr;
+}
+
+SharedLock::Reentrancy &SharedLock::threadedReentrancyOrCreate() const
+{
+    Reentrancy *reentrancy = threadedReentrancy();
+    if (reentrancy != nullptr) {
+        return *reentrancy;
+    }
+    auto &reentrancies = threadedReentrancies();
+    reentrancies.push_back({ this, 0, false });
+    return reentrancies.back();
+}
+
+void SharedLock::purgeThreadedReentrancy() const
+{
+    auto &reentrancies = threadedReentrancies();
+    for (auto iter = reentrancies.begin(); iter != reentrancies.end(); ++iter) {
+        if (iter->lock == this) {
+            if (iter->readers == 0 && !iter->writing) {
+                *iter = reentrancies.back();
+                reentrancies.pop_back();
+            }
+            break;
+        }
+    }
+}
+
+int SharedLock::numberOfReaders() const
+{
+    int readers = 0;
+    for (const auto &stripe : m_stripes) {
+        readers += stripe.readers.load();
+    }
+    return readers;
+}
+
+void SharedLock::notifyPendingWriter()
+{
+    // it should be called with m_lock held
+    if (m_writers == 0 && m_pendingWriters.size() > 0) {
+#ifdef __APPLE__
+        m_conditionalWriters.notify(m_pendingWriters.front());
+#else
+        m_conditionalWriters.notify_all();
+#endif
+    }
 }
 
 void SharedLock::lockShared()
 {
+    Reentrancy &reentrancy = threadedReentrancyOrCreate();
+    std::atomic<int> &readers = m_stripes[threadedStripe()].readers;
+    readers.fetch_add(1);
+    if (reentrancy.readers > 0 || reentrancy.writing) {
+        // it's already shared locked by current thread
+        // or it's already locked by current thread
+        ++reentrancy.readers;
+        return;
+    }
+    if (!m_blocking.load()) {
+        // it's not locked and there is no one pending to lock
+        ++reentrancy.readers;
+        return;
+    }
+    // If it is locked but not current thread, it should wait for the write lock.
+    // If it is not locked but there is someone pending to lock and current thread is not already shared locked, it should wait for the pending lock to avoid the pending lock starve.
+    readers.fetch_sub(1);
     std::unique_lock<std::mutex> lockGuard(m_lock);
-    if (m_writers > 0 ?
-        !m_locking.isCurrentThread() :
-        (m_pendingWriters.size() > 0 && m_threadedReaders.getOrCreate() == 0)) {
-        // If it is locked but not current thread, it should wait for the write lock.
-        // If it is not locked but there is someone pending to lock and current thread is not already shared locked, it should wait for the pending lock to avoid the pending lock starve.
+    if (numberOfReaders() == 0) {
+        notifyPendingWriter();
+    }
+    if (m_blocking.load()) {
         ++m_pendingReaders;
         do {
             m_conditionalReaders.wait(lockGuard);
-        } while (m_writers > 0 || m_pendingWriters.size() > 0);
+        } while (m_blocking.load());
         --m_pendingReaders;
     }
-    // it's already locked by current thread
-    // or it's already shared locked by current thread
-    // or it's not locked
-    WCTAssert(m_locking.isCurrentThread() || m_threadedReaders.getOrCreate() > 0
-              || m_writers == 0);
-    ++m_readers;
-    ++m_threadedReaders.getOrCreate();
+    // Writers raise the blocking flag with m_lock held, so it can't be locked before the count is seen.
+    readers.fetch_add(1);
+    ++reentrancy.readers;
 }
 
 void SharedLock::unlockShared()
 {
-    int &threadedReader = m_threadedReaders.getOrCreate();
-    WCTRemedialAssert(threadedReader > 0, "Unpaired unlock shared.", return;);
-    WCTAssert(threadedReader > 0);
+    Reentrancy *reentrancy = threadedReentrancy();
+    WCTRemedialAssert(reentrancy != nullptr && reentrancy->readers > 0,
+                      "Unpaired unlock shared.",
+                      return;);
 
-    std::unique_lock<std::mutex> lockGuard(m_lock);
-    WCTAssert(m_readers > 0);
-    --threadedReader;
-    --m_readers;
-    if (m_readers == 0) {
-        WCTAssert(m_threadedReaders.getOrCreate() == 0);
-        if (m_writers == 0 && m_pendingWriters.size() > 0) {
-#ifdef __APPLE__
-            m_conditionalWriters.notify(m_pendingWriters.front());
-#else
-            m_conditionalWriters.notify_all();
-#endif
-        }
+    --reentrancy->readers;
+    purgeThreadedReentrancy();
+    m_stripes[threadedStripe()].readers.fetch_sub(1);
+    if (m_blocking.load() && numberOfReaders() == 0) {
+        std::unique_lock<std::mutex> lockGuard(m_lock);
+        notifyPendingWriter();
     }
 }
 
 void SharedLock::lock()
 {
-    WCTRemedialAssert(
-    m_threadedReaders.getOrCreate() == 0, "Upgrade lock is not supported.", return;);
+    Reentrancy &reentrancy = threadedReentrancyOrCreate();
+    WCTRemedialAssert(reentrancy.readers == 0, "Upgrade lock is not supported.", return;);
 
-    Thread current = Thread::current();
     std::unique_lock<std::mutex> lockGuard(m_lock);
-    if (!m_locking.equal(current)) {
+    if (!reentrancy.writing) {
+        Thread current = Thread::current();
         m_pendingWriters.emplace(current);
-        while (m_readers > 0 || m_writers > 0 || !m_pendingWriters.front().equal(current)) {
+        m_blocking.store(true);
+        while (m_writers > 0 || !m_pendingWriters.front().equal(current)
+               || numberOfReaders() > 0) {
             m_conditionalWriters.wait(lockGuard);
         }
         WCTAssert(m_pendingWriters.front().isCurrentThread());
         m_pendingWriters.pop();
+        m_locking = current;
+        reentrancy.writing = true;
     }
     // it's already locked by current thread
     // or it's not locked and it's not shared locked
-    WCTAssert(m_locking.isCurrentThread() || (m_writers == 0 && m_readers == 0));
+    WCTAssert(m_locking.isCurrentThread());
     ++m_writers;
-    m_locking = Thread::current();
 }
 
 bool SharedLock::isLocked()
@@ -135,34 +219,39 @@ bool SharedLock::isLocked()
 
 void SharedLock::unlock()
 {
-    WCTRemedialAssert(
-    m_threadedReaders.getOrCreate() == 0, "Downgrade lock is not supported.", return;);
+    Reentrancy *reentrancy = threadedReentrancy();
+    WCTRemedialAssert(reentrancy == nullptr || reentrancy->readers == 0,
+                      "Downgrade lock is not supported.",
+                      return;);
 
     std::unique_lock<std::mutex> lockGuard(m_lock);
-    WCTRemedialAssert(m_locking.isCurrentThread(), "Unpaired unlock.", return;);
-    WCTAssert(m_readers == 0);
+    WCTRemedialAssert(reentrancy != nullptr && reentrancy->writing, "Unpaired unlock.", return;);
+    WCTAssert(m_locking.isCurrentThread());
     WCTAssert(m_writers > 0);
     if (--m_writers == 0) {
         m_locking = nullptr;
+        reentrancy->writing = false;
+        purgeThreadedReentrancy();
         // write lock first
         if (m_pendingWriters.size() > 0) {
-#ifdef __APPLE__
-            m_conditionalWriters.notify(m_pendingWriters.front());
-#else
-            m_conditionalWriters.notify_all();
-#endif
-        } else if (m_pendingReaders > 0) {
-            m_conditionalReaders.notify_all();
+            notifyPendingWriter();
+        } else {
+            m_blocking.store(false);
+            if (m_pendingReaders > 0) {
+                m_conditionalReaders.notify_all();
+            }
         }
     }
 }
 
 SharedLock::Level SharedLock::level() const
 {
-    std::unique_lock<std::mutex> lockGuard(m_lock);
-    if (m_locking.isCurrentThread()) {
+    const Reentrancy *reentrancy = threadedReentrancy();
+    if (reentrancy == nullptr) {
+        return Level::None;
+    } else if (reentrancy->writing) {
         return Level::Write;
-    } else if ((m_threadedReaders.getOrCreate()) > 0) {
+    } else if (reentrancy->readers > 0) {
         return Level::Read;
     }
     return Level::None;
@@ -31,6 +31,7 @@
 #include <functional>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 namespace WCDB {
 
@@ -45,6 +46,8 @@ public:
 };
 
 #pragma mark - Shared Lock
+static constexpr const int SharedLockNumberOfReaderStripes = 8;
+
 // TODO:
 // std::shared_timed_mutex is supported since iOS 10 and macOS 10.12.
 // std::shared_mutex is supported in a more recent version.
@@ -71,16 +74,38 @@ public:
     bool writeSafety() const;
 
 protected:
+    // Readers are counted on striped atomics without touching the mutex.
+    // Writers raise m_blocking to turn new readers to the slow path and then wait for the counts to drain.
+    struct ReaderStripe {
+        ReaderStripe();
+        std::atomic<int> readers;
+        // avoid false sharing between stripes
+        char padding[64 - sizeof(std::atomic<int>)];
+    };
+    ReaderStripe m_stripes[SharedLockNumberOfReaderStripes];
+    std::atomic<bool> m_blocking;
+    int numberOfReaders() const;
+    void notifyPendingWriter();
+
     mutable std::mutex m_lock;
     Conditional m_conditionalReaders;
     Conditional m_conditionalWriters;
-    int m_readers;
     int m_writers;
     int m_pendingReaders;
     std::queue<Thread> m_pendingWriters;
     Thread m_locking;
-    // mutable since it can be only modified threaded
-    mutable ThreadLocal<int> m_threadedReaders;
+
+    // Reentrancy of current thread, which is tracked without any lock.
+    struct Reentrancy {
+        const SharedLock *lock;
+        int readers;
+        bool writing;
+    };
+    static std::vector<Reentrancy> &threadedReentrancies();
+    static int threadedStripe();
+    Reentrancy *threadedReentrancy() const;
+    Reentrancy &threadedReentrancyOrCreate() const;
+    void purgeThreadedReentrancy() const;
 };
 
 #pragma mark - Lock Guard
@@ -24,25 +24,69 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
-#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace WCDB {
 
+/*
+ * Each ThreadLocal occupies a dense slot index, so that the threaded value can be found in O(1).
+ * Slot indexes of destroyed ThreadLocals are reused. Generation is used to distinguish the stale value of the previous owner from the current one.
+ */
 template<typename T>
 class UntypedThreadLocal {
 protected:
-    typedef unsigned int Identifier;
-    static Identifier nextIdentifier()
+    typedef unsigned int Index;
+    typedef unsigned int Generation;
+    struct Identifier {
+        Index index;
+        Generation generation;
+    };
+    struct Slots {
+        std::mutex lock;
+        std::vector<Generation> generations;
+        std::vector<Index> frees;
+    };
+    static Slots& slots()
+    {
+        static Slots* s_slots = new Slots;
+        return *s_slots;
+    }
+    static Identifier acquireIdentifier()
     {
-        static std::atomic<Identifier>* s_identifier = new std::atomic<Identifier>(0);
-        return ++(*s_identifier);
+        Slots& slots = UntypedThreadLocal<T>::slots();
+        std::lock_guard<std::mutex> lockGuard(slots.lock);
+        Identifier identifier;
+        if (!slots.frees.empty()) {
+            identifier.index = slots.frees.back();
+            slots.frees.pop_back();
+        } else {
+            identifier.index = (Index) slots.generations.size();
+            slots.generations.push_back(0);
+        }
+        // 0 is reserved for the empty slot
+        identifier.generation = ++slots.generations[identifier.index];
+        return identifier;
     }
-    static std::map<Identifier, T>& threadedStorage()
+    static void releaseIdentifier(const Identifier& identifier)
     {
-        thread_local std::unique_ptr<std::map<Identifier, T>> s_storage(
-        new std::map<Identifier, T>());
+        Slots& slots = UntypedThreadLocal<T>::slots();
+        std::lock_guard<std::mutex> lockGuard(slots.lock);
+        slots.frees.push_back(identifier.index);
+    }
+
+    struct Slot {
+        Slot() : generation(0) {}
+        Generation generation;
+        // value is kept in heap so that the reference is still valid after the storage grows.
+        std::unique_ptr<T> value;
+    };
+    static std::vector<Slot>& threadedStorage()
+    {
+        thread_local std::unique_ptr<std::vector<Slot>> s_storage(new std::vector<Slot>());
         return *s_storage;
     }
 };
@@ -50,32 +94,44 @@ protected:
 template<typename T>
 class ThreadLocal : public UntypedThreadLocal<T> {
 public:
-    using UntypedThreadLocal<T>::nextIdentifier;
+    using UntypedThreadLocal<T>::acquireIdentifier;
+    using UntypedThreadLocal<T>::releaseIdentifier;
     using UntypedThreadLocal<T>::threadedStorage;
     using Identifier = typename UntypedThreadLocal<T>::Identifier;
+    using Slot = typename UntypedThreadLocal<T>::Slot;
     ThreadLocal(const typename std::enable_if<std::is_default_constructible<T>::value>::type* = nullptr)
-    : m_identifier(nextIdentifier()), m_default()
+    : m_identifier(acquireIdentifier()), m_default()
     {
     }
 
     ThreadLocal(const T& defaultValue)
-    : m_identifier(nextIdentifier()), m_default(defaultValue)
+    : m_identifier(acquireIdentifier()), m_default(defaultValue)
     {
     }
 
     ThreadLocal(T&& defaultValue)
-    : m_identifier(nextIdentifier()), m_default(std::move(defaultValue))
+    : m_identifier(acquireIdentifier()), m_default(std::move(defaultValue))
     {
     }
 
+    ~ThreadLocal() { releaseIdentifier(m_identifier); }
+
+    ThreadLocal(const ThreadLocal&) = delete;
+    ThreadLocal& operator=(const ThreadLocal&) = delete;
+
     T& getOrCreate()
     {
         auto& storage = threadedStorage();
-        auto iter = storage.find(m_identifier);
-        if (iter == storage.end()) {
-            iter = storage.emplace(m_identifier, m_default).first;
+        if (m_identifier.index >= storage.size()) {
+            // amortized growth
+            storage.resize(std::max<size_t>(m_identifier.index + 1, storage.size() * 2));
+        }
+        Slot& slot = storage[m_identifier.index];
+        if (slot.generation != m_identifier.generation) {
+            slot.value.reset(new T(m_default));
+            slot.generation = m_identifier.generation;
         }
-        return *(&iter->second);
+        return *slot.value;
     }
 
 private:
@@ -135,6 +135,11 @@ uint32_t UnsafeData::hash() const
     return (uint32_t) crc32(0, buffer(), (uint32_t) size());
 }
 
+uint32_t UnsafeData::hash(Checksum::Algorithm algorithm) const
+{
+    return Checksum::calculate(algorithm, buffer(), size());
+}
+
 const unsigned char *UnsafeData::buffer() const
 {
     return m_buffer ? m_buffer : emptyBuffer();
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "Checksum.hpp"
 #include "Recyclable.hpp"
 #include "SharedThreadedErrorProne.hpp"
 #include "SysTypes.h"
@@ -100,6 +101,7 @@ private:
 public:
     size_t size() const;
     uint32_t hash() const;
+    uint32_t hash(Checksum::Algorithm algorithm) const;
 
     //Nota that buffer will never be null.
     const unsigned char *buffer() const;
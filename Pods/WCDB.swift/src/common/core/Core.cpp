@@ -31,6 +31,7 @@
 #include "Global.hpp"
 #include "Notifier.hpp"
 #include "OneOrBinaryTokenizer.hpp"
+#include "PageCache.hpp"
 #include "PinyinTokenizer.hpp"
 #include "SQLite.h"
 #include "StringView.hpp"
@@ -208,33 +209,71 @@ void Core::backupShouldBeOperated(const UnsafeStringView& path)
     }
 }
 
-void Core::checkpointShouldBeOperated(const UnsafeStringView& path)
+Optional<bool> Core::checkpointShouldBeOperated(const UnsafeStringView& path,
+                                                AutoCheckpointOperator::CheckpointMode mode)
 {
     RecyclableDatabase database = m_databasePool.getOrCreate(path);
-    if (database != nullptr) {
-        database->checkpoint(true);
+    if (database == nullptr) {
+        return true; // mark as done if database is not referenced.
+    }
+    if (mode == AutoCheckpointOperator::CheckpointMode::Incremental) {
+        return database->checkpointFrames(true, AutoCheckpointNumberOfFramesPerStep);
+    }
+    if (!database->checkpoint(true, mode)) {
+        return NullOpt;
     }
+    return true;
 }
 
-void Core::integrityShouldBeChecked(const UnsafeStringView& path)
+Optional<bool> Core::integrityShouldBeChecked(const UnsafeStringView& path)
 {
     RecyclableDatabase database = m_databasePool.getOrCreate(path);
-    if (database != nullptr) {
-        database->checkIntegrity(true);
+    if (database == nullptr) {
+        std::lock_guard<std::mutex> lockGuard(m_integrityLock);
+        m_integrityCheckingPaths.erase(path);
+        return true; // mark as done if database is not referenced.
+    }
 
-        std::set<StringView> sourcePaths = database->getPathsOfSourceDatabases();
-        for (const UnsafeStringView& sourcePath : sourcePaths) {
-            RecyclableDatabase sourceDatabase = m_databasePool.getOrCreate(sourcePath);
-            if (sourceDatabase != nullptr) {
-                sourceDatabase->checkIntegrity(true);
-            }
+    StringView checkingPath;
+    {
+        std::lock_guard<std::mutex> lockGuard(m_integrityLock);
+        auto iter = m_integrityCheckingPaths.find(path);
+        checkingPath = iter != m_integrityCheckingPaths.end() ? iter->second : StringView(path);
+    }
+
+    Optional<bool> done = true; // mark as done if database is not referenced.
+    if (checkingPath.equal(path)) {
+        done = database->checkIntegrity(true);
+    } else {
+        RecyclableDatabase sourceDatabase = m_databasePool.getOrCreate(checkingPath);
+        if (sourceDatabase != nullptr) {
+            done = sourceDatabase->checkIntegrity(true);
         }
     }
+    if (!done.succeed() || !done.value()) {
+        return done;
+    }
+
+    // Move to the next source database, which are checked in the order of path.
+    std::set<StringView> sourcePaths = database->getPathsOfSourceDatabases();
+    auto next = checkingPath.equal(path) ? sourcePaths.begin() :
+                                           sourcePaths.upper_bound(checkingPath);
+    while (next != sourcePaths.end() && next->equal(path)) {
+        ++next;
+    }
+    std::lock_guard<std::mutex> lockGuard(m_integrityLock);
+    if (next == sourcePaths.end()) {
+        m_integrityCheckingPaths.erase(path);
+        return true;
+    }
+    m_integrityCheckingPaths.insert_or_assign(path, *next);
+    return false;
 }
 
 void Core::purgeShouldBeOperated()
 {
     purgeDatabasePool();
+    Repair::PageCache::shared().purge();
 }
 
 bool Core::isFileObservedCorrupted(const UnsafeStringView& path)
@@ -294,6 +333,16 @@ void Core::enableAutoCheckpoint(InnerDatabase* database, bool enable)
     }
 }
 
+void Core::setAutoCheckpointTargetNumberOfFrames(int numberOfFrames)
+{
+    m_autoCheckpointConfig->setTargetNumberOfFrames(numberOfFrames);
+}
+
+Optional<AutoCheckpointConfig::WalMetrics> Core::getWalMetrics(const UnsafeStringView& path) const
+{
+    return m_autoCheckpointConfig->getWalMetrics(path);
+}
+
 #pragma mark - Backup
 void Core::enableAutoBackup(InnerDatabase* database, bool enable)
 {
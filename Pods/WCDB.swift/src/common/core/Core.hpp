@@ -95,8 +95,9 @@ public:
 protected:
     Optional<bool> migrationShouldBeOperated(const UnsafeStringView& path) override final;
     void backupShouldBeOperated(const UnsafeStringView& path) override final;
-    void checkpointShouldBeOperated(const UnsafeStringView& path) override final;
-    void integrityShouldBeChecked(const UnsafeStringView& path) override final;
+    Optional<bool> checkpointShouldBeOperated(const UnsafeStringView& path,
+                                              AutoCheckpointOperator::CheckpointMode mode) override final;
+    Optional<bool> integrityShouldBeChecked(const UnsafeStringView& path) override final;
     void purgeShouldBeOperated() override final;
 
     std::shared_ptr<OperationQueue> m_operationQueue;
@@ -104,9 +105,11 @@ protected:
 #pragma mark - Checkpoint
 public:
     void enableAutoCheckpoint(InnerDatabase* database, bool enable);
+    void setAutoCheckpointTargetNumberOfFrames(int numberOfFrames);
+    Optional<AutoCheckpointConfig::WalMetrics> getWalMetrics(const UnsafeStringView& path) const;
 
 private:
-    std::shared_ptr<Config> m_autoCheckpointConfig;
+    std::shared_ptr<AutoCheckpointConfig> m_autoCheckpointConfig;
 
 #pragma mark - Backup
 public:
@@ -155,6 +158,13 @@ protected:
 public:
     void skipIntegrityCheck(const UnsafeStringView& path);
 
+protected:
+    // In each round, the database and its source databases are checked one by one,
+    // and the next one is checked only after the current one is done.
+    // path of database -> path of the database being checked in current round
+    std::mutex m_integrityLock;
+    StringViewMap<StringView> m_integrityCheckingPaths;
+
 #pragma mark - Config
 public:
     void setABTestConfig(const UnsafeStringView& configName,
@@ -35,6 +35,8 @@ static constexpr const double AsyncQueueTimeOutForExiting = 10.0;
 #pragma mark - Operation Queue
 WCDBLiteralStringDefine(OperationQueueName, "WCDB.Operation");
 static constexpr double OperationQueueTimeIntervalForRetringAfterFailure = 5.0;
+static constexpr const int OperationQueueMaxNumberOfWorkers = 4;
+static constexpr const double OperationQueueTimeIntervalForWaitingWorks = 1.0;
 #pragma mark - Operation Queue - Migration
 static constexpr const double OperationQueueTimeIntervalForMigration = 2.0;
 static constexpr const int OperationQueueTolerableFailuresForMigration = 5;
@@ -43,18 +45,26 @@ static constexpr const double OperationQueueTimeIntervalForPurgingAgain = 30.0;
 static constexpr const double OperationQueueRateForTooManyFileDescriptors = 0.7;
 #pragma mark - Operation Queue - Checkpoint
 static constexpr const double OperationQueueTimeIntervalForCheckpoint = 10.0;
+static constexpr const double OperationQueueTimeIntervalForCheckpointStep = 0.1;
 #pragma mark - Operation Queue - Backup
 #ifndef WCDB_QUICK_TESTS
 static double OperationQueueTimeIntervalForBackup = 600.0;
 #else
 static double OperationQueueTimeIntervalForBackup = 10.0;
 #endif
+#pragma mark - Operation Queue - Integrity
+static constexpr const double OperationQueueTimeIntervalForIntegrityCheck = 1.0;
+static constexpr const int OperationQueueTolerableFailuresForIntegrityCheck = 5;
 #pragma mark - Operation Queue - Merge FTS Index
 static constexpr const double OperationQueueTimeIntervalForMergeFTSIndex
 = 1.871; //Use prime numbers to reduce the probability of collision with external logic
 
 #pragma mark - Config - Auto Checkpoint
 WCDBLiteralStringDefine(AutoCheckpointConfigName, "com.Tencent.WCDB.Config.AutoCheckpoint");
+static constexpr const int AutoCheckpointTargetNumberOfFrames = 4096;
+static constexpr const int AutoCheckpointNumberOfFramesPerStep = 1024;
+static constexpr const double AutoCheckpointMinDelay = 1.0;
+static constexpr const double AutoCheckpointFramesGrowthSmoothingFactor = 0.3;
 #pragma mark - Config - Auto Backup
 WCDBLiteralStringDefine(AutoBackupConfigName, "com.Tencent.WCDB.Config.AutoBackup");
 #pragma mark - Config - Auto Migrate
@@ -71,9 +81,14 @@ static constexpr const int BasicConfigBusyRetryMaxAllowedNumberOfTimes = 3;
 #pragma mark - Config - Busy Retry
 WCDBLiteralStringDefine(BusyRetryConfigName, "com.Tencent.WCDB.Config.BusyRetry");
 static constexpr const double BusyRetryTimeOut = 10.0;
+static constexpr const int BusyRetryNumberOfLockFreeShmSlots = 64;
 #pragma mark - Config - Cipher
 WCDBLiteralStringDefine(CipherConfigName, "com.Tencent.WCDB.Config.Cipher");
 static constexpr const int CipherConfigDefaultPageSize = SQLITE_DEFAULT_PAGE_SIZE;
+static constexpr const int CipherKeyCacheMaxCount = 32;
+static constexpr const int CipherKeyCacheSecretSize = 32;
+// Size of HMAC-SHA256
+static constexpr const int CipherKeyCacheDigestSize = 32;
 #pragma mark - Config - Global SQL Trace
 WCDBLiteralStringDefine(GlobalSQLTraceConfigName, "com.Tencent.WCDB.Config.GlobalSQLTrace");
 #pragma mark - Config - Global Performance Trace
@@ -96,6 +111,11 @@ WCDBLiteralStringDefine(NotifierLoggerName, "com.Tencent.WCDB.Notifier.Log");
 #pragma mark - Handle Pool
 static constexpr const int HandlePoolMaxAllowedNumberOfHandles = 32;
 static constexpr const int HandlePoolMaxAllowedNumberOfWriters = 4;
+#pragma mark - Handle Pool - Prepared Statement Cache
+static constexpr const size_t PreparedStatementCacheDefaultMaxCount = 64;
+static constexpr const size_t PreparedStatementCacheDefaultMaxMemory = 1024 * 1024;
+#pragma mark - Handle Statement - Columnar Batch
+static constexpr const int ColumnarBatchDefaultNumberOfRows = 256;
 
 enum HandleSlot : unsigned char {
     HandleSlotNormal = 0,
@@ -152,6 +172,20 @@ static constexpr bool handleShouldWaitWhenFull(HandleType type)
 #pragma mark - Migrate
 static constexpr const double MigrateMaxExpectingDuration = 0.01;
 static constexpr const double MigrateMaxInitializeDuration = 0.005;
+static constexpr const int MigrateInitialNumberOfRowsPerBatch = 16;
+static constexpr const int MigrateMaxNumberOfRowsPerBatch = 1024;
+
+#pragma mark - Integrity
+static constexpr const double IntegrityCheckMaxExpectingDuration = 0.1;
+
+#pragma mark - Repair
+static constexpr const int RepairMaxNumberOfCrawlingWorkers = 4;
+static constexpr const int RepairNumberOfReadAheadPagesPerWorker = 8;
+static constexpr const int RepairMaxNumberOfIncrementalBackups = 16;
+static constexpr const int RepairInitialNumberOfCellsPerMilestone = 1000;
+static constexpr const int RepairMaxNumberOfCellsPerMilestone = 32768;
+static constexpr const size_t RepairPageCacheMaxAllowedMemory = 32 * 1024 * 1024;
+static constexpr const int RepairNumberOfPageCacheShards = 16;
 
 WCDBLiteralStringDefine(ErrorStringKeyType, "Type");
 WCDBLiteralStringDefine(ErrorStringKeySource, "Source")
@@ -200,5 +234,6 @@ static constexpr const int TagInvalidValue = 0;
 
 #pragma mark - Constraint
 static_assert(OperationQueueTimeIntervalForMigration > MigrateMaxExpectingDuration, "");
+static_assert(OperationQueueTimeIntervalForIntegrityCheck > IntegrityCheckMaxExpectingDuration, "");
 
 } // namespace WCDB
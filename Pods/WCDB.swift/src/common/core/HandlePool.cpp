@@ -216,6 +216,7 @@ RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint)
             m_counter.decreaseHandleCount(writeHint);
             return nullptr;
         }
+        handle->setPreparedStatementCacheMeter(&m_preparedStatementCacheMeter);
 
         LockGuard memoryGuard(m_memory);
         WCTAssert(m_handles[slot].find(handle) == m_handles[slot].end());
@@ -281,6 +282,17 @@ void HandlePool::flowBack(HandleType type, const std::shared_ptr<InnerHandle> &h
     }
 }
 
+#pragma mark - Prepared Statement Cache
+void HandlePool::setPreparedStatementCacheBudget(size_t maxCount, size_t maxMemory)
+{
+    m_preparedStatementCacheMeter.setBudget(maxCount, maxMemory);
+}
+
+PreparedStatementCacheMeter::Statistics HandlePool::getPreparedStatementCacheStatistics() const
+{
+    return m_preparedStatementCacheMeter.getStatistics();
+}
+
 HandlePool::ReferencedHandle::ReferencedHandle() : handle(nullptr), reference(0)
 {
 }
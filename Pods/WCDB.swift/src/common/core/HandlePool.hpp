@@ -28,6 +28,7 @@
 #include "ErrorProne.hpp"
 #include "HandleCounter.hpp"
 #include "Lock.hpp"
+#include "PreparedStatementCache.hpp"
 #include "RecyclableHandle.hpp"
 #include "ThreadedErrors.hpp"
 #include <array>
@@ -97,6 +98,15 @@ private:
     std::array<std::list<std::shared_ptr<InnerHandle>>, HandleSlotCount> m_frees;
     HandleCounter m_counter;
 
+#pragma mark - Prepared Statement Cache
+public:
+    // The budget is applied to each handle in this pool.
+    void setPreparedStatementCacheBudget(size_t maxCount, size_t maxMemory);
+    PreparedStatementCacheMeter::Statistics getPreparedStatementCacheStatistics() const;
+
+private:
+    PreparedStatementCacheMeter m_preparedStatementCacheMeter;
+
 #pragma mark - Threaded
 private:
     struct ReferencedHandle {
@@ -53,6 +53,7 @@ InnerDatabase::InnerDatabase(const UnsafeStringView &path)
 , m_factory(path)
 , m_migration(this)
 , m_migratedCallback(nullptr)
+, m_batchMigration(true)
 , m_isInMemory(false)
 , m_sharedInMemoryHandle(nullptr)
 , m_mergeLogic(this)
@@ -782,12 +783,13 @@ bool InnerDatabase::removeMaterials()
     return result;
 }
 
-void InnerDatabase::checkIntegrity(bool interruptible)
+Optional<bool> InnerDatabase::checkIntegrity(bool interruptible)
 {
     InitializedGuard initializedGuard = initialize();
     if (!initializedGuard.valid()) {
-        return; // mark as succeed if it's not an auto initialize action.
+        return true; // mark as succeed if it's not an auto initialize action.
     }
+    Optional<bool> done;
     RecyclableHandle handle = flowOut(HandleType::Integrity);
     if (handle != nullptr) {
         WCTAssert(dynamic_cast<OperationHandle *>(handle.get()) != nullptr);
@@ -799,18 +801,41 @@ void InnerDatabase::checkIntegrity(bool interruptible)
                 error.infos.insert_or_assign(ErrorStringKeyType, ErrorTypeIntegrity);
                 Notifier::shared().notify(error);
                 setThreadedError(std::move(error));
-                return;
+                return NullOpt;
             }
 
             operationHandle->markErrorAsIgnorable(Error::Code::Interrupt);
             operationHandle->markAsCanBeSuspended(true);
         }
-        operationHandle->checkIntegrity();
+        operationHandle->markErrorAsIgnorable(Error::Code::Busy);
+        double progress = 0;
+        if (interruptible) {
+            std::lock_guard<std::mutex> lockGuard(m_integrityLock);
+            done = operationHandle->checkIntegrity(m_integrityCursor);
+            progress = m_integrityCursor.getProgress();
+        } else {
+            // The synchronous check is never sliced, so the result covers the whole database.
+            Optional<bool> corrupted = operationHandle->checkIntegrityOfDatabase();
+            if (corrupted.succeed()) {
+                done = true;
+            }
+        }
+        if (!done.succeed() && handle->getError().isIgnorable()) {
+            done = false;
+        }
+        operationHandle->markErrorAsUnignorable();
         if (interruptible) {
             operationHandle->markAsCanBeSuspended(false);
-            operationHandle->markErrorAsUnignorable();
+        }
+        if (done.succeed() && !done.value()) {
+            Error error(Error::Code::Notice, Error::Level::Notice, "Integrity check is in progress.");
+            error.infos.insert_or_assign(ErrorStringKeyPath, path);
+            error.infos.insert_or_assign(ErrorStringKeyType, ErrorTypeIntegrity);
+            error.infos.insert_or_assign("Progress", progress);
+            Notifier::shared().notify(error);
         }
     }
+    return done;
 }
 
 #pragma mark - Migration
@@ -843,6 +868,7 @@ Optional<bool> InnerDatabase::stepMigration(bool interruptible)
             migrateHandle->markAsCanBeSuspended(true);
         }
         migrateHandle->markErrorAsIgnorable(Error::Code::Busy);
+        migrateHandle->enableBatchMigration(m_batchMigration.load());
         done = m_migration.step(*migrateHandle);
         if (!done.succeed() && handle->getError().isIgnorable()) {
             done = false;
@@ -856,6 +882,11 @@ Optional<bool> InnerDatabase::stepMigration(bool interruptible)
     return done;
 }
 
+void InnerDatabase::enableBatchMigration(bool enable)
+{
+    m_batchMigration.store(enable);
+}
+
 void InnerDatabase::didMigrate(const MigrationBaseInfo *info)
 {
     SharedLockGuard lockGuard(m_memory);
@@ -887,6 +918,33 @@ std::set<StringView> InnerDatabase::getPathsOfSourceDatabases() const
 
 #pragma mark - Checkpoint
 bool InnerDatabase::checkpoint(bool interruptible, CheckPointMode mode)
+{
+    return operateCheckpoint(interruptible, [mode](OperationHandle *handle) {
+        return handle->checkpoint(mode);
+    });
+}
+
+Optional<bool> InnerDatabase::checkpointFrames(bool interruptible, int numberOfFrames)
+{
+    // It's not drained if the step is interrupted or blocked.
+    bool drained = false;
+    bool succeed
+    = operateCheckpoint(interruptible, [&drained, numberOfFrames](OperationHandle *handle) {
+          auto checkpointed = handle->checkpointFrames(numberOfFrames);
+          if (!checkpointed.succeed()) {
+              return false;
+          }
+          drained = checkpointed.value();
+          return true;
+      });
+    if (!succeed) {
+        return NullOpt;
+    }
+    return drained;
+}
+
+bool InnerDatabase::operateCheckpoint(bool interruptible,
+                                      const std::function<bool(OperationHandle *)> &checkpoint)
 {
     InitializedGuard initializedGuard = initialize();
     if (!initializedGuard.valid()) {
@@ -912,14 +970,13 @@ bool InnerDatabase::checkpoint(bool interruptible, CheckPointMode mode)
             operationHandle->markAsCanBeSuspended(true);
         }
         operationHandle->markErrorAsIgnorable(Error::Code::Busy);
-        succeed = operationHandle->checkpoint(mode);
+        succeed = checkpoint(operationHandle);
         if (!succeed && operationHandle->getError().isIgnorable()) {
             succeed = true;
         }
         operationHandle->markErrorAsUnignorable();
         if (interruptible) {
             operationHandle->markAsCanBeSuspended(false);
-            operationHandle->markErrorAsUnignorable();
         }
     }
     return succeed;
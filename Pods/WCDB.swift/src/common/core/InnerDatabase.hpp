@@ -29,6 +29,7 @@
 #include "HandlePool.hpp"
 #include "MergeFTSIndexLogic.hpp"
 #include "Migration.hpp"
+#include "OperationHandle.hpp"
 #include "Tag.hpp"
 #include "ThreadLocal.hpp"
 #include "TransactionGuard.hpp"
@@ -149,10 +150,14 @@ public:
     double retrieve(const RetrieveProgressCallback &onProgressUpdated);
     bool containsDeposited() const;
 
-    void checkIntegrity(bool interruptible);
+    // Each interruptible call checks a slice of the database and returns true if the whole database is checked.
+    // Non-interruptible call checks the whole database at once.
+    Optional<bool> checkIntegrity(bool interruptible);
 
 private:
     Repair::Factory m_factory;
+    std::mutex m_integrityLock;
+    OperationHandle::IntegrityCursor m_integrityCursor;
 
 #pragma mark - Migration
 public:
@@ -164,6 +169,9 @@ public:
 
     Optional<bool> stepMigration(bool interruptible);
 
+    // Batch migration moves rows by rowid ranges, which is enabled by default.
+    void enableBatchMigration(bool enable);
+
     bool isMigrated() const;
 
     std::set<StringView> getPathsOfSourceDatabases() const;
@@ -172,11 +180,18 @@ protected:
     void didMigrate(const MigrationBaseInfo *info) override final;
     Migration m_migration; // thread-safe
     MigratedCallback m_migratedCallback;
+    std::atomic<bool> m_batchMigration;
 
 #pragma mark - Checkpoint
 public:
     using CheckPointMode = AbstractHandle::CheckpointMode;
     bool checkpoint(bool interruptible = true, CheckPointMode mode = CheckPointMode::Passive);
+    // Returns whether the wal is drained.
+    Optional<bool> checkpointFrames(bool interruptible, int numberOfFrames);
+
+private:
+    bool operateCheckpoint(bool interruptible,
+                           const std::function<bool(OperationHandle *)> &checkpoint);
 
 #pragma mark - Memory
 public:
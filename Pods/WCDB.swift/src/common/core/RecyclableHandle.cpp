@@ -42,6 +42,11 @@ RecyclableHandle::RecyclableHandle(const std::shared_ptr<InnerHandle> &value,
 {
 }
 
+RecyclableHandle::RecyclableHandle(const RecyclableHandle &other)
+: Super(other), m_handle(other.m_handle)
+{
+}
+
 RecyclableHandle::~RecyclableHandle() = default;
 
 RecyclableHandle &RecyclableHandle::operator=(const std::nullptr_t &)
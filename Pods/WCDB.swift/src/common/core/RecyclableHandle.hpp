@@ -38,6 +38,7 @@ public:
     RecyclableHandle(const std::nullptr_t &);
     RecyclableHandle(const std::shared_ptr<InnerHandle> &value,
                      const Super::OnRecycled &onRecycled);
+    RecyclableHandle(const RecyclableHandle &other);
     ~RecyclableHandle() override final;
 
     RecyclableHandle &operator=(const std::nullptr_t &);
@@ -33,6 +33,7 @@ AssembleHandle::AssembleHandle()
 , m_statementForDisableJounral(StatementPragma().pragma(Pragma::journalMode()).to("OFF"))
 , m_statementForEnableMMap(StatementPragma().pragma(Pragma::mmapSize()).to(2147418112))
 , m_integerPrimary(-1)
+, m_numberOfColumns(0)
 , m_cellStatement(getStatement())
 , m_statementForUpdateSequence(StatementUpdate()
                                .update("sqlite_sequence")
@@ -148,6 +149,7 @@ bool AssembleHandle::assembleCell(const Repair::Cell &cell)
     }
     WCTAssert(m_cellStatement->isPrepared());
     m_cellStatement->reset();
+    // The payload of cell is alive until the step is done, so that all the values can be bound without copying.
     m_cellStatement->bindInteger(cell.getRowID(), 1);
     for (int i = 0; i < cell.getCount(); ++i) {
         int bindIndex = i + 2;
@@ -156,11 +158,11 @@ bool AssembleHandle::assembleCell(const Repair::Cell &cell)
             m_cellStatement->bindInteger(cell.integerValue(i), bindIndex);
             break;
         case Repair::Cell::Text: {
-            m_cellStatement->bindText(cell.textValue(i), bindIndex);
+            m_cellStatement->bindStaticText(cell.textValue(i), bindIndex);
             break;
         }
         case Repair::Cell::BLOB: {
-            m_cellStatement->bindBLOB(cell.blobValue(i), bindIndex);
+            m_cellStatement->bindStaticBLOB(cell.blobValue(i), bindIndex);
             break;
         }
         case Repair::Cell::Real:
@@ -175,6 +177,11 @@ bool AssembleHandle::assembleCell(const Repair::Cell &cell)
             break;
         }
     }
+    // Cells written before the columns were added are shorter than the table.
+    // Their trailing columns should not inherit the values of the previous cell.
+    for (int i = cell.getCount(); i < m_numberOfColumns; ++i) {
+        m_cellStatement->bindNull(i + 2);
+    }
     bool succeed = m_cellStatement->step();
     return succeed;
 }
@@ -191,6 +198,7 @@ bool AssembleHandle::lazyPrepareCell()
     }
     auto &metas = optionalMetas.value();
     m_integerPrimary = ColumnMeta::getIndexOfIntegerPrimary(metas);
+    m_numberOfColumns = (int) metas.size();
 
     Columns columns = { Column::rowid() };
     for (const auto &meta : metas) {
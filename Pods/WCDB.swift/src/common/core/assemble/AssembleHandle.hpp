@@ -65,6 +65,7 @@ public:
 protected:
     bool lazyPrepareCell();
     int64_t m_integerPrimary;
+    int m_numberOfColumns;
     StringView m_table;
     HandleStatement *m_cellStatement;
 
@@ -24,8 +24,11 @@
 
 #include "AutoCheckpointConfig.hpp"
 #include "Assertion.hpp"
+#include "CoreConst.h"
+#include "FileManager.hpp"
 #include "Global.hpp"
 #include "InnerHandle.hpp"
+#include "Path.hpp"
 #include "StatementPragma.hpp"
 #include "StringView.hpp"
 #include <regex>
@@ -39,6 +42,7 @@ AutoCheckpointConfig::AutoCheckpointConfig(const std::shared_ptr<AutoCheckpointO
 , m_identifier(StringView::formatted("Checkpoint-%p", this))
 , m_operator(operator_)
 , m_disableAutoCheckpoint(StatementPragma().pragma(Pragma::walAutocheckpoint()).to(0))
+, m_targetNumberOfFrames(AutoCheckpointTargetNumberOfFrames)
 {
     WCTAssert(m_operator != nullptr);
 
@@ -61,25 +65,69 @@ bool AutoCheckpointConfig::invoke(InnerHandle* handle)
     0,
     m_identifier,
     std::bind(&AutoCheckpointConfig::onCommitted, this, std::placeholders::_1, std::placeholders::_2));
+    handle->setNotificationWhenCheckpointed(
+    m_identifier,
+    std::bind(&AutoCheckpointConfig::onCheckpointed, this, std::placeholders::_1));
+    {
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        ++m_states[handle->getPath()].numberOfHandles;
+    }
     return true;
 }
 
 bool AutoCheckpointConfig::uninvoke(InnerHandle* handle)
 {
     handle->unsetNotificationWhenCommitted(m_identifier);
-
+    handle->setNotificationWhenCheckpointed(m_identifier, nullptr);
+    {
+        // The state is released once the last handle of the database is closed.
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        auto iter = m_states.find(handle->getPath());
+        if (iter != m_states.end() && --iter->second.numberOfHandles <= 0) {
+            m_states.erase(iter);
+        }
+    }
     return true;
 }
 
 bool AutoCheckpointConfig::onCommitted(const UnsafeStringView& path, int frames)
 {
-    WCDB_UNUSED(frames);
-    if (frames > 0) {
-        m_operator->asyncCheckpoint(path);
+    if (frames <= 0) {
+        return true;
     }
+    WalState state;
+    {
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        WalState& current = m_states[path];
+        SteadyClock now = SteadyClock::now();
+        // The wal is restarted from the beginning after all the frames are checkpointed.
+        int increment = frames >= current.numberOfFrames ? frames - current.numberOfFrames : frames;
+        double interval = now.timeIntervalSinceSteadyClock(current.lastCommitted);
+        if (current.numberOfFrames > 0 && interval > 0) {
+            current.framesPerSecond
+            = AutoCheckpointFramesGrowthSmoothingFactor * (increment / interval)
+              + (1 - AutoCheckpointFramesGrowthSmoothingFactor) * current.framesPerSecond;
+        }
+        current.numberOfFrames = frames;
+        current.lastCommitted = now;
+        if (!current.firstUncheckpointed.succeed()) {
+            current.firstUncheckpointed = now;
+        }
+        state = current;
+    }
+    scheduleCheckpoint(path, state);
     return true;
 }
 
+void AutoCheckpointConfig::onCheckpointed(const UnsafeStringView& path)
+{
+    std::lock_guard<std::mutex> lockGuard(m_lock);
+    auto iter = m_states.find(path);
+    if (iter != m_states.end()) {
+        iter->second.firstUncheckpointed = NullOpt;
+    }
+}
+
 void AutoCheckpointConfig::log(int rc, const char* message)
 {
     Error::ExtCode extCode = Error::rc2ec(rc);
@@ -95,11 +143,74 @@ void AutoCheckpointConfig::log(int rc, const char* message)
             // hint checkpoint
             if (frames > 0) {
                 StringView path(match[2].str());
-                m_operator->asyncCheckpoint(path);
+                m_operator->asyncCheckpoint(
+                path, OperationQueueTimeIntervalForCheckpoint, CheckpointMode::Passive);
             }
         }
     }
     WCTAssert(match.size() == 3); // assert match and match 3.
 }
 
+#pragma mark - Controller
+AutoCheckpointConfig::WalState::WalState()
+: numberOfHandles(0), numberOfFrames(0), framesPerSecond(0)
+{
+}
+
+AutoCheckpointConfig::WalMetrics::WalMetrics()
+: numberOfFrames(0), walFileSize(0), framesPerSecond(0), checkpointLag(0)
+{
+}
+
+void AutoCheckpointConfig::setTargetNumberOfFrames(int numberOfFrames)
+{
+    WCTRemedialAssert(numberOfFrames > 0, "Target number of frames must be positive.", return;);
+    m_targetNumberOfFrames = numberOfFrames;
+}
+
+void AutoCheckpointConfig::scheduleCheckpoint(const UnsafeStringView& path, const WalState& state)
+{
+    int target = m_targetNumberOfFrames;
+    if (state.numberOfFrames >= 2 * target) {
+        // Passive checkpoints can't catch up with the writes, so the wal is truncated to reclaim the file size.
+        m_operator->asyncCheckpoint(path, 0, CheckpointMode::Truncate);
+    } else if (state.numberOfFrames >= target) {
+        // The wal is drained in bounded steps so that the writers are not blocked by a long checkpoint.
+        m_operator->asyncCheckpoint(path, 0, CheckpointMode::Incremental);
+    } else {
+        // Checkpoint when the wal is estimated to reach the half way to the target, which keeps the checkpoints incremental.
+        double delay = OperationQueueTimeIntervalForCheckpoint;
+        if (state.framesPerSecond > 0) {
+            double estimated = (target - state.numberOfFrames) / state.framesPerSecond / 2;
+            delay = std::max(AutoCheckpointMinDelay, std::min(delay, estimated));
+        }
+        m_operator->asyncCheckpoint(path, delay, CheckpointMode::Passive);
+    }
+}
+
+Optional<AutoCheckpointConfig::WalMetrics>
+AutoCheckpointConfig::getWalMetrics(const UnsafeStringView& path) const
+{
+    WalMetrics metrics;
+    {
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        auto iter = m_states.find(path);
+        if (iter == m_states.end()) {
+            return NullOpt;
+        }
+        const WalState& state = iter->second;
+        metrics.numberOfFrames = state.numberOfFrames;
+        metrics.framesPerSecond = state.framesPerSecond;
+        if (state.firstUncheckpointed.succeed()) {
+            metrics.checkpointLag
+            = SteadyClock::timeIntervalSinceSteadyClockToNow(state.firstUncheckpointed.value());
+        }
+    }
+    auto walFileSize = FileManager::getFileSize(Path::addExtention(path, "-wal"));
+    if (walFileSize.succeed()) {
+        metrics.walFileSize = walFileSize.value();
+    }
+    return metrics;
+}
+
 } //namespace WCDB
@@ -24,8 +24,12 @@
 
 #pragma once
 
+#include "AbstractHandle.hpp"
 #include "Config.hpp"
 #include "Statement.hpp"
+#include "Time.hpp"
+#include "WCDBOptional.hpp"
+#include <mutex>
 
 namespace WCDB {
 
@@ -33,7 +37,10 @@ class AutoCheckpointOperator {
 public:
     virtual ~AutoCheckpointOperator() = 0;
 
-    virtual void asyncCheckpoint(const UnsafeStringView &path) = 0;
+    using CheckpointMode = AbstractHandle::CheckpointMode;
+    virtual void
+    asyncCheckpoint(const UnsafeStringView &path, double delay, CheckpointMode mode)
+    = 0;
 };
 
 class AutoCheckpointConfig final : public Config {
@@ -47,10 +54,45 @@ public:
 protected:
     const StringView m_identifier;
     bool onCommitted(const UnsafeStringView &path, int pages);
+    void onCheckpointed(const UnsafeStringView &path);
     void log(int rc, const char *message);
 
     std::shared_ptr<AutoCheckpointOperator> m_operator;
     Statement m_disableAutoCheckpoint;
+
+#pragma mark - Controller
+public:
+    // The wal is kept under the target by checkpointing earlier as it grows faster,
+    // and it's truncated once it's far beyond the target.
+    void setTargetNumberOfFrames(int numberOfFrames);
+
+    struct WalMetrics {
+        WalMetrics();
+        int numberOfFrames;
+        size_t walFileSize;
+        double framesPerSecond;
+        // Seconds since the earliest commit that is not checkpointed yet.
+        double checkpointLag;
+    };
+    Optional<WalMetrics> getWalMetrics(const UnsafeStringView &path) const;
+
+protected:
+    using CheckpointMode = AutoCheckpointOperator::CheckpointMode;
+    struct WalState {
+        WalState();
+        // number of the handles that the config is invoked on
+        int numberOfHandles;
+        int numberOfFrames;
+        double framesPerSecond;
+        SteadyClock lastCommitted;
+        // Only valid when there are commits not checkpointed.
+        Optional<SteadyClock> firstUncheckpointed;
+    };
+    void scheduleCheckpoint(const UnsafeStringView &path, const WalState &state);
+
+    mutable std::mutex m_lock;
+    StringViewMap<WalState> m_states;
+    std::atomic<int> m_targetNumberOfFrames;
 };
 
 } //namespace WCDB
@@ -35,16 +35,22 @@ BusyRetryConfig::BusyRetryConfig()
 {
     Global::shared().setNotificationForLockEvent(
     m_identifier,
-    std::bind(&BusyRetryConfig::willLock, this, std::placeholders::_1, std::placeholders::_2),
-    std::bind(&BusyRetryConfig::lockDidChange, this, std::placeholders::_1, std::placeholders::_2),
+    std::bind(&BusyRetryConfig::willLock, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
     std::bind(
-    &BusyRetryConfig::willShmLock, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+    &BusyRetryConfig::lockDidChange, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+    std::bind(&BusyRetryConfig::willShmLock,
+              this,
+              std::placeholders::_1,
+              std::placeholders::_2,
+              std::placeholders::_3,
+              std::placeholders::_4),
     std::bind(&BusyRetryConfig::shmLockDidChange,
               this,
               std::placeholders::_1,
               std::placeholders::_2,
               std::placeholders::_3,
-              std::placeholders::_4));
+              std::placeholders::_4,
+              std::placeholders::_5));
 }
 
 BusyRetryConfig::~BusyRetryConfig()
@@ -83,7 +89,7 @@ bool BusyRetryConfig::onBusy(const UnsafeStringView& path, int numberOfTimes)
 
     Trying& trying = m_tryings.getOrCreate();
     WCTAssert(trying.valid());
-    return getOrCreateState(trying.getPath()).wait(trying);
+    return trying.getState()->wait(trying);
 }
 
 #pragma mark - State
@@ -158,90 +164,206 @@ BusyRetryConfig::State::ShmMask::ShmMask() : shared(0), exclusive(0)
 {
 }
 
+BusyRetryConfig::State::ShmSlot::ShmSlot() : identifier(nullptr), masks(0)
+{
+}
+
 BusyRetryConfig::State& BusyRetryConfig::getOrCreateState(const UnsafeStringView& path)
 {
     WCTAssert(!path.empty());
-    StateHolder& stateHoder = m_localState.getOrCreate();
-    if (stateHoder.state != nullptr) {
-        State& localState = *stateHoder.state;
-        if (localState.m_path == path) {
-            return localState;
-        }
-    }
     {
         SharedLockGuard lockGuard(m_statesLock);
         auto iter = m_states.find(path);
         if (iter != m_states.end()) {
-            stateHoder.state = &iter->second;
-            return *stateHoder.state;
+            return iter->second;
         }
     }
     {
         LockGuard lockGuard(m_statesLock);
         State& state = m_states[path];
         state.m_path = path;
-        stateHoder.state = &state;
         return state;
     }
 }
 
+BusyRetryConfig::State& BusyRetryConfig::getState(const UnsafeStringView& path, void** context)
+{
+    WCTAssert(context != nullptr);
+    // States are never erased, so that they are always valid during the lifetime of files.
+    if (*context == nullptr) {
+        *context = &getOrCreateState(path);
+    }
+    State& state = *static_cast<State*>(*context);
+    WCTAssert(state.m_path == path);
+    return state;
+}
+
 BusyRetryConfig::State::State()
 : m_pagerType(PagerLockType::None)
 , m_localPagerType(PagerLockType::None)
+, m_numberOfOverflowedShmMasks(0)
+, m_numberOfWaitingThreads(0)
 , m_mainThreadBusyTrying(nullptr)
 {
 }
 
+/*
+ The waiting thread increases m_numberOfWaitingThreads before checking the lock states under m_lock,
+ while the updating thread checks it after the lock states are changed.
+ So that either the waiting thread sees the new states, or the updating thread acquires m_lock to notify it.
+ */
 void BusyRetryConfig::State::updatePagerLock(PagerLockType type)
 {
-    std::lock_guard<std::mutex> lockGuard(m_lock);
-    if (m_pagerType != type) {
-        bool notify = type < m_pagerType;
-        m_pagerType = type;
-        PagerLockType& localPageType = m_localPagerType.getOrCreate();
-        localPageType = type;
-        if (notify) {
-            tryNotify();
+    m_localPagerType.getOrCreate() = type;
+    PagerLockType oldType = m_pagerType.exchange(type);
+    if (type < oldType && m_numberOfWaitingThreads.load() > 0) {
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        tryNotify();
+    }
+}
+
+static char s_shmSlotTombstone;
+#define ShmSlotTombstone (static_cast<void*>(&s_shmSlotTombstone))
+
+BusyRetryConfig::State::ShmSlot*
+BusyRetryConfig::State::getShmSlot(void* identifier, bool create, bool& created)
+{
+    WCTAssert(identifier != nullptr && identifier != ShmSlotTombstone);
+    created = false;
+    // Given back slots are marked as tombstone instead of empty, so that the probing can still stop at the first empty one.
+    size_t begin = std::hash<void*>()(identifier) % m_shmSlots.size();
+    ShmSlot* tombstone = nullptr;
+    for (size_t i = 0; i < m_shmSlots.size(); ++i) {
+        ShmSlot& slot = m_shmSlots[(begin + i) % m_shmSlots.size()];
+        void* occupied = slot.identifier.load();
+        if (occupied == identifier) {
+            return &slot;
+        }
+        if (occupied == ShmSlotTombstone) {
+            if (tombstone == nullptr) {
+                tombstone = &slot;
+            }
+            continue;
+        }
+        if (occupied == nullptr) {
+            if (!create) {
+                return nullptr;
+            }
+            // The identifier is not kept in any slot since it's only updated serially.
+            if (tombstone != nullptr) {
+                void* expected = ShmSlotTombstone;
+                if (tombstone->identifier.compare_exchange_strong(expected, identifier)) {
+                    created = true;
+                    return tombstone;
+                }
+                tombstone = nullptr;
+            }
+            if (slot.identifier.compare_exchange_strong(occupied, identifier)) {
+                created = true;
+                return &slot;
+            }
+            if (occupied == ShmSlotTombstone && tombstone == nullptr) {
+                tombstone = &slot;
+            }
         }
     }
+    if (create && tombstone != nullptr) {
+        void* expected = ShmSlotTombstone;
+        if (tombstone->identifier.compare_exchange_strong(expected, identifier)) {
+            created = true;
+            return tombstone;
+        }
+    }
+    return nullptr;
 }
 
 void BusyRetryConfig::State::updateShmLock(void* identifier, int sharedMask, int exclusiveMask)
 {
-    std::lock_guard<std::mutex> lockGuard(m_lock);
-    bool notify = false;
-    if (sharedMask == 0 && exclusiveMask == 0) {
-        m_shmMasks.erase(identifier);
-        m_localShmMask.getOrCreate().erase(identifier);
-        notify = true;
+    bool released = sharedMask == 0 && exclusiveMask == 0;
+    auto& localShmMasks = m_localShmMasks.getOrCreate();
+    auto local = std::find_if(
+    localShmMasks.begin(),
+    localShmMasks.end(),
+    [identifier](const std::pair<void*, ShmMask>& element) { return element.first == identifier; });
+    if (released) {
+        if (local != localShmMasks.end()) {
+            *local = localShmMasks.back();
+            localShmMasks.pop_back();
+        }
     } else {
-        State::ShmMask& mask = m_shmMasks[identifier];
-        notify = sharedMask < mask.shared || exclusiveMask < mask.exclusive;
-        mask.shared = sharedMask;
-        mask.exclusive = exclusiveMask;
-        State::ShmMask& localMask = m_localShmMask.getOrCreate()[identifier];
-        localMask.shared = sharedMask;
-        localMask.exclusive = exclusiveMask;
+        if (local == localShmMasks.end()) {
+            local = localShmMasks.emplace(localShmMasks.end(), identifier, ShmMask());
+        }
+        local->second.shared = sharedMask;
+        local->second.exclusive = exclusiveMask;
+    }
+
+    WCTAssert((sharedMask & 0xffff) == sharedMask && (exclusiveMask & 0xffff) == exclusiveMask);
+    int oldShared = 0;
+    int oldExclusive = 0;
+    // The masks of the same identifier are always updated serially, so that it won't be kept twice.
+    bool created = false;
+    ShmSlot* slot = getShmSlot(identifier, !released, created);
+    if (slot != nullptr) {
+        int oldMasks = slot->masks.exchange(exclusiveMask << 16 | sharedMask);
+        oldShared = oldMasks & 0xffff;
+        oldExclusive = oldMasks >> 16;
+        if (created && m_numberOfOverflowedShmMasks.load() > 0) {
+            // It was overflowed before the slot is given back by others.
+            std::lock_guard<std::mutex> lockGuard(m_lock);
+            auto iter = m_shmMasks.find(identifier);
+            if (iter != m_shmMasks.end()) {
+                oldShared = iter->second.shared;
+                oldExclusive = iter->second.exclusive;
+                m_shmMasks.erase(iter);
+                m_numberOfOverflowedShmMasks.store((int) m_shmMasks.size());
+            }
+        }
+        if (released) {
+            slot->identifier.store(ShmSlotTombstone);
+        }
+    } else if (!released || m_numberOfOverflowedShmMasks.load() > 0) {
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        auto iter = m_shmMasks.find(identifier);
+        if (iter != m_shmMasks.end()) {
+            oldShared = iter->second.shared;
+            oldExclusive = iter->second.exclusive;
+            if (released) {
+                m_shmMasks.erase(iter);
+            }
+        }
+        if (!released) {
+            State::ShmMask& mask = m_shmMasks[identifier];
+            mask.shared = sharedMask;
+            mask.exclusive = exclusiveMask;
+        }
+        m_numberOfOverflowedShmMasks.store((int) m_shmMasks.size());
     }
-    if (notify) {
+
+    bool notify = (oldShared & ~sharedMask) != 0 || (oldExclusive & ~exclusiveMask) != 0;
+    if (notify && m_numberOfWaitingThreads.load() > 0) {
+        std::lock_guard<std::mutex> lockGuard(m_lock);
         tryNotify();
     }
 }
 
 bool BusyRetryConfig::State::shouldWait(const Expecting& expecting) const
 {
-    bool wait = false;
-    if (!expecting.satisfied(m_pagerType)) {
-        wait = true;
-    } else {
-        for (const auto& iter : m_shmMasks) {
-            if (!expecting.satisfied(iter.second.shared, iter.second.exclusive)) {
-                wait = true;
-                break;
-            }
+    if (!expecting.satisfied(m_pagerType.load())) {
+        return true;
+    }
+    for (const auto& slot : m_shmSlots) {
+        int masks = slot.masks.load();
+        if (masks != 0 && !expecting.satisfied(masks & 0xffff, masks >> 16)) {
+            return true;
         }
     }
-    return wait;
+    for (const auto& iter : m_shmMasks) {
+        if (!expecting.satisfied(iter.second.shared, iter.second.exclusive)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool BusyRetryConfig::State::localShouldWait(const Expecting& expecting) const
@@ -250,7 +372,7 @@ bool BusyRetryConfig::State::localShouldWait(const Expecting& expecting) const
     if (!expecting.satisfied(m_localPagerType.getOrCreate())) {
         wait = true;
     } else {
-        for (const auto& iter : m_localShmMask.getOrCreate()) {
+        for (const auto& iter : m_localShmMasks.getOrCreate()) {
             if (!expecting.satisfied(iter.second.shared, iter.second.exclusive)) {
                 wait = true;
                 break;
@@ -265,6 +387,7 @@ bool BusyRetryConfig::State::wait(Trying& trying)
     static_assert(Exclusivity::Must < Exclusivity::NoMatter, "");
 
     std::unique_lock<std::mutex> lockGuard(m_lock);
+    ++m_numberOfWaitingThreads;
     while (shouldWait(trying)) {
         Thread currentThread = Thread::current();
         // main thread first
@@ -290,6 +413,7 @@ bool BusyRetryConfig::State::wait(Trying& trying)
             break;
         }
     }
+    --m_numberOfWaitingThreads;
     // never timeout
     return true;
 }
@@ -334,52 +458,55 @@ void BusyRetryConfig::State::tryNotify()
 }
 
 #pragma mark - Trying
-void BusyRetryConfig::Trying::expecting(const UnsafeStringView& path, ShmLockType type, int mask)
+BusyRetryConfig::Trying::Trying() : Expecting(), m_state(nullptr)
 {
-    WCTAssert(!path.empty());
-    m_path = path;
+}
+
+void BusyRetryConfig::Trying::expecting(State& state, ShmLockType type, int mask)
+{
+    m_state = &state;
     Expecting::expecting(type, mask);
 }
 
-void BusyRetryConfig::Trying::expecting(const UnsafeStringView& path, PagerLockType type)
+void BusyRetryConfig::Trying::expecting(State& state, PagerLockType type)
 {
-    WCTAssert(!path.empty());
-    m_path = path;
+    m_state = &state;
     Expecting::expecting(type);
 }
 
 bool BusyRetryConfig::Trying::valid() const
 {
-    return !m_path.empty() && Expecting::valid();
+    return m_state != nullptr && Expecting::valid();
 }
 
-const StringView& BusyRetryConfig::Trying::getPath() const
+BusyRetryConfig::State* BusyRetryConfig::Trying::getState() const
 {
-    return m_path;
+    return m_state;
 }
 
 #pragma mark - Lock Event
-void BusyRetryConfig::willLock(const UnsafeStringView& path, PagerLockType type)
+void BusyRetryConfig::willLock(const UnsafeStringView& path, void** context, PagerLockType type)
 {
-    m_tryings.getOrCreate().expecting(path, type);
+    m_tryings.getOrCreate().expecting(getState(path, context), type);
 }
 
-void BusyRetryConfig::lockDidChange(const UnsafeStringView& path, PagerLockType type)
+void BusyRetryConfig::lockDidChange(const UnsafeStringView& path, void** context, PagerLockType type)
 {
-    getOrCreateState(path).updatePagerLock(type);
+    getState(path, context).updatePagerLock(type);
 }
 
-void BusyRetryConfig::willShmLock(const UnsafeStringView& path, ShmLockType type, int mask)
+void BusyRetryConfig::willShmLock(const UnsafeStringView& path, void** context, ShmLockType type, int mask)
 {
-    m_tryings.getOrCreate().expecting(path, type, mask);
+    m_tryings.getOrCreate().expecting(getState(path, context), type, mask);
 }
 
 void BusyRetryConfig::shmLockDidChange(const UnsafeStringView& path,
+                                       void** context,
                                        void* identifier,
                                        int sharedMask,
                                        int exclusiveMask)
 {
-    getOrCreateState(path).updateShmLock(identifier, sharedMask, exclusiveMask);
+    getState(path, context).updateShmLock(identifier, sharedMask, exclusiveMask);
 }
 
 } // namespace WCDB
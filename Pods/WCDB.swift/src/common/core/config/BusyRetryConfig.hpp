@@ -25,11 +25,15 @@
 #pragma once
 
 #include "Config.hpp"
+#include "CoreConst.h"
 #include "Global.hpp"
 #include "Lock.hpp"
 #include "StringView.hpp"
 #include "ThreadLocal.hpp"
 #include "UniqueList.hpp"
+#include <array>
+#include <atomic>
+#include <vector>
 
 namespace WCDB {
 
@@ -52,10 +56,14 @@ protected:
 protected:
     typedef Global::PagerLock PagerLockType;
     typedef Global::ShmLock ShmLockType;
-    void willLock(const UnsafeStringView& path, PagerLockType type);
-    void lockDidChange(const UnsafeStringView& path, PagerLockType type);
-    void willShmLock(const UnsafeStringView& path, ShmLockType type, int mask);
-    void shmLockDidChange(const UnsafeStringView& path, void* identifier, int sharedMask, int exclusiveMask);
+    void willLock(const UnsafeStringView& path, void** context, PagerLockType type);
+    void lockDidChange(const UnsafeStringView& path, void** context, PagerLockType type);
+    void willShmLock(const UnsafeStringView& path, void** context, ShmLockType type, int mask);
+    void shmLockDidChange(const UnsafeStringView& path,
+                          void** context,
+                          void* identifier,
+                          int sharedMask,
+                          int exclusiveMask);
 
 #pragma mark - State
 protected:
@@ -99,7 +107,7 @@ protected:
     protected:
         bool shouldWait(const Expecting& expecting) const;
         bool localShouldWait(const Expecting& expecting) const;
-        PagerLockType m_pagerType;
+        std::atomic<PagerLockType> m_pagerType;
         mutable ThreadLocal<PagerLockType> m_localPagerType;
         struct ShmMask {
             ShmMask();
@@ -107,12 +115,26 @@ protected:
             int exclusive;
         };
         typedef struct ShmMask ShmMask;
+        // The masks of the connections are kept in the slots without lock. The ones beyond are kept in m_shmMasks, which is protected by m_lock.
+        // The slot is given back once all its masks are released, and it's marked as tombstone so that the probing of others can go on.
+        struct ShmSlot {
+            ShmSlot();
+            std::atomic<void*> identifier;
+            // exclusive mask << 16 | shared mask
+            std::atomic<int> masks;
+        };
+        typedef struct ShmSlot ShmSlot;
+        ShmSlot* getShmSlot(void* identifier, bool create, bool& created);
+        std::array<ShmSlot, BusyRetryNumberOfLockFreeShmSlots> m_shmSlots;
         std::map<void* /* identifier */, ShmMask> m_shmMasks;
-        mutable ThreadLocal<std::map<void* /* identifier */, ShmMask>> m_localShmMask;
+        std::atomic<int> m_numberOfOverflowedShmMasks;
+        mutable ThreadLocal<std::vector<std::pair<void* /* identifier */, ShmMask>>> m_localShmMasks;
 
+        // Lock is only acquired when there are waiting threads to be notified.
         void tryNotify();
         std::mutex m_lock;
         Conditional m_conditional;
+        std::atomic<int> m_numberOfWaitingThreads;
 
         enum class Exclusivity {
             Must = 0,
@@ -123,6 +145,8 @@ protected:
     };
 
     State& getOrCreateState(const UnsafeStringView& path);
+    // The state is kept in the context of file at its first lock event, so that it's referred directly by the following ones.
+    State& getState(const UnsafeStringView& path, void** context);
 
 private:
     SharedLock m_statesLock;
@@ -132,23 +156,19 @@ private:
 protected:
     class Trying : public Expecting {
     public:
-        using Expecting::Expecting;
+        Trying();
 
-        void expecting(const UnsafeStringView& path, ShmLockType type, int mask);
-        void expecting(const UnsafeStringView& path, PagerLockType type);
+        void expecting(State& state, ShmLockType type, int mask);
+        void expecting(State& state, PagerLockType type);
 
-        const StringView& getPath() const;
+        State* getState() const;
 
         bool valid() const;
 
     private:
-        StringView m_path;
+        State* m_state;
     };
-    typedef struct StateHolder {
-        State* state;
-    } StateHolder;
     ThreadLocal<Trying> m_tryings;
-    ThreadLocal<StateHolder> m_localState;
 };
 
 } //namespace WCDB
@@ -24,6 +24,7 @@
 
 #include "CipherConfig.hpp"
 #include "Assertion.hpp"
+#include "CipherKeyCache.hpp"
 #include "InnerHandle.hpp"
 
 namespace WCDB {
@@ -37,15 +38,56 @@ CipherConfig::~CipherConfig() = default;
 
 bool CipherConfig::invoke(InnerHandle* handle)
 {
-    bool ret = handle->setCipherKey(m_key);
-    if (handle->setCipherKey(m_key) && m_cipherVersion != 0) {
-        ret = handle->execute(
-        StatementPragma().pragma(Pragma::cipherCompatibility()).to(m_cipherVersion));
+    if (!handle->setCipherKey(m_key)) {
+        return false;
     }
-    if (ret) {
-        ret = handle->setCipherPageSize(m_pageSize);
+    // Salt is read from the header of database once the key is set, while the key derivation is lazy.
+    StringView salt = handle->getCipherSalt();
+    CipherKeyCache::Key cacheKey;
+    if (!salt.empty()) {
+        cacheKey = CipherKeyCache::shared().generateKey(
+        handle->getCipherContext(), m_key, salt, m_cipherVersion, m_pageSize);
+    }
+    bool derived = false;
+    if (!cacheKey.empty()) {
+        CipherKeyCache::SecureBuffer rawKey = CipherKeyCache::shared().get(cacheKey);
+        if (!rawKey.empty()) {
+            // Raw key skips the PBKDF2.
+            if (!handle->setCipherKey(rawKey.data())) {
+                return false;
+            }
+            derived = true;
+        }
+    }
+    if (m_cipherVersion != 0
+        && !handle->execute(
+        StatementPragma().pragma(Pragma::cipherCompatibility()).to(m_cipherVersion))) {
+        return false;
+    }
+    if (!handle->setCipherPageSize(m_pageSize)) {
+        return false;
+    }
+    if (!cacheKey.empty() && !derived) {
+        tryCacheDerivedKey(handle, cacheKey);
+    }
+    return true;
+}
+
+void CipherConfig::tryCacheDerivedKey(InnerHandle* handle, const CipherKeyCache::Key& cacheKey)
+{
+    // Reading the first page derives the key, which will be done by the following configs anyway.
+    // Any failure here is left to them.
+    handle->markErrorAsIgnorable(Error::Code::NotADatabase);
+    handle->markErrorAsIgnorable(Error::Code::Busy);
+    bool succeed = handle->execute(StatementPragma().pragma(Pragma::schemaVersion()));
+    handle->markErrorAsUnignorable(2);
+    if (!succeed) {
+        return;
+    }
+    UnsafeData rawKey = handle->getDerivedCipherKey();
+    if (!rawKey.empty()) {
+        CipherKeyCache::shared().put(cacheKey, rawKey);
     }
-    return ret;
 }
 
 UnsafeData CipherConfig::getCipherKey()
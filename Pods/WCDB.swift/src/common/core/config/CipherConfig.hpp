@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "CipherKeyCache.hpp"
 #include "Config.hpp"
 #include "Data.hpp"
 #include "WINQ.h"
@@ -39,6 +40,8 @@ public:
     UnsafeData getCipherKey();
 
 protected:
+    void tryCacheDerivedKey(InnerHandle *handle, const CipherKeyCache::Key &cacheKey);
+
     const Data m_key;
     const int m_pageSize;
     const int m_cipherVersion = 4;
@@ -0,0 +1,220 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CipherKeyCache.hpp"
+#include "CoreConst.h"
+#include "SQLite.h"
+#include <random>
+
+namespace WCDB {
+
+#pragma mark - Secure Buffer
+CipherKeyCache::SecureBuffer::SecureBuffer() = default;
+
+CipherKeyCache::SecureBuffer::SecureBuffer(const UnsafeData &data)
+: m_buffer(data.buffer(), data.buffer() + data.size())
+{
+}
+
+CipherKeyCache::SecureBuffer::SecureBuffer(const SecureBuffer &other)
+: m_buffer(other.m_buffer)
+{
+}
+
+CipherKeyCache::SecureBuffer &CipherKeyCache::SecureBuffer::operator=(const SecureBuffer &other)
+{
+    if (this != &other) {
+        wipe();
+        m_buffer = other.m_buffer;
+    }
+    return *this;
+}
+
+CipherKeyCache::SecureBuffer::~SecureBuffer()
+{
+    wipe();
+}
+
+void CipherKeyCache::SecureBuffer::wipe()
+{
+    // volatile prevents the wiping from being optimized out.
+    volatile unsigned char *buffer = m_buffer.data();
+    for (size_t i = 0; i < m_buffer.size(); ++i) {
+        buffer[i] = 0;
+    }
+    m_buffer.clear();
+}
+
+UnsafeData CipherKeyCache::SecureBuffer::data() const
+{
+    return UnsafeData(const_cast<unsigned char *>(m_buffer.data()), m_buffer.size());
+}
+
+bool CipherKeyCache::SecureBuffer::empty() const
+{
+    return m_buffer.empty();
+}
+
+bool CipherKeyCache::SecureBuffer::operator<(const SecureBuffer &other) const
+{
+    return m_buffer < other.m_buffer;
+}
+
+#pragma mark - Key
+CipherKeyCache::Key::Key()
+: cipherVersion(0), pageSize(0), kdfIteration(0), kdfAlgorithm(0), hmacAlgorithm(0)
+{
+}
+
+bool CipherKeyCache::Key::empty() const
+{
+    return digest.empty();
+}
+
+bool CipherKeyCache::Key::operator<(const Key &other) const
+{
+    if (cipherVersion != other.cipherVersion) {
+        return cipherVersion < other.cipherVersion;
+    }
+    if (pageSize != other.pageSize) {
+        return pageSize < other.pageSize;
+    }
+    if (kdfIteration != other.kdfIteration) {
+        return kdfIteration < other.kdfIteration;
+    }
+    if (kdfAlgorithm != other.kdfAlgorithm) {
+        return kdfAlgorithm < other.kdfAlgorithm;
+    }
+    if (hmacAlgorithm != other.hmacAlgorithm) {
+        return hmacAlgorithm < other.hmacAlgorithm;
+    }
+    int compared = salt.compare(other.salt);
+    if (compared != 0) {
+        return compared < 0;
+    }
+    return digest < other.digest;
+}
+
+#pragma mark - Cache
+CipherKeyCache &CipherKeyCache::shared()
+{
+    static CipherKeyCache *s_cipherKeyCache = new CipherKeyCache;
+    return *s_cipherKeyCache;
+}
+
+CipherKeyCache::CipherKeyCache() : m_hits(0), m_misses(0)
+{
+    std::random_device device;
+    std::vector<unsigned char> secret(CipherKeyCacheSecretSize);
+    for (auto &byte : secret) {
+        byte = (unsigned char) device();
+    }
+    m_secret = SecureBuffer(UnsafeData(secret.data(), secret.size()));
+    volatile unsigned char *buffer = secret.data();
+    for (size_t i = 0; i < secret.size(); ++i) {
+        buffer[i] = 0;
+    }
+}
+
+CipherKeyCache::Key CipherKeyCache::generateKey(void *cipherContext,
+                                                const UnsafeData &passphrase,
+                                                const UnsafeStringView &salt,
+                                                int cipherVersion,
+                                                int pageSize) const
+{
+    Key key;
+    if (cipherContext == nullptr) {
+        return key;
+    }
+    unsigned char digest[CipherKeyCacheDigestSize];
+    UnsafeData secret = m_secret.data();
+    if (sqlcipher_codec_keyed_hash(cipherContext,
+                                   secret.buffer(),
+                                   (int) secret.size(),
+                                   passphrase.buffer(),
+                                   (int) passphrase.size(),
+                                   digest)
+        != SQLITE_OK) {
+        return key;
+    }
+    key.digest = SecureBuffer(UnsafeData(digest, sizeof(digest)));
+    key.salt = salt;
+    key.cipherVersion = cipherVersion;
+    key.pageSize = pageSize;
+    key.kdfIteration = sqlcipher_codec_ctx_get_kdf_iter(cipherContext);
+    key.kdfAlgorithm = sqlcipher_codec_ctx_get_kdf_algorithm(cipherContext);
+    key.hmacAlgorithm = sqlcipher_codec_ctx_get_hmac_algorithm(cipherContext);
+    return key;
+}
+
+CipherKeyCache::SecureBuffer CipherKeyCache::get(const Key &key)
+{
+    SecureBuffer rawKey;
+    {
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        rawKey = m_cache.find(key);
+    }
+    if (!rawKey.empty()) {
+        ++m_hits;
+    } else {
+        ++m_misses;
+    }
+    return rawKey;
+}
+
+void CipherKeyCache::put(const Key &key, const UnsafeData &rawKey)
+{
+    WCTAssert(!rawKey.empty());
+    std::lock_guard<std::mutex> lockGuard(m_lock);
+    m_cache.put(key, SecureBuffer(rawKey));
+}
+
+CipherKeyCache::Statistics CipherKeyCache::getStatistics() const
+{
+    Statistics statistics;
+    statistics.hits = m_hits.load();
+    statistics.misses = m_misses.load();
+    return statistics;
+}
+
+CipherKeyCache::Cache::Cache() : LRUCache<Key, SecureBuffer>()
+{
+}
+
+CipherKeyCache::Cache::~Cache() = default;
+
+CipherKeyCache::SecureBuffer CipherKeyCache::Cache::find(const Key &key)
+{
+    if (!exists(key)) {
+        return SecureBuffer();
+    }
+    return get(key);
+}
+
+bool CipherKeyCache::Cache::shouldPurge() const
+{
+    return size() > CipherKeyCacheMaxCount;
+}
+
+} //namespace WCDB
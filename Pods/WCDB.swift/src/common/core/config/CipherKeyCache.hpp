@@ -0,0 +1,115 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "LRUCache.hpp"
+#include "Lock.hpp"
+#include "StringView.hpp"
+#include "UnsafeData.hpp"
+#include <atomic>
+#include <vector>
+
+namespace WCDB {
+
+// Process-wide cache of the raw keys derived by SQLCipher, so that the following handles can install the raw key directly instead of running PBKDF2 again.
+class CipherKeyCache final {
+public:
+    static CipherKeyCache &shared();
+
+    // Buffer that is wiped before being released.
+    class SecureBuffer final {
+    public:
+        SecureBuffer();
+        SecureBuffer(const UnsafeData &data);
+        SecureBuffer(const SecureBuffer &other);
+        SecureBuffer &operator=(const SecureBuffer &other);
+        ~SecureBuffer();
+
+        UnsafeData data() const;
+        bool empty() const;
+        bool operator<(const SecureBuffer &other) const;
+
+    protected:
+        void wipe();
+        std::vector<unsigned char> m_buffer;
+    };
+
+    // The passphrase is kept as its keyed hash, and the parameters of key derivation are compared since they can be changed by the default cipher configuration.
+    struct Key {
+        Key();
+        SecureBuffer digest;
+        StringView salt;
+        int cipherVersion;
+        int pageSize;
+        int kdfIteration;
+        int kdfAlgorithm;
+        int hmacAlgorithm;
+        bool empty() const;
+        bool operator<(const Key &other) const;
+    };
+
+    // Parameters of key derivation are read from the cipher context that the passphrase is just set to.
+    // empty key will be returned if the passphrase fails to be hashed.
+    Key generateKey(void *cipherContext,
+                    const UnsafeData &passphrase,
+                    const UnsafeStringView &salt,
+                    int cipherVersion,
+                    int pageSize) const;
+
+    // empty buffer will be returned if not cached
+    SecureBuffer get(const Key &key);
+    void put(const Key &key, const UnsafeData &rawKey);
+
+    struct Statistics {
+        uint64_t hits;
+        uint64_t misses;
+    };
+    Statistics getStatistics() const;
+
+protected:
+    CipherKeyCache();
+    CipherKeyCache(const CipherKeyCache &) = delete;
+    CipherKeyCache &operator=(const CipherKeyCache &) = delete;
+
+    class Cache final : public LRUCache<Key, SecureBuffer> {
+    public:
+        Cache();
+        ~Cache() override final;
+
+        SecureBuffer find(const Key &key);
+
+    protected:
+        bool shouldPurge() const override final;
+    };
+
+    // Secret of keyed hash, which is random for each process.
+    SecureBuffer m_secret;
+    std::mutex m_lock;
+    Cache m_cache;
+    std::atomic<uint64_t> m_hits;
+    std::atomic<uint64_t> m_misses;
+};
+
+} //namespace WCDB
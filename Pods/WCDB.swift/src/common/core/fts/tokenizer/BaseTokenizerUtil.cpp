@@ -25,6 +25,12 @@
 #include "BaseTokenizerUtil.hpp"
 #include "Assertion.hpp"
 #include "FTSError.hpp"
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 namespace WCDB {
 
@@ -92,19 +98,73 @@ void BaseTokenizerUtil::stepOneUnicode(const UnsafeStringView input,
     }
 }
 
+int BaseTokenizerUtil::lengthOfASCIIRun(const UnsafeStringView input, UnicodeType type)
+{
+    WCTAssert(type == UnicodeType::BasicMultilingualPlaneLetter
+              || type == UnicodeType::BasicMultilingualPlaneDigit);
+    // Letters are matched case-insensitively by setting the 0x20 bit.
+    const unsigned char caseMask = type == UnicodeType::BasicMultilingualPlaneLetter ? 0x20 : 0;
+    const unsigned char lowerBound = type == UnicodeType::BasicMultilingualPlaneLetter ? 'a' : '0';
+    const unsigned char range = type == UnicodeType::BasicMultilingualPlaneLetter ? 26 : 10;
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(input.data());
+    size_t length = input.length();
+    size_t offset = 0;
+#if defined(__SSE2__)
+    const __m128i vCaseMask = _mm_set1_epi8((char) caseMask);
+    const __m128i vLowerBound = _mm_set1_epi8((char) lowerBound);
+    const __m128i vUpperBound = _mm_set1_epi8((char) (range - 1));
+    for (; offset + 16 <= length; offset += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + offset));
+        // (byte | caseMask) - lowerBound <= range - 1, which is compared in unsigned
+        __m128i shifted = _mm_sub_epi8(_mm_or_si128(block, vCaseMask), vLowerBound);
+        __m128i matched = _mm_cmpeq_epi8(_mm_min_epu8(shifted, vUpperBound), shifted);
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(matched);
+        if (mask != 0xFFFF) {
+            return (int) (offset + __builtin_ctz(~mask));
+        }
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint8x16_t vCaseMask = vdupq_n_u8(caseMask);
+    const uint8x16_t vLowerBound = vdupq_n_u8(lowerBound);
+    const uint8x16_t vUpperBound = vdupq_n_u8((unsigned char) (range - 1));
+    for (; offset + 16 <= length; offset += 16) {
+        uint8x16_t block = vld1q_u8(bytes + offset);
+        uint8x16_t shifted = vsubq_u8(vorrq_u8(block, vCaseMask), vLowerBound);
+        if (vminvq_u8(vcleq_u8(shifted, vUpperBound)) != 0xFF) {
+            // leave the unmatched block to the scalar loop
+            break;
+        }
+    }
+#endif
+    for (; offset < length; ++offset) {
+        if ((unsigned char) ((bytes[offset] | caseMask) - lowerBound) >= range) {
+            break;
+        }
+    }
+    return (int) offset;
+}
+
 #pragma mark - Symbol Detect
 
 bool BaseTokenizerUtil::isSymbol(UnicodeChar theChar)
 {
-    if (getSymbolDetector() == nullptr) {
-        return false;
-    }
-    return getSymbolDetector()(theChar);
+    return (getSymbolBitmap()[theChar >> 6] >> (theChar & 63)) & 1;
 }
 
 void BaseTokenizerUtil::configSymbolDetector(SymbolDetector detector)
 {
     getSymbolDetector() = detector;
+    uint64_t* bitmap = getSymbolBitmap();
+    memset(bitmap, 0, sizeof(uint64_t) * (UINT16_MAX + 1) / 64);
+    if (detector == nullptr) {
+        return;
+    }
+    for (uint32_t theChar = 0; theChar <= UINT16_MAX; ++theChar) {
+        if (detector((UnicodeChar) theChar)) {
+            bitmap[theChar >> 6] |= (uint64_t) 1 << (theChar & 63);
+        }
+    }
 }
 
 BaseTokenizerUtil::SymbolDetector& BaseTokenizerUtil::getSymbolDetector()
@@ -113,6 +173,12 @@ BaseTokenizerUtil::SymbolDetector& BaseTokenizerUtil::getSymbolDetector()
     return g_detector;
 }
 
+uint64_t* BaseTokenizerUtil::getSymbolBitmap()
+{
+    static uint64_t* g_bitmap = new uint64_t[(UINT16_MAX + 1) / 64]();
+    return g_bitmap;
+}
+
 #pragma mark - Unicode Normalize
 
 StringView BaseTokenizerUtil::normalizeToken(UnsafeStringView& token)
@@ -123,6 +189,11 @@ StringView BaseTokenizerUtil::normalizeToken(UnsafeStringView& token)
     return getUnicodeNormalizer()(token);
 }
 
+bool BaseTokenizerUtil::hasUnicodeNormalizer()
+{
+    return getUnicodeNormalizer() != nullptr;
+}
+
 void BaseTokenizerUtil::configUnicodeNormalizer(UnicodeNormalizer normalizer)
 {
     getUnicodeNormalizer() = normalizer;
@@ -139,26 +210,86 @@ BaseTokenizerUtil::UnicodeNormalizer& BaseTokenizerUtil::getUnicodeNormalizer()
 const std::vector<StringView>
 BaseTokenizerUtil::getPinYin(const UnsafeStringView& chineseCharacter)
 {
-    WCTAssert(g_pinyinDict != nullptr || getPinyinConverter() != nullptr);
+    WCTAssert(g_pinyinTable != nullptr || g_pinyinDict != nullptr
+              || getPinyinConverter() != nullptr);
+    CodepointDictionary::Values pinyins;
+    if (findPinYin(chineseCharacter, pinyins)) {
+        std::vector<StringView> result;
+        result.reserve(pinyins.size());
+        for (size_t i = 0; i < pinyins.size(); ++i) {
+            result.push_back(pinyins[i]);
+        }
+        return result;
+    }
     if (g_pinyinDict != nullptr) {
         auto iter = g_pinyinDict->find(chineseCharacter);
         if (iter != g_pinyinDict->end()) {
             return iter->second;
         }
-    } else if (getPinyinConverter() != nullptr) {
+    } else if (g_pinyinTable == nullptr && getPinyinConverter() != nullptr) {
         return getPinyinConverter()(chineseCharacter);
     }
     return std::vector<StringView>();
 }
 
+bool BaseTokenizerUtil::findPinYin(const UnsafeStringView& chineseCharacter,
+                                   CodepointDictionary::Values& pinyins)
+{
+    if (g_pinyinTable == nullptr) {
+        return false;
+    }
+    pinyins = g_pinyinTable->find(chineseCharacter);
+    return !pinyins.empty();
+}
+
 WCDB::StringViewMap<std::vector<WCDB::StringView>>* BaseTokenizerUtil::g_pinyinDict = nullptr;
+CodepointDictionary* BaseTokenizerUtil::g_pinyinTable = nullptr;
 void BaseTokenizerUtil::configPinyinDict(WCDB::StringViewMap<std::vector<WCDB::StringView>>* dict)
 {
     if (g_pinyinDict != nullptr) {
         delete g_pinyinDict;
         g_pinyinDict = nullptr;
     }
-    g_pinyinDict = dict;
+    g_pinyinTable = nullptr;
+    if (dict == nullptr) {
+        return;
+    }
+    CodepointDictionary* table = new CodepointDictionary();
+    if (table->build(*dict) == 0) {
+        delete dict;
+    } else {
+        // Keep the keys that can't be compiled.
+        for (auto iter = dict->begin(); iter != dict->end();) {
+            uint16_t codepoint;
+            if (CodepointDictionary::decode(iter->first, codepoint)) {
+                iter = dict->erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+        g_pinyinDict = dict;
+    }
+    g_pinyinTable = table;
+}
+
+bool BaseTokenizerUtil::configPinyinDictFile(const UnsafeStringView& path)
+{
+    CodepointDictionary* table = new CodepointDictionary();
+    if (!table->load(path)) {
+        delete table;
+        return false;
+    }
+    if (g_pinyinDict != nullptr) {
+        delete g_pinyinDict;
+        g_pinyinDict = nullptr;
+    }
+    g_pinyinTable = table;
+    return true;
+}
+
+bool BaseTokenizerUtil::savePinyinDict(const UnsafeStringView& path)
+{
+    return g_pinyinTable != nullptr && g_pinyinTable->save(path);
 }
 
 void BaseTokenizerUtil::configPinyinConverter(PinYinConverter converter)
@@ -167,6 +298,7 @@ void BaseTokenizerUtil::configPinyinConverter(PinYinConverter converter)
         delete g_pinyinDict;
         g_pinyinDict = nullptr;
     }
+    g_pinyinTable = nullptr;
     getPinyinConverter() = converter;
 }
 
@@ -180,14 +312,22 @@ BaseTokenizerUtil::PinYinConverter& BaseTokenizerUtil::getPinyinConverter()
 
 const StringView BaseTokenizerUtil::getSimplifiedChinese(const UnsafeStringView& chineseCharacter)
 {
-    WCTAssert(g_traditionalChineseDict != nullptr
+    WCTAssert(g_traditionalChineseTable != nullptr || g_traditionalChineseDict != nullptr
               || getTraditionalChineseConverter() != nullptr);
+    if (g_traditionalChineseTable != nullptr) {
+        CodepointDictionary::Values simplified
+        = g_traditionalChineseTable->find(chineseCharacter);
+        if (!simplified.empty() && simplified[0].length() > 0) {
+            return simplified[0];
+        }
+    }
     if (g_traditionalChineseDict != nullptr) {
         auto iter = g_traditionalChineseDict->find(chineseCharacter);
         if (iter != g_traditionalChineseDict->end() && iter->second.length() > 0) {
             return iter->second;
         }
-    } else if (getTraditionalChineseConverter() != nullptr) {
+    } else if (g_traditionalChineseTable == nullptr
+               && getTraditionalChineseConverter() != nullptr) {
         const StringView traditionalChinese
         = getTraditionalChineseConverter()(chineseCharacter);
         if (traditionalChinese.length() > 0) {
@@ -198,13 +338,53 @@ const StringView BaseTokenizerUtil::getSimplifiedChinese(const UnsafeStringView&
 }
 
 WCDB::StringViewMap<WCDB::StringView>* BaseTokenizerUtil::g_traditionalChineseDict = nullptr;
+CodepointDictionary* BaseTokenizerUtil::g_traditionalChineseTable = nullptr;
 void BaseTokenizerUtil::configTraditionalChineseDict(WCDB::StringViewMap<WCDB::StringView>* dict)
 {
     if (g_traditionalChineseDict != nullptr) {
         delete g_traditionalChineseDict;
         g_traditionalChineseDict = nullptr;
     }
-    g_traditionalChineseDict = dict;
+    g_traditionalChineseTable = nullptr;
+    if (dict == nullptr) {
+        return;
+    }
+    CodepointDictionary* table = new CodepointDictionary();
+    if (table->build(*dict) == 0) {
+        delete dict;
+    } else {
+        // Keep the keys that can't be compiled.
+        for (auto iter = dict->begin(); iter != dict->end();) {
+            uint16_t codepoint;
+            if (CodepointDictionary::decode(iter->first, codepoint)) {
+                iter = dict->erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+        g_traditionalChineseDict = dict;
+    }
+    g_traditionalChineseTable = table;
+}
+
+bool BaseTokenizerUtil::configTraditionalChineseDictFile(const UnsafeStringView& path)
+{
+    CodepointDictionary* table = new CodepointDictionary();
+    if (!table->load(path)) {
+        delete table;
+        return false;
+    }
+    if (g_traditionalChineseDict != nullptr) {
+        delete g_traditionalChineseDict;
+        g_traditionalChineseDict = nullptr;
+    }
+    g_traditionalChineseTable = table;
+    return true;
+}
+
+bool BaseTokenizerUtil::saveTraditionalChineseDict(const UnsafeStringView& path)
+{
+    return g_traditionalChineseTable != nullptr && g_traditionalChineseTable->save(path);
 }
 
 void BaseTokenizerUtil::configTraditionalChineseConverter(TraditionalChineseConverter converter)
@@ -213,6 +393,7 @@ void BaseTokenizerUtil::configTraditionalChineseConverter(TraditionalChineseConv
         delete g_traditionalChineseDict;
         g_traditionalChineseDict = nullptr;
     }
+    g_traditionalChineseTable = nullptr;
     getTraditionalChineseConverter() = converter;
 }
 
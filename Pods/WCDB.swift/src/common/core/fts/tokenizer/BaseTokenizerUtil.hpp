@@ -24,8 +24,10 @@
 
 #pragma once
 
+#include "CodepointDictionary.hpp"
 #include "StringView.hpp"
 #include <functional>
+#include <stdint.h>
 #include <vector>
 
 namespace WCDB {
@@ -42,6 +44,9 @@ public:
     };
     static void
     stepOneUnicode(const UnsafeStringView input, UnicodeType& unicodeType, int& unicodeLength);
+    // Return the length of the leading run of input in which all characters are ASCII letters, or ASCII digits, according to the type.
+    // It classifies 16 bytes at once when SIMD is available.
+    static int lengthOfASCIIRun(const UnsafeStringView input, UnicodeType type);
 
     typedef unsigned short UnicodeChar;
     typedef std::function<bool(UnicodeChar)> SymbolDetector;
@@ -51,23 +56,41 @@ public:
     typedef std::function<StringView(const UnsafeStringView&)> UnicodeNormalizer;
     static void configUnicodeNormalizer(UnicodeNormalizer normalizer);
     static StringView normalizeToken(UnsafeStringView& token);
+    static bool hasUnicodeNormalizer();
 
     static const std::vector<StringView> getPinYin(const UnsafeStringView& chineseCharacter);
+    // It's the allocation-free version of getPinYin, which works only if the pinyin dict is configured.
+    // Return false if the character is not in the compiled dict.
+    static bool findPinYin(const UnsafeStringView& chineseCharacter,
+                           CodepointDictionary::Values& pinyins);
     typedef std::function<std::vector<StringView>(const UnsafeStringView&)> PinYinConverter;
     static void configPinyinConverter(PinYinConverter converter);
+    // The dict is compiled into a codepoint-indexed table.
     static void
     configPinyinDict(WCDB::StringViewMap<std::vector<WCDB::StringView>>* dict);
+    // Load a table saved by savePinyinDict, which is memory-mapped instead of being rebuilt.
+    static bool configPinyinDictFile(const UnsafeStringView& path);
+    static bool savePinyinDict(const UnsafeStringView& path);
 
     static const StringView getSimplifiedChinese(const UnsafeStringView& chineseCharacter);
     typedef std::function<const StringView(const UnsafeStringView&)> TraditionalChineseConverter;
     static void configTraditionalChineseConverter(TraditionalChineseConverter converter);
+    // The dict is compiled into a codepoint-indexed table.
     static void configTraditionalChineseDict(WCDB::StringViewMap<WCDB::StringView>* dict);
+    // Load a table saved by saveTraditionalChineseDict, which is memory-mapped instead of being rebuilt.
+    static bool configTraditionalChineseDictFile(const UnsafeStringView& path);
+    static bool saveTraditionalChineseDict(const UnsafeStringView& path);
 
 private:
     static PinYinConverter& getPinyinConverter();
     static WCDB::StringViewMap<std::vector<WCDB::StringView>>* g_pinyinDict;
+    // Tables are never released since the strings in them may be still referred by tokens.
+    static CodepointDictionary* g_pinyinTable;
+    static CodepointDictionary* g_traditionalChineseTable;
 
     static SymbolDetector& getSymbolDetector();
+    // Compiled from the symbol detector, one bit for each character in Basic Multilingual Plane.
+    static uint64_t* getSymbolBitmap();
     static UnicodeNormalizer& getUnicodeNormalizer();
     static TraditionalChineseConverter& getTraditionalChineseConverter();
     static WCDB::StringViewMap<WCDB::StringView>* g_traditionalChineseDict;
@@ -0,0 +1,301 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CodepointDictionary.hpp"
+#include "Assertion.hpp"
+#include "FileHandle.hpp"
+#include <string.h>
+
+namespace WCDB {
+
+CodepointDictionary::CodepointDictionary()
+: m_header(nullptr)
+, m_size(0)
+, m_directory(nullptr)
+, m_blocks(nullptr)
+, m_lists(nullptr)
+, m_values(nullptr)
+, m_pool(nullptr)
+{
+}
+
+bool CodepointDictionary::empty() const
+{
+    return m_header == nullptr || m_header->numberOfLists == 0;
+}
+
+bool CodepointDictionary::decode(const UnsafeStringView &character, uint16_t &codepoint)
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(character.data());
+    switch (character.length()) {
+    case 1:
+        if (bytes[0] < 0x80) {
+            codepoint = bytes[0];
+            return true;
+        }
+        break;
+    case 2:
+        if (bytes[0] >= 0xC0 && bytes[0] < 0xE0 && (bytes[1] & 0xC0) == 0x80) {
+            codepoint = (uint16_t) (((bytes[0] & 0x1F) << 6) | (bytes[1] & 0x3F));
+            return true;
+        }
+        break;
+    case 3:
+        if (bytes[0] >= 0xE0 && bytes[0] < 0xF0 && (bytes[1] & 0xC0) == 0x80
+            && (bytes[2] & 0xC0) == 0x80) {
+            codepoint = (uint16_t) (((bytes[0] & 0x0F) << 12) | ((bytes[1] & 0x3F) << 6)
+                                    | (bytes[2] & 0x3F));
+            return true;
+        }
+        break;
+    default:
+        break;
+    }
+    return false;
+}
+
+#pragma mark - Build
+size_t CodepointDictionary::build(const StringViewMap<std::vector<StringView>> &dict)
+{
+    std::map<uint16_t, std::vector<UnsafeStringView>> lists;
+    size_t skipped = 0;
+    for (const auto &iter : dict) {
+        uint16_t codepoint;
+        if (!decode(iter.first, codepoint)) {
+            ++skipped;
+            continue;
+        }
+        std::vector<UnsafeStringView> &values = lists[codepoint];
+        values.insert(values.end(), iter.second.begin(), iter.second.end());
+    }
+    compile(lists);
+    return skipped;
+}
+
+size_t CodepointDictionary::build(const StringViewMap<StringView> &dict)
+{
+    std::map<uint16_t, std::vector<UnsafeStringView>> lists;
+    size_t skipped = 0;
+    for (const auto &iter : dict) {
+        uint16_t codepoint;
+        if (!decode(iter.first, codepoint)) {
+            ++skipped;
+            continue;
+        }
+        lists[codepoint].push_back(iter.second);
+    }
+    compile(lists);
+    return skipped;
+}
+
+void CodepointDictionary::compile(const std::map<uint16_t, std::vector<UnsafeStringView>> &lists)
+{
+    std::vector<uint32_t> directory(BlockSize, 0);
+    std::vector<uint32_t> blocks;
+    std::vector<uint32_t> listBegins;
+    std::vector<uint32_t> values;
+    std::vector<char> pool;
+    for (const auto &list : lists) {
+        uint32_t &block = directory[list.first >> 8];
+        if (block == 0) {
+            blocks.resize(blocks.size() + BlockSize, 0);
+            block = (uint32_t) (blocks.size() / BlockSize);
+        }
+        listBegins.push_back((uint32_t) (values.size() / 2));
+        blocks[(block - 1) * BlockSize + (list.first & 0xFF)] = (uint32_t) listBegins.size();
+        for (const UnsafeStringView &value : list.second) {
+            values.push_back((uint32_t) pool.size());
+            values.push_back((uint32_t) value.length());
+            pool.insert(pool.end(), value.data(), value.data() + value.length());
+            pool.push_back('\0');
+        }
+    }
+    listBegins.push_back((uint32_t) (values.size() / 2));
+
+    Header header;
+    header.magic = Magic;
+    header.version = Version;
+    header.numberOfBlocks = (uint32_t) (blocks.size() / BlockSize);
+    header.numberOfLists = (uint32_t) listBegins.size() - 1;
+    header.numberOfValues = (uint32_t) (values.size() / 2);
+    header.poolSize = (uint32_t) pool.size();
+
+    m_built.clear();
+    auto append = [this](const void *data, size_t size) {
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+        m_built.insert(m_built.end(), bytes, bytes + size);
+    };
+    append(&header, sizeof(Header));
+    append(directory.data(), directory.size() * sizeof(uint32_t));
+    append(blocks.data(), blocks.size() * sizeof(uint32_t));
+    append(listBegins.data(), listBegins.size() * sizeof(uint32_t));
+    append(values.data(), values.size() * sizeof(uint32_t));
+    append(pool.data(), pool.size());
+    m_mapped = MappedData::null();
+
+    WCTRemedialAssert(attach(m_built.data(), m_built.size()),
+                      "Built codepoint dictionary is malformed.",
+                      m_built.clear(););
+}
+
+bool CodepointDictionary::attach(const unsigned char *buffer, size_t size)
+{
+    m_header = nullptr;
+    m_size = 0;
+    if (size < sizeof(Header)) {
+        return false;
+    }
+    const Header *header = reinterpret_cast<const Header *>(buffer);
+    if (header->magic != Magic || header->version != Version) {
+        return false;
+    }
+    uint64_t numberOfWords = BlockSize + (uint64_t) header->numberOfBlocks * BlockSize
+                             + (uint64_t) header->numberOfLists + 1
+                             + (uint64_t) header->numberOfValues * 2;
+    if (sizeof(Header) + numberOfWords * sizeof(uint32_t) + header->poolSize != size) {
+        return false;
+    }
+    const uint32_t *directory = reinterpret_cast<const uint32_t *>(buffer + sizeof(Header));
+    const uint32_t *blocks = directory + BlockSize;
+    const uint32_t *lists = blocks + (size_t) header->numberOfBlocks * BlockSize;
+    const uint32_t *values = lists + header->numberOfLists + 1;
+    const char *pool = reinterpret_cast<const char *>(values + (size_t) header->numberOfValues * 2);
+
+    // Validate once so that lookups need no bound check.
+    for (int i = 0; i < BlockSize; ++i) {
+        if (directory[i] > header->numberOfBlocks) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < (size_t) header->numberOfBlocks * BlockSize; ++i) {
+        if (blocks[i] > header->numberOfLists) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header->numberOfLists; ++i) {
+        if (lists[i] > lists[i + 1]) {
+            return false;
+        }
+    }
+    if (lists[0] != 0 || lists[header->numberOfLists] != header->numberOfValues) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->numberOfValues; ++i) {
+        uint64_t end = (uint64_t) values[2 * i] + values[2 * i + 1];
+        if (end >= header->poolSize || pool[end] != '\0') {
+            return false;
+        }
+    }
+
+    m_header = header;
+    m_size = size;
+    m_directory = directory;
+    m_blocks = blocks;
+    m_lists = lists;
+    m_values = values;
+    m_pool = pool;
+    return true;
+}
+
+#pragma mark - File
+bool CodepointDictionary::load(const UnsafeStringView &path)
+{
+    FileHandle fileHandle(path);
+    if (!fileHandle.open(FileHandle::Mode::ReadOnly)) {
+        return false;
+    }
+    ssize_t size = fileHandle.size();
+    if (size <= 0) {
+        return false;
+    }
+    MappedData mapped = fileHandle.map(0, (size_t) size);
+    fileHandle.close();
+    if (mapped.empty() || !attach(mapped.buffer(), mapped.size())) {
+        return false;
+    }
+    m_mapped = std::move(mapped);
+    m_built.clear();
+    return true;
+}
+
+bool CodepointDictionary::save(const UnsafeStringView &path) const
+{
+    if (m_header == nullptr) {
+        return false;
+    }
+    FileHandle fileHandle(path);
+    if (!fileHandle.open(FileHandle::Mode::OverWrite)) {
+        return false;
+    }
+    bool succeed = fileHandle.write(
+    UnsafeData::immutable(reinterpret_cast<const unsigned char *>(m_header), m_size));
+    fileHandle.close();
+    return succeed;
+}
+
+#pragma mark - Lookup
+CodepointDictionary::Values CodepointDictionary::find(const UnsafeStringView &character) const
+{
+    uint16_t codepoint;
+    if (m_header == nullptr || !decode(character, codepoint)) {
+        return Values();
+    }
+    uint32_t block = m_directory[codepoint >> 8];
+    if (block == 0) {
+        return Values();
+    }
+    uint32_t list = m_blocks[(block - 1) * BlockSize + (codepoint & 0xFF)];
+    if (list == 0) {
+        return Values();
+    }
+    return Values(this, m_lists[list - 1], m_lists[list]);
+}
+
+CodepointDictionary::Values::Values()
+: m_dictionary(nullptr), m_begin(0), m_end(0)
+{
+}
+
+CodepointDictionary::Values::Values(const CodepointDictionary *dictionary, uint32_t begin, uint32_t end)
+: m_dictionary(dictionary), m_begin(begin), m_end(end)
+{
+}
+
+size_t CodepointDictionary::Values::size() const
+{
+    return m_end - m_begin;
+}
+
+bool CodepointDictionary::Values::empty() const
+{
+    return m_begin == m_end;
+}
+
+StringView CodepointDictionary::Values::operator[](size_t index) const
+{
+    WCTAssert(m_dictionary != nullptr && index < size());
+    return StringView::makeConstant(
+    m_dictionary->m_pool + m_dictionary->m_values[2 * (m_begin + index)]);
+}
+
+} //namespace WCDB
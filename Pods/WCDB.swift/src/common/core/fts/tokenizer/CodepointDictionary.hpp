@@ -0,0 +1,112 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "MappedData.hpp"
+#include "StringView.hpp"
+#include <map>
+#include <stdint.h>
+#include <vector>
+
+namespace WCDB {
+
+/*
+ * An immutable dictionary keyed by a single character in Basic Multilingual Plane.
+ * Code point is looked up with a two-level array, and values are kept in a shared string pool,
+ * so that a lookup neither compares strings nor allocates.
+ * The whole dictionary is a single contiguous buffer, which can be saved and then memory-mapped.
+ *
+ * Layout, all the integers are uint32 in native byte order:
+ * [Header]
+ * [Directory] 256 entries, block index + 1 for the high byte of code point, 0 for none.
+ * [Blocks] 256 entries each, list index + 1 for the low byte of code point, 0 for none.
+ * [Lists] numberOfLists + 1 entries, index of the first value of each list.
+ * [Values] offset and length of each value in pool.
+ * [Pool] null-terminated strings.
+ */
+class CodepointDictionary final {
+public:
+    CodepointDictionary();
+    CodepointDictionary(const CodepointDictionary &) = delete;
+    CodepointDictionary &operator=(const CodepointDictionary &) = delete;
+
+    // Keys that are not a single character in Basic Multilingual Plane are skipped.
+    // Return the number of skipped keys.
+    size_t build(const StringViewMap<std::vector<StringView>> &dict);
+    size_t build(const StringViewMap<StringView> &dict);
+
+    bool load(const UnsafeStringView &path);
+    bool save(const UnsafeStringView &path) const;
+
+    bool empty() const;
+
+    class Values final {
+    public:
+        Values();
+        size_t size() const;
+        bool empty() const;
+        // It refers to the pool without copying.
+        StringView operator[](size_t index) const;
+
+    private:
+        friend class CodepointDictionary;
+        Values(const CodepointDictionary *dictionary, uint32_t begin, uint32_t end);
+        const CodepointDictionary *m_dictionary;
+        uint32_t m_begin;
+        uint32_t m_end;
+    };
+    Values find(const UnsafeStringView &character) const;
+
+    // Return false if it's not a single character in Basic Multilingual Plane.
+    static bool decode(const UnsafeStringView &character, uint16_t &codepoint);
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t numberOfBlocks;
+        uint32_t numberOfLists;
+        uint32_t numberOfValues;
+        uint32_t poolSize;
+    };
+    static constexpr const uint32_t Magic = 0x57435044; // WCPD
+    static constexpr const uint32_t Version = 1;
+    static constexpr const int BlockSize = 256;
+
+    void compile(const std::map<uint16_t, std::vector<UnsafeStringView>> &lists);
+    bool attach(const unsigned char *buffer, size_t size);
+
+    std::vector<unsigned char> m_built;
+    MappedData m_mapped;
+
+    const Header *m_header;
+    size_t m_size;
+    const uint32_t *m_directory;
+    const uint32_t *m_blocks;
+    const uint32_t *m_lists;
+    const uint32_t *m_values;
+    const char *m_pool;
+};
+
+} //namespace WCDB
@@ -26,7 +26,6 @@
 #include "Assertion.hpp"
 #include "FTSConst.h"
 #include "FTSError.hpp"
-#include <algorithm>
 
 extern "C" {
 extern int porterStem(char *p, int i, int j);
@@ -124,9 +123,11 @@ int OneOrBinaryTokenizer::stepNextToken()
         case UnicodeType::BasicMultilingualPlaneLetter:
         case UnicodeType::BasicMultilingualPlaneDigit:
             m_startOffset = m_cursor;
-            do {
-                cursorStep();
-            } while (m_cursorTokenType == m_preTokenType);
+            // Skip to the last character of the ASCII run at once.
+            m_cursor += BaseTokenizerUtil::lengthOfASCIIRun(
+                        UnsafeStringView(m_input + m_cursor, m_inputLength - m_cursor), m_preTokenType)
+                        - 1;
+            cursorStep();
             m_endOffset = m_cursor;
             m_tokenLength = m_endOffset - m_startOffset;
             break;
@@ -168,7 +169,10 @@ void OneOrBinaryTokenizer::lemmatization(const char *input, int inputLength)
 {
     // tolower only. You can implement your own lemmatization.
     m_token.assign(input, input + inputLength);
-    std::transform(m_token.begin(), m_token.end(), m_token.begin(), ::tolower);
+    // The input only contains ASCII letters.
+    for (char &letter : m_token) {
+        letter |= 0x20;
+    }
     if (!m_skipStemming) {
         m_tokenLength = porterStem(m_token.data(), 0, m_tokenLength - 1) + 1;
     }
@@ -203,10 +207,16 @@ void OneOrBinaryTokenizer::genToken()
         lemmatization(m_input + m_startOffset, m_tokenLength);
     } else if (m_preTokenType != UnicodeType::BasicMultilingualPlaneOther
                || !m_needSimplifiedChinese) {
-        UnsafeStringView token = UnsafeStringView(m_input + m_startOffset, m_tokenLength);
-        StringView nomalizeToken = BaseTokenizerUtil::normalizeToken(token);
-        m_tokenLength = (int) nomalizeToken.length();
-        m_token.assign(nomalizeToken.data(), nomalizeToken.data() + m_tokenLength);
+        const char *token = m_input + m_startOffset;
+        if (BaseTokenizerUtil::hasUnicodeNormalizer()) {
+            UnsafeStringView unnormalizedToken = UnsafeStringView(token, m_tokenLength);
+            StringView nomalizeToken = BaseTokenizerUtil::normalizeToken(unnormalizedToken);
+            m_tokenLength = (int) nomalizeToken.length();
+            m_token.assign(nomalizeToken.data(), nomalizeToken.data() + m_tokenLength);
+        } else {
+            // copy into the reused buffer directly
+            m_token.assign(token, token + m_tokenLength);
+        }
     } else if (!m_needBinary || m_subTokensDoubleChar) {
         UnsafeStringView token = UnsafeStringView(m_input + m_startOffset, m_tokenLength);
         StringView nomalizeToken = BaseTokenizerUtil::normalizeToken(token);
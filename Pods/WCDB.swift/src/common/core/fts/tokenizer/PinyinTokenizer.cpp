@@ -138,9 +138,11 @@ int PinyinTokenizer::stepNextToken()
     case UnicodeType::BasicMultilingualPlaneOther:
         m_startOffset = m_cursor;
         if (m_preTokenType == UnicodeType::BasicMultilingualPlaneLetter) {
-            do {
-                cursorStep();
-            } while (m_cursorTokenType == m_preTokenType);
+            // Skip to the last character of the ASCII run at once.
+            m_cursor += BaseTokenizerUtil::lengthOfASCIIRun(
+                        UnsafeStringView(m_input + m_cursor, m_inputLength - m_cursor), m_preTokenType)
+                        - 1;
+            cursorStep();
         } else {
             cursorStep();
         }
@@ -181,35 +183,48 @@ void PinyinTokenizer::genPinyinToken()
     m_pinyinTokenArr.clear();
     m_pinyinTokenIndex = 0;
     StringViewSet pinyinSet;
-    UnsafeStringView token = UnsafeStringView(m_input + m_startOffset, m_normalTokenLength);
-    const std::vector<StringView> pinyinPtr = BaseTokenizerUtil::getPinYin(token);
-    if (pinyinPtr.size() == 0) {
-        if (m_preTokenType == UnicodeType::BasicMultilingualPlaneSymbol
-            && token.length() > 0) {
-            m_pinyinTokenArr.emplace_back(token);
-        }
-        return;
-    }
-    for (const StringView &pinyin : pinyinPtr) {
+    auto addPinyin = [&](StringView &&pinyin) {
         if (pinyin.length() == 0) {
-            continue;
+            return;
         }
         if (pinyinSet.find(pinyin) != pinyinSet.end()) {
-            continue;
+            return;
         }
         //full pinyin
-        m_pinyinTokenArr.emplace_back(pinyin);
         pinyinSet.emplace(pinyin);
-        if (pinyin.length() <= 1) {
-            continue;
+        m_pinyinTokenArr.emplace_back(std::move(pinyin));
+        const StringView &fullPinyin = m_pinyinTokenArr.back();
+        if (fullPinyin.length() <= 1) {
+            return;
         }
-        UnsafeStringView shortPinyin = UnsafeStringView(pinyin.data(), 1);
+        UnsafeStringView shortPinyin = UnsafeStringView(fullPinyin.data(), 1);
         if (pinyinSet.find(shortPinyin) != pinyinSet.end()) {
-            continue;
+            return;
         }
         //short pinyin
         pinyinSet.emplace(shortPinyin);
         m_pinyinTokenArr.emplace_back(shortPinyin);
+    };
+
+    UnsafeStringView token = UnsafeStringView(m_input + m_startOffset, m_normalTokenLength);
+    CodepointDictionary::Values pinyins;
+    if (BaseTokenizerUtil::findPinYin(token, pinyins)) {
+        // pinyins refer to the compiled dict without copying
+        for (size_t i = 0; i < pinyins.size(); ++i) {
+            addPinyin(pinyins[i]);
+        }
+        return;
+    }
+    std::vector<StringView> pinyinPtr = BaseTokenizerUtil::getPinYin(token);
+    if (pinyinPtr.size() == 0) {
+        if (m_preTokenType == UnicodeType::BasicMultilingualPlaneSymbol
+            && token.length() > 0) {
+            m_pinyinTokenArr.emplace_back(token);
+        }
+        return;
+    }
+    for (StringView &pinyin : pinyinPtr) {
+        addPinyin(std::move(pinyin));
     }
 }
 
@@ -34,6 +34,9 @@ MigrateHandle::MigrateHandle()
 : m_migratingInfo(nullptr)
 , m_migrateStatement(getStatement())
 , m_removeMigratedStatement(getStatement())
+, m_selectRowIDRangeStatement(getStatement())
+, m_batchMigration(true)
+, m_preparedForBatch(false)
 , m_samplePointing(0)
 {
 }
@@ -43,6 +46,7 @@ MigrateHandle::~MigrateHandle()
     finalizeMigrationStatement();
     returnStatement(m_migrateStatement);
     returnStatement(m_removeMigratedStatement);
+    returnStatement(m_selectRowIDRangeStatement);
 }
 
 bool MigrateHandle::reAttach(const UnsafeStringView& newPath, const Schema& newSchema)
@@ -147,25 +151,34 @@ Optional<bool> MigrateHandle::migrateRows(const MigrationInfo* info)
         m_migratingInfo = info;
     }
 
-    if (!m_migrateStatement->isPrepared()
-        && !m_migrateStatement->prepare(m_migratingInfo->getStatementForMigratingOneRow())) {
-        return NullOpt;
-    }
-
-    if (!m_removeMigratedStatement->isPrepared()
-        && !m_removeMigratedStatement->prepare(
-        m_migratingInfo->getStatementForDeletingMigratedOneRow())) {
+    if (!prepareMigrationStatement()) {
         return NullOpt;
     }
 
     double timeIntervalWithinTransaction = calculateTimeIntervalWithinTransaction();
+    int numberOfRowsPerBatch = 1;
+    if (m_batchMigration) {
+        numberOfRowsPerBatch = calculateNumberOfRowsPerBatch(timeIntervalWithinTransaction);
+    }
+    int numberOfMigratedRows = 0;
     SteadyClock beforeTransaction = SteadyClock::now();
     Optional<bool> migrated;
-    if (runTransaction([&migrated, &beforeTransaction, &timeIntervalWithinTransaction, this](
-                       InnerHandle*) -> bool {
+    if (runTransaction([&migrated,
+                        &beforeTransaction,
+                        &timeIntervalWithinTransaction,
+                        &numberOfMigratedRows,
+                        numberOfRowsPerBatch,
+                        this](InnerHandle*) -> bool {
             double cost = 0;
             do {
-                migrated = migrateRow();
+                if (m_batchMigration) {
+                    migrated = migrateBatch(numberOfRowsPerBatch, numberOfMigratedRows);
+                } else {
+                    migrated = migrateRow();
+                    if (migrated.succeed() && !migrated.value()) {
+                        ++numberOfMigratedRows;
+                    }
+                }
                 cost = SteadyClock::timeIntervalSinceSteadyClockToNow(beforeTransaction);
             } while (migrated.succeed() && !migrated.value()
                      && cost < timeIntervalWithinTransaction);
@@ -175,7 +188,7 @@ Optional<bool> MigrateHandle::migrateRows(const MigrationInfo* info)
         // update only if succeed
         double timeIntervalWholeTranscation
         = SteadyClock::timeIntervalSinceSteadyClockToNow(beforeTransaction);
-        addSample(timeIntervalWithinTransaction, timeIntervalWholeTranscation);
+        addSample(timeIntervalWithinTransaction, timeIntervalWholeTranscation, numberOfMigratedRows);
 
         WCTAssert(migrated.succeed());
         return migrated;
@@ -186,6 +199,7 @@ Optional<bool> MigrateHandle::migrateRows(const MigrationInfo* info)
 Optional<bool> MigrateHandle::migrateRow()
 {
     WCTAssert(m_migrateStatement->isPrepared() && m_removeMigratedStatement->isPrepared());
+    WCTAssert(!m_preparedForBatch);
     WCTAssert(isInTransaction());
     Optional<bool> migrated;
     m_migrateStatement->reset();
@@ -202,19 +216,102 @@ Optional<bool> MigrateHandle::migrateRow()
     return migrated;
 }
 
+Optional<bool> MigrateHandle::migrateBatch(int numberOfRows, int& numberOfMigratedRows)
+{
+    WCTAssert(m_migrateStatement->isPrepared() && m_removeMigratedStatement->isPrepared()
+              && m_selectRowIDRangeStatement->isPrepared());
+    WCTAssert(m_preparedForBatch);
+    WCTAssert(numberOfRows > 0);
+    WCTAssert(isInTransaction());
+    Optional<bool> migrated;
+    m_selectRowIDRangeStatement->reset();
+    m_selectRowIDRangeStatement->bindInteger(numberOfRows);
+    if (!m_selectRowIDRangeStatement->step()) {
+        return migrated;
+    }
+    // min(rowid) is null when source table is empty.
+    if (m_selectRowIDRangeStatement->done()
+        || m_selectRowIDRangeStatement->getType(0) == ColumnType::Null) {
+        migrated = true;
+        return migrated;
+    }
+    HandleStatement::Integer minRowID = m_selectRowIDRangeStatement->getInteger(0);
+    HandleStatement::Integer maxRowID = m_selectRowIDRangeStatement->getInteger(1);
+    m_selectRowIDRangeStatement->reset();
+
+    m_migrateStatement->reset();
+    m_migrateStatement->bindInteger(minRowID, 1);
+    m_migrateStatement->bindInteger(maxRowID, 2);
+    if (!m_migrateStatement->step()) {
+        return migrated;
+    }
+    m_removeMigratedStatement->reset();
+    m_removeMigratedStatement->bindInteger(minRowID, 1);
+    m_removeMigratedStatement->bindInteger(maxRowID, 2);
+    if (m_removeMigratedStatement->step()) {
+        numberOfMigratedRows += getChanges();
+        migrated = false;
+    }
+    return migrated;
+}
+
+void MigrateHandle::enableBatchMigration(bool enable)
+{
+    m_batchMigration = enable;
+}
+
+bool MigrateHandle::prepareMigrationStatement()
+{
+    WCTAssert(m_migratingInfo != nullptr);
+    if (m_preparedForBatch != m_batchMigration) {
+        finalizeMigrationStatement();
+    }
+    m_preparedForBatch = m_batchMigration;
+    if (m_preparedForBatch) {
+        if (!m_selectRowIDRangeStatement->isPrepared()
+            && !m_selectRowIDRangeStatement->prepare(
+            m_migratingInfo->getStatementForSelectingRowIDRangeOfBatch())) {
+            return false;
+        }
+        if (!m_migrateStatement->isPrepared()
+            && !m_migrateStatement->prepare(m_migratingInfo->getStatementForMigratingRowIDRange())) {
+            return false;
+        }
+        if (!m_removeMigratedStatement->isPrepared()
+            && !m_removeMigratedStatement->prepare(
+            m_migratingInfo->getStatementForDeletingMigratedRowIDRange())) {
+            return false;
+        }
+    } else {
+        if (!m_migrateStatement->isPrepared()
+            && !m_migrateStatement->prepare(m_migratingInfo->getStatementForMigratingOneRow())) {
+            return false;
+        }
+        if (!m_removeMigratedStatement->isPrepared()
+            && !m_removeMigratedStatement->prepare(
+            m_migratingInfo->getStatementForDeletingMigratedOneRow())) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void MigrateHandle::finalizeMigrationStatement()
 {
     m_migrateStatement->finalize();
     m_removeMigratedStatement->finalize();
+    m_selectRowIDRangeStatement->finalize();
 }
 
 #pragma mark - Sample
 MigrateHandle::Sample::Sample()
-: timeIntervalWithinTransaction(0), timeIntervalWholeTransaction(0)
+: timeIntervalWithinTransaction(0), timeIntervalWholeTransaction(0), numberOfMigratedRows(0)
 {
 }
 
-void MigrateHandle::addSample(double timeIntervalWithinTransaction, double timeIntervalForWholeTransaction)
+void MigrateHandle::addSample(double timeIntervalWithinTransaction,
+                              double timeIntervalForWholeTransaction,
+                              int numberOfMigratedRows)
 {
     WCTAssert(timeIntervalWithinTransaction > 0);
     WCTAssert(timeIntervalForWholeTransaction > 0);
@@ -224,6 +321,7 @@ void MigrateHandle::addSample(double timeIntervalWithinTransaction, double timeI
     Sample& sample = m_samples[m_samplePointing];
     sample.timeIntervalWithinTransaction = timeIntervalWithinTransaction;
     sample.timeIntervalWholeTransaction = timeIntervalForWholeTransaction;
+    sample.numberOfMigratedRows = numberOfMigratedRows;
     ++m_samplePointing;
     if (m_samplePointing >= numberOfSamples) {
         m_samplePointing = 0;
@@ -250,6 +348,32 @@ double MigrateHandle::calculateTimeIntervalWithinTransaction() const
     return timeIntervalWithinTransaction;
 }
 
+int MigrateHandle::calculateNumberOfRowsPerBatch(double timeIntervalWithinTransaction) const
+{
+    double totalTimeIntervalWithinTransaction = 0;
+    int totalNumberOfMigratedRows = 0;
+    for (const auto& sample : m_samples) {
+        if (sample.timeIntervalWithinTransaction > 0 && sample.numberOfMigratedRows > 0) {
+            totalTimeIntervalWithinTransaction += sample.timeIntervalWithinTransaction;
+            totalNumberOfMigratedRows += sample.numberOfMigratedRows;
+        }
+    }
+    if (totalNumberOfMigratedRows == 0 || totalTimeIntervalWithinTransaction <= 0) {
+        return MigrateInitialNumberOfRowsPerBatch;
+    }
+    // Each batch is expected to take half of the time within transaction,
+    // so that the transaction will not exceed its expectation too much when the rows are larger than before.
+    double numberOfRowsPerBatch = totalNumberOfMigratedRows / totalTimeIntervalWithinTransaction
+                                  * timeIntervalWithinTransaction / 2;
+    if (numberOfRowsPerBatch < 1) {
+        return 1;
+    }
+    if (numberOfRowsPerBatch > MigrateMaxNumberOfRowsPerBatch) {
+        return MigrateMaxNumberOfRowsPerBatch;
+    }
+    return (int) numberOfRowsPerBatch;
+}
+
 #pragma mark - Info Initializer
 Optional<bool> MigrateHandle::sourceTableExists(const MigrationUserInfo& userInfo)
 {
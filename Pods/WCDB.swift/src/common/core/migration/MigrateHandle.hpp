@@ -34,6 +34,7 @@ namespace WCDB {
 // However, it's very wasteful for those resources(CPU, IO...) when the step is too small.
 // So stepper will try to migrate one by one until the count of dirty pages(to be written) is changed.
 // In addition, stepper can/will be interrupted when database is not idled.
+// In batch mode, rows are migrated by contiguous rowid ranges, whose size is estimated from the samples.
 class MigrateHandle final : public InnerHandle, public Migration::Stepper {
 public:
     MigrateHandle();
@@ -54,19 +55,30 @@ protected:
     bool dropSourceTable(const MigrationInfo* info) override final;
     Optional<bool> migrateRows(const MigrationInfo* info) override final;
     Optional<bool> migrateRow();
+    Optional<bool> migrateBatch(int numberOfRows, int& numberOfMigratedRows);
 
     bool reAttachMigrationInfo(const MigrationInfo* info);
+    bool prepareMigrationStatement();
     void finalizeMigrationStatement();
 
+public:
+    void enableBatchMigration(bool enable);
+
 private:
     const MigrationInfo* m_migratingInfo;
     HandleStatement* m_migrateStatement;
     HandleStatement* m_removeMigratedStatement;
+    HandleStatement* m_selectRowIDRangeStatement;
+    bool m_batchMigration;
+    bool m_preparedForBatch;
 
 #pragma mark - Sample
 protected:
-    void addSample(double timeIntervalWithinTransaction, double timeIntervalForWholeTransaction);
+    void addSample(double timeIntervalWithinTransaction,
+                   double timeIntervalForWholeTransaction,
+                   int numberOfMigratedRows);
     double calculateTimeIntervalWithinTransaction() const;
+    int calculateNumberOfRowsPerBatch(double timeIntervalWithinTransaction) const;
 
 private:
     static constexpr const int numberOfSamples = 10;
@@ -74,6 +86,7 @@ private:
         Sample();
         double timeIntervalWithinTransaction;
         double timeIntervalWholeTransaction;
+        int numberOfMigratedRows;
     };
     typedef struct Sample Sample;
     std::array<Sample, numberOfSamples> m_samples; // FILO
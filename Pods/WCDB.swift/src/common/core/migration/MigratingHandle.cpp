@@ -424,7 +424,8 @@ void MigratingHandle::finalizeStatements()
 
 void MigratingHandle::returnAllPreparedStatement()
 {
-    Super::returnAllPreparedStatement();
+    // Statements prepared with the bound infos should not outlive the migrating.
+    finalizeAllPreparedStatement();
     if (!m_mainStatement->isPrepared()) {
         stopReferenced();
     }
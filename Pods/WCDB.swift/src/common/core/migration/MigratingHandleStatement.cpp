@@ -29,6 +29,8 @@
 #include "SQLite.h"
 #include "StringView.hpp"
 #include "WINQ.h"
+#include <algorithm>
+#include <limits>
 
 namespace WCDB {
 MigratingHandleStatement::MigratingHandleStatement(MigratingHandleStatement&& other)
@@ -38,12 +40,17 @@ MigratingHandleStatement::MigratingHandleStatement(MigratingHandleStatement&& ot
 , m_migrateStatement(other.m_migrateStatement)
 , m_removeMigratedStatement(other.m_removeMigratedStatement)
 , m_rowidIndexOfMigratingStatement(other.m_rowidIndexOfMigratingStatement)
+, m_migrateInBatch(other.m_migrateInBatch)
+, m_sourceSchema(std::move(other.m_sourceSchema))
+, m_sourceTable(std::move(other.m_sourceTable))
+, m_insertedRowIDs(std::move(other.m_insertedRowIDs))
 {
     other.m_processing = false;
     other.m_additionalStatement = nullptr;
     other.m_migrateStatement = nullptr;
     other.m_removeMigratedStatement = nullptr;
     other.m_rowidIndexOfMigratingStatement = 0;
+    other.m_migrateInBatch = false;
 }
 
 MigratingHandleStatement::MigratingHandleStatement(MigratingHandle* handle)
@@ -53,6 +60,7 @@ MigratingHandleStatement::MigratingHandleStatement(MigratingHandle* handle)
 , m_migrateStatement(std::make_shared<HandleStatement>(handle))
 , m_removeMigratedStatement(std::make_shared<HandleStatement>(handle))
 , m_rowidIndexOfMigratingStatement(0)
+, m_migrateInBatch(false)
 {
     m_additionalStatement->enableAutoAddColumn();
     m_migrateStatement->enableAutoAddColumn();
@@ -156,16 +164,21 @@ Optional<std::list<Statement>> MigratingHandleStatement::process(const Statement
                               "Insert statement that does not explicitly indicate columns is not supported while using migration feature.",
                               succeed = false;
                               break;);
-            WCTRemedialAssert(!migratedInsertSTMT.isMultiWrite(),
-                              "Insert statement that contains multiple values is not supported while using migration feature.",
-                              succeed = false;
-                              break;);
             if (!migratedInsertSTMT.isTargetingSameTable(falledBackSTMT)) {
                 // it's safe to use origin statement since Conflict Action will not be changed during tampering.
                 succeed = prepareMigrate(migratedInsertSTMT, falledBackSTMT);
                 sqlite3_revertCommitOrder(getRawHandle());
             }
         } break;
+        case Syntax::Identifier::Type::SelectSTMT: {
+            const MigrationInfo* info = getInfoForPushingDown(originStatement);
+            if (info != nullptr) {
+                statements.push_back(info->getStatementForPushingDownSelection(
+                static_cast<const Syntax::SelectSTMT&>(originStatement.syntax())));
+            } else {
+                statements.push_back(falledBackStatement);
+            }
+        } break;
         case Syntax::Identifier::Type::UpdateSTMT: {
             const Syntax::QualifiedTableName& migratedTable
             = static_cast<const Syntax::UpdateSTMT&>(originStatement.syntax()).table;
@@ -291,6 +304,132 @@ bool MigratingHandleStatement::tryFallbackToSourceTable(Syntax::Schema& schema,
     return true;
 }
 
+const MigrationInfo* MigratingHandleStatement::getInfoForPushingDown(const Statement& select)
+{
+    WCTAssert(select.getType() == Syntax::Identifier::Type::SelectSTMT);
+    const Syntax::SelectSTMT& selectSTMT
+    = static_cast<const Syntax::SelectSTMT&>(select.syntax());
+    // Only the selection from a single migrating table without aggregation is pushed down.
+    if (!selectSTMT.commonTableExpressions.empty() || !selectSTMT.cores.empty()
+        || !WCDB_SYNTAX_CHECK_OPTIONAL_VALID(selectSTMT.select)) {
+        return nullptr;
+    }
+    const Syntax::SelectCore& core = selectSTMT.select.value();
+    if (core.switcher != Syntax::SelectCore::Switch::Select || core.distinct
+        || core.tableOrSubqueries.size() != 1
+        || WCDB_SYNTAX_CHECK_OPTIONAL_VALID(core.joinClause) || !core.groups.empty()
+        || WCDB_SYNTAX_CHECK_OPTIONAL_VALID(core.having) || !core.windows.empty()
+        || !core.windowDefs.empty()) {
+        return nullptr;
+    }
+    const Syntax::TableOrSubquery& table = core.tableOrSubqueries.front();
+    if (table.switcher != Syntax::TableOrSubquery::Switch::Table || !table.schema.isMain()) {
+        return nullptr;
+    }
+    MigratingHandle* migratingHandle = dynamic_cast<MigratingHandle*>(getHandle());
+    WCTAssert(migratingHandle != nullptr);
+    const MigrationInfo* info = migratingHandle->getBoundInfo(table.tableOrFunction);
+    if (info == nullptr) {
+        return nullptr;
+    }
+
+    // The terms of compound ordering can only refer to the result columns.
+    for (const auto& orderingTerm : selectSTMT.orderingTerms) {
+        if (!WCDB_SYNTAX_CHECK_OPTIONAL_VALID(orderingTerm.expression)) {
+            return nullptr;
+        }
+        const Syntax::Expression& expression = orderingTerm.expression.value();
+        if (expression.switcher != Syntax::Expression::Switch::Column) {
+            return nullptr;
+        }
+        const StringView& name = expression.column().name;
+        auto iter = std::find_if(
+        core.resultColumns.begin(),
+        core.resultColumns.end(),
+        [&name](const Syntax::ResultColumn& resultColumn) {
+            if (resultColumn.alias.caseInsensitiveEqual(name)) {
+                return true;
+            }
+            if (!resultColumn.alias.empty()
+                || !WCDB_SYNTAX_CHECK_OPTIONAL_VALID(resultColumn.expression)) {
+                return false;
+            }
+            const Syntax::Expression& resultExpression = resultColumn.expression.value();
+            return resultExpression.switcher == Syntax::Expression::Switch::Column
+                   && resultExpression.column().name.caseInsensitiveEqual(name);
+        });
+        if (iter == core.resultColumns.end()) {
+            return nullptr;
+        }
+    }
+
+    Statement copied = select;
+    Syntax::SelectSTMT& copiedSTMT = static_cast<Syntax::SelectSTMT&>(copied.syntax());
+    bool pushDownable = true;
+    int numberOfSelections = 0;
+    // Subqueries, wildcards and the columns with schema may not be valid for the source table.
+    copied.iterate([&pushDownable, &numberOfSelections](Syntax::Identifier& identifier,
+                                                        bool& stop) {
+        switch (identifier.getType()) {
+        case Syntax::Identifier::Type::SelectSTMT:
+            pushDownable = ++numberOfSelections == 1;
+            break;
+        case Syntax::Identifier::Type::JoinClause:
+        case Syntax::Identifier::Type::RaiseFunction:
+        case Syntax::Identifier::Type::WindowDef:
+            pushDownable = false;
+            break;
+        case Syntax::Identifier::Type::Column: {
+            Syntax::Column& column = (Syntax::Column&) identifier;
+            pushDownable = !column.wildcard && column.schema.empty();
+        } break;
+        case Syntax::Identifier::Type::Expression: {
+            Syntax::Expression& expression = (Syntax::Expression&) identifier;
+            switch (expression.switcher) {
+            case Syntax::Expression::Switch::Exists:
+            case Syntax::Expression::Switch::Select:
+            case Syntax::Expression::Switch::Window:
+                pushDownable = false;
+                break;
+            case Syntax::Expression::Switch::In:
+                pushDownable = expression.inSwitcher == Syntax::Expression::SwitchIn::Empty
+                               || expression.inSwitcher
+                                  == Syntax::Expression::SwitchIn::Expressions;
+                break;
+            default:
+                break;
+            }
+        } break;
+        default:
+            break;
+        }
+        if (!pushDownable) {
+            stop = true;
+        }
+    });
+    if (!pushDownable) {
+        return nullptr;
+    }
+    // Aggregate functions can't be detected since they might be customized.
+    for (auto& resultColumn : copiedSTMT.select.value().resultColumns) {
+        bool stop = false;
+        resultColumn.iterate(
+        [&pushDownable](Syntax::Identifier& identifier, bool& stop) {
+            if (identifier.getType() == Syntax::Identifier::Type::Expression
+                && static_cast<Syntax::Expression&>(identifier).switcher
+                   == Syntax::Expression::Switch::Function) {
+                pushDownable = false;
+                stop = true;
+            }
+        },
+        stop);
+        if (!pushDownable) {
+            return nullptr;
+        }
+    }
+    return info;
+}
+
 #pragma mark - Override
 bool MigratingHandleStatement::prepare(const Statement& statement)
 {
@@ -333,9 +472,16 @@ bool MigratingHandleStatement::step()
 bool MigratingHandleStatement::realStep()
 {
     WCTAssert(!(m_additionalStatement->isPrepared() && isMigratedPrepared()));
-    return Super::step()
-           && (!m_additionalStatement->isPrepared() || m_additionalStatement->step())
-           && (!isMigratedPrepared() || stepMigration(getHandle()->getLastInsertedRowID()));
+    if (!isMigratedPrepared() || !m_migrateInBatch) {
+        return Super::step()
+               && (!m_additionalStatement->isPrepared() || m_additionalStatement->step())
+               && (!isMigratedPrepared()
+                   || stepMigration(getHandle()->getLastInsertedRowID()));
+    }
+    startCollectingInsertedRowIDs();
+    bool succeed = Super::step();
+    stopCollectingInsertedRowIDs();
+    return succeed && stepMigrationOfInsertedRows();
 }
 
 void MigratingHandleStatement::reset()
@@ -356,7 +502,7 @@ void MigratingHandleStatement::bindInteger(const Integer& value, int index)
     if (m_additionalStatement->isPrepared()) {
         m_additionalStatement->bindInteger(value, index);
     }
-    if (m_migrateStatement->isPrepared()) {
+    if (m_migrateStatement->isPrepared() && !m_migrateInBatch) {
         WCTRemedialAssert(m_rowidIndexOfMigratingStatement == 0 || index != m_rowidIndexOfMigratingStatement,
                           "Binding index is out of range",
                           return;);
@@ -370,7 +516,7 @@ void MigratingHandleStatement::bindDouble(const Float& value, int index)
     if (m_additionalStatement->isPrepared()) {
         m_additionalStatement->bindDouble(value, index);
     }
-    if (m_migrateStatement->isPrepared()) {
+    if (m_migrateStatement->isPrepared() && !m_migrateInBatch) {
         WCTRemedialAssert(m_rowidIndexOfMigratingStatement == 0 || index != m_rowidIndexOfMigratingStatement,
                           "Binding index is out of range",
                           return;);
@@ -384,7 +530,7 @@ void MigratingHandleStatement::bindText(const Text& value, int index)
     if (m_additionalStatement->isPrepared()) {
         m_additionalStatement->bindText(value, index);
     }
-    if (m_migrateStatement->isPrepared()) {
+    if (m_migrateStatement->isPrepared() && !m_migrateInBatch) {
         WCTRemedialAssert(m_rowidIndexOfMigratingStatement == 0 || index != m_rowidIndexOfMigratingStatement,
                           "Binding index is out of range",
                           return;);
@@ -398,7 +544,7 @@ void MigratingHandleStatement::bindBLOB(const BLOB& value, int index)
     if (m_additionalStatement->isPrepared()) {
         m_additionalStatement->bindBLOB(value, index);
     }
-    if (m_migrateStatement->isPrepared()) {
+    if (m_migrateStatement->isPrepared() && !m_migrateInBatch) {
         WCTRemedialAssert(m_rowidIndexOfMigratingStatement == 0 || index != m_rowidIndexOfMigratingStatement,
                           "Binding index is out of range",
                           return;);
@@ -412,7 +558,7 @@ void MigratingHandleStatement::bindNull(int index)
     if (m_additionalStatement->isPrepared()) {
         m_additionalStatement->bindNull(index);
     }
-    if (m_migrateStatement->isPrepared()) {
+    if (m_migrateStatement->isPrepared() && !m_migrateInBatch) {
         WCTRemedialAssert(m_rowidIndexOfMigratingStatement == 0 || index != m_rowidIndexOfMigratingStatement,
                           "Binding index is out of range",
                           return;);
@@ -429,7 +575,7 @@ void MigratingHandleStatement::bindPointer(void* ptr,
     if (m_additionalStatement->isPrepared()) {
         m_additionalStatement->bindPointer(ptr, index, type, destructor);
     }
-    if (m_migrateStatement->isPrepared()) {
+    if (m_migrateStatement->isPrepared() && !m_migrateInBatch) {
         WCTRemedialAssert(m_rowidIndexOfMigratingStatement == 0 || index != m_rowidIndexOfMigratingStatement,
                           "Binding index is out of range",
                           return;);
@@ -481,6 +627,8 @@ void MigratingHandleStatement::finalizeMigrate()
     if (m_migrateStatement != nullptr) {
         m_migrateStatement->finalize();
     }
+    m_migrateInBatch = false;
+    m_insertedRowIDs.clear();
 }
 
 void MigratingHandleStatement::resetMigrate()
@@ -488,6 +636,7 @@ void MigratingHandleStatement::resetMigrate()
     WCTAssert(isMigratedPrepared());
     m_removeMigratedStatement->reset();
     m_migrateStatement->reset();
+    m_insertedRowIDs.clear();
 }
 
 bool MigratingHandleStatement::prepareMigrate(const Syntax::InsertSTMT& migrated,
@@ -498,9 +647,73 @@ bool MigratingHandleStatement::prepareMigrate(const Syntax::InsertSTMT& migrated
     WCTAssert(migratingHandle != nullptr);
     const MigrationInfo* info = migratingHandle->getBoundInfo(migrated.table);
     WCTAssert(info != nullptr);
+    if (migrated.isMultiWrite()) {
+        // The rows are inserted into source table first and then moved to the migrated table range by range.
+        m_migrateInBatch = true;
+        m_rowidIndexOfMigratingStatement = 0;
+        m_sourceSchema = info->getSchemaForSourceDatabase().getDescription();
+        m_sourceTable = info->getSourceTable();
+        return m_removeMigratedStatement->prepare(info->getStatementForDeletingMigratedRowIDRange())
+               && m_migrateStatement->prepare(
+               info->getStatementForMigratingInsertedRowIDRange(migrated));
+    }
     m_rowidIndexOfMigratingStatement = info->getRowIDIndexOfMigratingStatement();
     return m_removeMigratedStatement->prepare(info->getStatementForDeletingSpecifiedRow())
            && m_migrateStatement->prepare(info->getStatementForMigrating(falledBack));
 }
 
+void MigratingHandleStatement::startCollectingInsertedRowIDs()
+{
+    WCTAssert(m_migrateInBatch);
+    m_insertedRowIDs.clear();
+    sqlite3_update_hook(getRawHandle(), MigratingHandleStatement::collectInsertedRowID, this);
+}
+
+void MigratingHandleStatement::stopCollectingInsertedRowIDs()
+{
+    sqlite3_update_hook(getRawHandle(), nullptr, nullptr);
+}
+
+void MigratingHandleStatement::collectInsertedRowID(
+void* parameter, int operation, const char* schema, const char* table, long long rowid)
+{
+    MigratingHandleStatement* statement
+    = reinterpret_cast<MigratingHandleStatement*>(parameter);
+    WCTAssert(statement != nullptr);
+    // The rows inserted into other tables by triggers are ignored.
+    if (operation == SQLITE_INSERT && statement->m_sourceTable.caseInsensitiveEqual(table)
+        && statement->m_sourceSchema.caseInsensitiveEqual(schema)) {
+        statement->m_insertedRowIDs.push_back(rowid);
+    }
+}
+
+bool MigratingHandleStatement::stepMigrationOfInsertedRows()
+{
+    WCTAssert(isMigratedPrepared());
+    auto& rowids = m_insertedRowIDs;
+    // The same rowid may be inserted more than once due to the conflict resolution of replace.
+    std::sort(rowids.begin(), rowids.end());
+    rowids.erase(std::unique(rowids.begin(), rowids.end()), rowids.end());
+    bool succeed = true;
+    auto begin = rowids.begin();
+    while (succeed && begin != rowids.end()) {
+        // Only the consecutive rowids are merged into a range so that the existing rows of source table are never touched.
+        auto last = begin;
+        while (std::next(last) != rowids.end() && *last < std::numeric_limits<int64_t>::max()
+               && *std::next(last) == *last + 1) {
+            ++last;
+        }
+        m_migrateStatement->bindInteger(*begin, 1);
+        m_migrateStatement->bindInteger(*last, 2);
+        m_removeMigratedStatement->bindInteger(*begin, 1);
+        m_removeMigratedStatement->bindInteger(*last, 2);
+        succeed = m_migrateStatement->step() && m_removeMigratedStatement->step();
+        m_migrateStatement->reset();
+        m_removeMigratedStatement->reset();
+        begin = std::next(last);
+    }
+    rowids.clear();
+    return succeed;
+}
+
 } //namespace WCDB
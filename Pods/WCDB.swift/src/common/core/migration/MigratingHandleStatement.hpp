@@ -25,10 +25,12 @@
 #pragma once
 
 #include "HandleStatement.hpp"
+#include <vector>
 
 namespace WCDB {
 
 class MigratingHandle;
+class MigrationInfo;
 
 class MigratingHandleStatement final : public HandleStatement {
     friend class MigratingHandle;
@@ -86,6 +88,7 @@ protected:
     Optional<std::list<Statement>> process(const Statement &statement);
     bool tryFallbackToUnionedView(Syntax::Schema &schema, StringView &table);
     bool tryFallbackToSourceTable(Syntax::Schema &schema, StringView &table);
+    const MigrationInfo *getInfoForPushingDown(const Statement &select);
     bool m_processing;
     std::shared_ptr<HandleStatement> m_additionalStatement;
 
@@ -102,10 +105,21 @@ protected:
     void finalizeMigrate();
     void resetMigrate();
 
+    // For Multi-Row Insert Statement Only
+    void startCollectingInsertedRowIDs();
+    void stopCollectingInsertedRowIDs();
+    static void collectInsertedRowID(
+    void *parameter, int operation, const char *schema, const char *table, long long rowid);
+    bool stepMigrationOfInsertedRows();
+
 private:
     std::shared_ptr<HandleStatement> m_migrateStatement;
     std::shared_ptr<HandleStatement> m_removeMigratedStatement;
     int m_rowidIndexOfMigratingStatement;
+    bool m_migrateInBatch;
+    StringView m_sourceSchema;
+    StringView m_sourceTable;
+    std::vector<int64_t> m_insertedRowIDs;
 };
 
 } //namespace WCDB
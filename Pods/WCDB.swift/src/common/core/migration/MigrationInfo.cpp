@@ -183,6 +183,29 @@ MigrationInfo::MigrationInfo(const MigrationUserInfo& userInfo,
                                                .deleteFrom(qualifiedSourceTable)
                                                .orders(descendingRowid)
                                                .limit(1);
+
+        m_statementForSelectingRowIDRangeOfBatch
+        = StatementSelect()
+          .select({ rowid.min(), rowid.max() })
+          .from(StatementSelect()
+                .select(rowid)
+                .from(sourceTableQuery)
+                .order(descendingRowid)
+                .limit(BindParameter(1)));
+
+        Expression rowidInRange = rowid.between(BindParameter(1), BindParameter(2));
+
+        m_statementForMigratingRowIDRange = StatementInsert()
+                                            .insertIntoTable(getTable())
+                                            .orReplace()
+                                            .columns(columns)
+                                            .values(StatementSelect()
+                                                    .select(resultColumns)
+                                                    .from(sourceTableQuery)
+                                                    .where(rowidInRange));
+
+        m_statementForDeletingMigratedRowIDRange
+        = StatementDelete().deleteFrom(qualifiedSourceTable).where(rowidInRange);
     }
 
     // Compatible
@@ -197,6 +220,25 @@ MigrationInfo::MigrationInfo(const MigrationUserInfo& userInfo,
         m_statementForDeletingSpecifiedRow
         = StatementDelete().deleteFrom(qualifiedSourceTable).where(rowid == BindParameter(1));
 
+        ResultColumns insertedResultColumns;
+        if (m_integerPrimaryKey) {
+            insertedResultColumns.push_back(rowid);
+        } else {
+            // Keep the order of inserted rows while making their rowids larger than all the existing ones.
+            insertedResultColumns.push_back(rowid - BindParameter(1)
+                                            + m_statementForSelectingMaxRowID);
+        }
+        insertedResultColumns.insert(
+        insertedResultColumns.end(), std::next(columns.begin()), columns.end());
+        m_statementForMigratingInsertedRowIDRange
+        = StatementInsert()
+          .insertIntoTable(getTable())
+          .columns(columns)
+          .values(StatementSelect()
+                  .select(insertedResultColumns)
+                  .from(sourceTableQuery)
+                  .where(rowid.between(BindParameter(1), BindParameter(2))));
+
         m_statementForDroppingSourceTable = StatementDropTable()
                                             .dropTable(getSourceTable())
                                             .schema(m_schemaForSourceDatabase)
@@ -290,6 +332,21 @@ const StatementDelete& MigrationInfo::getStatementForDeletingMigratedOneRow() co
     return m_statementForDeletingMigratedOneRow;
 }
 
+const StatementSelect& MigrationInfo::getStatementForSelectingRowIDRangeOfBatch() const
+{
+    return m_statementForSelectingRowIDRangeOfBatch;
+}
+
+const StatementInsert& MigrationInfo::getStatementForMigratingRowIDRange() const
+{
+    return m_statementForMigratingRowIDRange;
+}
+
+const StatementDelete& MigrationInfo::getStatementForDeletingMigratedRowIDRange() const
+{
+    return m_statementForDeletingMigratedRowIDRange;
+}
+
 const StatementDelete& MigrationInfo::getStatementForDeletingSpecifiedRow() const
 {
     return m_statementForDeletingSpecifiedRow;
@@ -324,6 +381,25 @@ StatementInsert MigrationInfo::getStatementForMigrating(const Syntax::InsertSTMT
     return statement;
 }
 
+StatementInsert
+MigrationInfo::getStatementForMigratingInsertedRowIDRange(const Syntax::InsertSTMT& stmt) const
+{
+    // Conflict action and upsert clause are kept.
+    StatementInsert statement(stmt);
+
+    auto& syntax = statement.syntax();
+    const auto& rangeSyntax = m_statementForMigratingInsertedRowIDRange.syntax();
+    syntax.recursive = false;
+    syntax.commonTableExpressions.clear();
+    syntax.schema = Schema::main();
+    syntax.table = getTable();
+    syntax.columns = rangeSyntax.columns;
+    syntax.switcher = Syntax::InsertSTMT::Switch::Select;
+    syntax.expressionsValues.clear();
+    syntax.select = rangeSyntax.select;
+    return statement;
+}
+
 int MigrationInfo::getRowIDIndexOfMigratingStatement() const
 {
     if (m_integerPrimaryKey) {
@@ -407,6 +483,33 @@ MigrationInfo::getStatementForDeletingFromTable(const Statement& sourceStatement
     return StatementDelete().deleteFrom(table);
 }
 
+StatementSelect
+MigrationInfo::getStatementForPushingDownSelection(const Syntax::SelectSTMT& selectSTMT) const
+{
+    WCTAssert(selectSTMT.cores.empty() && selectSTMT.commonTableExpressions.empty());
+    StatementSelect statement(selectSTMT);
+
+    Syntax::SelectSTMT& syntax = statement.syntax();
+    Syntax::SelectCore core = syntax.select.getOrCreate();
+    WCTAssert(core.tableOrSubqueries.size() == 1);
+    Syntax::TableOrSubquery& table = core.tableOrSubqueries.front();
+    WCTAssert(table.tableOrFunction.caseInsensitiveEqual(getTable()));
+    // The columns referring to migrated table are still valid.
+    if (table.alias.empty()) {
+        table.alias = table.tableOrFunction;
+    }
+    table.schema = m_schemaForSourceDatabase;
+    table.tableOrFunction = getSourceTable();
+    // The index of migrated table does not exist in source table.
+    if (table.indexType == Syntax::TableOrSubquery::IndexType::Indexed) {
+        table.indexType = Syntax::TableOrSubquery::IndexType::NotSet;
+        table.index.clear();
+    }
+    syntax.cores.push_back(std::move(core));
+    syntax.compoundOperators.push_back(Syntax::CompoundOperator::UnionAll);
+    return statement;
+}
+
 const StatementDropTable& MigrationInfo::getStatementForDroppingSourceTable() const
 {
     return m_statementForDroppingSourceTable;
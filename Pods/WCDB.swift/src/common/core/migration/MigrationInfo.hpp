@@ -170,6 +170,19 @@ public:
 
     int getRowIDIndexOfMigratingStatement() const;
 
+    /*
+     INSERT INTO main.[table](rowid, [columns])
+     SELECT newRowid, [columns]
+     FROM [schemaForSourceDatabase].[sourceTable]
+     WHERE rowid BETWEEN ?1 AND ?2
+     
+     Note that conflict action and upsert clause are the same as the origin one, and newRowid is
+     1. rowid in source table when it's an integer primary key table
+     2. rowid - ?1 + (SELECT max(rowid)+1 FROM temp.[unionedView]) when the table does not contain an integer primary key
+     */
+    StatementInsert
+    getStatementForMigratingInsertedRowIDRange(const Syntax::InsertSTMT& stmt) const;
+
     /*
      UPDATE ...
      SET ...
@@ -191,9 +204,21 @@ public:
 
     StatementDelete getStatementForDeletingFromTable(const Statement& sourceStatement) const;
 
+    /*
+     SELECT ... FROM main.[table] WHERE ...
+     UNION ALL
+     SELECT ... FROM [schemaForSourceDatabase].[sourceTable] AS [table] WHERE ...
+     ORDER BY ... LIMIT ... OFFSET ...
+
+     Note that it's a replacement of selecting from unioned view, so that the indexes of both tables can be used and the ordered results are merged.
+     */
+    StatementSelect
+    getStatementForPushingDownSelection(const Syntax::SelectSTMT& selectSTMT) const;
+
 protected:
     StatementDelete m_statementForDeletingSpecifiedRow;
     StatementSelect m_statementForSelectingMaxRowID;
+    StatementInsert m_statementForMigratingInsertedRowIDRange;
 
 #pragma mark - Migrate
 public:
@@ -214,6 +239,31 @@ public:
      */
     const StatementDelete& getStatementForDeletingMigratedOneRow() const;
 
+    /*
+     SELECT min(rowid), max(rowid)
+     FROM (
+        SELECT rowid
+        FROM [schemaForSourceDatabase].[sourceTable]
+        ORDER BY rowid DESC
+        LIMIT ?1
+     )
+     */
+    const StatementSelect& getStatementForSelectingRowIDRangeOfBatch() const;
+
+    /*
+     INSERT OR REPLACE INTO main.[table](rowid, [columns])
+     SELECT rowid, [columns]
+     FROM [schemaForSourceDatabase].[sourceTable]
+     WHERE rowid BETWEEN ?1 AND ?2
+     */
+    const StatementInsert& getStatementForMigratingRowIDRange() const;
+
+    /*
+     DELETE FROM [schemaForSourceDatabase].[sourceTable]
+     WHERE rowid BETWEEN ?1 AND ?2
+     */
+    const StatementDelete& getStatementForDeletingMigratedRowIDRange() const;
+
     /*
      DROP TABLE IF EXISTS [schemaForSourceDatabase].[sourceTable]
      */
@@ -222,6 +272,9 @@ public:
 protected:
     StatementInsert m_statementForMigratingOneRow;
     StatementDelete m_statementForDeletingMigratedOneRow;
+    StatementSelect m_statementForSelectingRowIDRangeOfBatch;
+    StatementInsert m_statementForMigratingRowIDRange;
+    StatementDelete m_statementForDeletingMigratedRowIDRange;
     StatementDropTable m_statementForDroppingSourceTable;
 };
 
@@ -32,8 +32,11 @@
 namespace WCDB {
 
 OperationHandle::OperationHandle()
-: m_statementForIntegrityCheck(
-StatementPragma().pragma(Pragma::integrityCheck()).schema(Schema::main()).with(1))
+: m_statementForGetTables(
+StatementSelect()
+.select(Column("name"))
+.from(Syntax::masterTable)
+.where(Column("type") == "table" && Column("rootpage") > 0))
 , m_statementForReadTransaction(StatementBegin().beginDeferred())
 , m_statementForAcquireReadLock(
   StatementSelect().select(1).from(Syntax::masterTable).limit(0))
@@ -54,44 +57,162 @@ void OperationHandle::doSuspend(bool suspend)
 }
 
 #pragma mark - Integrity
-void OperationHandle::checkIntegrity()
-{
-    auto optionalIntegrityMessages = getValues(m_statementForIntegrityCheck, 0);
-    bool needCheckFTS = true;
-    if (optionalIntegrityMessages.succeed()) {
-        auto &integrityMessages = optionalIntegrityMessages.value();
-        WCTAssert(integrityMessages.size() == 1);
-        if (integrityMessages.size() > 0) {
-            auto integrityMessage = *integrityMessages.begin();
-            if (!integrityMessage.caseInsensitiveEqual("ok")) {
-                Error error(Error::Code::Corrupt, Error::Level::Error, integrityMessage);
-                error.infos.insert_or_assign(ErrorStringKeyPath, getPath());
-                error.infos.insert_or_assign(ErrorStringKeyType, ErrorTypeIntegrity);
-                Notifier::shared().notify(error);
-                needCheckFTS = false;
-            }
+OperationHandle::IntegrityCursor::IntegrityCursor() : started(false), numberOfTables(0)
+{
+}
+
+double OperationHandle::IntegrityCursor::getProgress() const
+{
+    if (!started || numberOfTables == 0) {
+        return 0;
+    }
+    int numberOfRemainingTables = (int) (tables.size() + ftsTables.size());
+    return (double) (numberOfTables - numberOfRemainingTables) / numberOfTables;
+}
+
+void OperationHandle::IntegrityCursor::reset()
+{
+    started = false;
+    tables.clear();
+    ftsTables.clear();
+    numberOfTables = 0;
+}
+
+Optional<bool> OperationHandle::checkIntegrity(IntegrityCursor &cursor)
+{
+    if (!cursor.started && !startIntegrityCheck(cursor)) {
+        return NullOpt;
+    }
+    WCTAssert(cursor.started);
+
+    SteadyClock beforeSlice = SteadyClock::now();
+    double cost = 0;
+    while (!cursor.tables.empty() || !cursor.ftsTables.empty()) {
+        bool fts = cursor.tables.empty();
+        std::list<StringView> &tables = fts ? cursor.ftsTables : cursor.tables;
+        const StringView &table = tables.front();
+
+        // Leave the table to the next slice if it's expected to exceed the remaining time.
+        auto iter = cursor.costs.find(table);
+        if (cost > 0 && iter != cursor.costs.end()
+            && cost + iter->second > IntegrityCheckMaxExpectingDuration) {
+            return false;
+        }
+
+        SteadyClock beforeTable = SteadyClock::now();
+        Optional<bool> corrupted
+        = fts ? checkIntegrityOfFTSTable(table) : checkIntegrityOfTable(table);
+        if (!corrupted.succeed()) {
+            return NullOpt;
+        }
+        cursor.costs[table] = SteadyClock::timeIntervalSinceSteadyClockToNow(beforeTable);
+        tables.pop_front();
+        if (corrupted.value()) {
+            cursor.reset();
+            return true;
+        }
+
+        cost = SteadyClock::timeIntervalSinceSteadyClockToNow(beforeSlice);
+        if (cost >= IntegrityCheckMaxExpectingDuration) {
+            break;
         }
     }
-    if (!needCheckFTS) {
-        return;
+    if (!cursor.tables.empty() || !cursor.ftsTables.empty()) {
+        return false;
+    }
+    cursor.reset();
+    return true;
+}
+
+Optional<bool> OperationHandle::checkIntegrityOfDatabase()
+{
+    Optional<bool> corrupted = checkIntegrityOfTable(StringView());
+    if (!corrupted.succeed() || corrupted.value()) {
+        return corrupted;
     }
-    Optional<std::set<StringView>> ftsTableSet = getValues(m_statementForGetFTSTable, 0);
-    if (!ftsTableSet.succeed()) {
-        return;
+    Optional<std::set<StringView>> ftsTables = getValues(m_statementForGetFTSTable, 0);
+    if (!ftsTables.succeed()) {
+        return NullOpt;
     }
-    for (const StringView &ftsTable : ftsTableSet.value()) {
-        if (executeStatement(
-            StatementInsert().insertIntoTable(ftsTable).column(Column(ftsTable)).value("integrity-check"))) {
-            continue;
+    for (const StringView &ftsTable : ftsTables.value()) {
+        corrupted = checkIntegrityOfFTSTable(ftsTable);
+        if (!corrupted.succeed() || corrupted.value()) {
+            return corrupted;
         }
-        if (Error::rc2ec((int) m_error.getExtCode()) == Error::ExtCode::CorruptVirtualTable) {
-            Error error(Error::Code::Corrupt, Error::Level::Error, m_error.getMessage());
-            error.infos.insert_or_assign(ErrorStringKeyPath, getPath());
-            error.infos.insert_or_assign(ErrorStringKeyType, ErrorTypeIntegrity);
-            Notifier::shared().notify(error);
-            break;
+    }
+    return false;
+}
+
+bool OperationHandle::startIntegrityCheck(IntegrityCursor &cursor)
+{
+    WCTAssert(!cursor.started);
+    Optional<std::set<StringView>> tables = getValues(m_statementForGetTables, 0);
+    if (!tables.succeed()) {
+        return false;
+    }
+    Optional<std::set<StringView>> ftsTables = getValues(m_statementForGetFTSTable, 0);
+    if (!ftsTables.succeed()) {
+        return false;
+    }
+    // The freelist is checked along with the master table.
+    cursor.tables.push_back(Syntax::masterTable);
+    cursor.tables.insert(cursor.tables.end(), tables.value().begin(), tables.value().end());
+    cursor.ftsTables.assign(ftsTables.value().begin(), ftsTables.value().end());
+    cursor.numberOfTables = (int) (cursor.tables.size() + cursor.ftsTables.size());
+    cursor.started = true;
+    return true;
+}
+
+Optional<bool> OperationHandle::checkIntegrityOfTable(const UnsafeStringView &table)
+{
+    StatementPragma statement
+    = StatementPragma().pragma(Pragma::integrityCheck()).schema(Schema::main());
+    if (table.empty()) {
+        statement.with(1);
+    } else {
+        statement.with(table);
+    }
+    auto optionalIntegrityMessages = getValues(statement, 0);
+    if (!optionalIntegrityMessages.succeed()) {
+        if (m_error.isCorruption()) {
+            notifyCorruption(m_error.getMessage());
+            return true;
+        }
+        if (!table.empty() && m_error.code() == Error::Code::Error) {
+            // The table is dropped after the check is started.
+            return false;
+        }
+        return NullOpt;
+    }
+    for (const StringView &integrityMessage : optionalIntegrityMessages.value()) {
+        if (!integrityMessage.caseInsensitiveEqual("ok")) {
+            notifyCorruption(integrityMessage);
+            return true;
         }
     }
+    return false;
+}
+
+Optional<bool> OperationHandle::checkIntegrityOfFTSTable(const UnsafeStringView &table)
+{
+    if (executeStatement(
+        StatementInsert().insertIntoTable(table).column(Column(table)).value("integrity-check"))) {
+        return false;
+    }
+    if (Error::rc2ec((int) m_error.getExtCode()) == Error::ExtCode::CorruptVirtualTable) {
+        notifyCorruption(m_error.getMessage());
+        return true;
+    }
+    // Other errors are ignored as before.
+    return false;
+}
+
+void OperationHandle::notifyCorruption(const UnsafeStringView &message)
+{
+    Error error(Error::Code::Corrupt, Error::Level::Error, message);
+    error.infos.insert_or_assign(ErrorStringKeyPath, getPath());
+    error.infos.insert_or_assign(ErrorStringKeyType, ErrorTypeIntegrity);
+    Notifier::shared().notify(error);
 }
 
 #pragma mark - Backup
@@ -27,6 +27,7 @@
 #include "CoreConst.h"
 #include "InnerHandle.hpp"
 #include "RepairKit.h"
+#include <list>
 
 namespace WCDB {
 
@@ -42,10 +43,38 @@ protected:
 
 #pragma mark - Integrity
 public:
-    void checkIntegrity();
+    // The tables are checked one by one, each within a read transaction of its own,
+    // so that the wal will not be pinned for the whole check of a large database.
+    // The cursor is kept by the caller so that the check can be resumed by another handle.
+    // Note that the pages are only cross-checked within a table, so the sliced check does NOT detect
+    // the pages that are never used or referenced by two tables. checkIntegrityOfDatabase does.
+    struct IntegrityCursor {
+        IntegrityCursor();
+        bool started;
+        std::list<StringView> tables;
+        std::list<StringView> ftsTables;
+        int numberOfTables;
+        // cost of each table in the last check, which is used to plan the slices
+        StringViewMap<double> costs;
+
+        double getProgress() const;
+        void reset();
+    };
+    typedef struct IntegrityCursor IntegrityCursor;
+
+    // It returns true if the whole database is checked or the corruption is found.
+    Optional<bool> checkIntegrity(IntegrityCursor &cursor);
+    // Check the whole database at once. It returns true if the corruption is found.
+    Optional<bool> checkIntegrityOfDatabase();
 
 protected:
-    StatementPragma m_statementForIntegrityCheck;
+    bool startIntegrityCheck(IntegrityCursor &cursor);
+    // It returns true if the corruption is found. Empty table means all of the tables.
+    Optional<bool> checkIntegrityOfTable(const UnsafeStringView &table);
+    Optional<bool> checkIntegrityOfFTSTable(const UnsafeStringView &table);
+    void notifyCorruption(const UnsafeStringView &message);
+
+    StatementSelect m_statementForGetTables;
 
 #pragma mark - Backup
 public:
@@ -30,7 +30,9 @@
 #include "FileManager.hpp"
 #include "Global.hpp"
 #include "Notifier.hpp"
+#include <algorithm>
 #include <fcntl.h>
+#include <thread>
 
 namespace WCDB {
 
@@ -39,8 +41,10 @@ OperationEvent::~OperationEvent() = default;
 OperationQueue::OperationQueue(const UnsafeStringView& name, OperationEvent* event)
 : AsyncQueue(name)
 , m_event(event)
+, m_workersStopped(false)
 , m_observerForMemoryWarning(registerNotificationWhenMemoryWarning())
 {
+    m_timedQueue.setMerger(&OperationQueue::mergeParameter);
     Notifier::shared().setNotification(
     0, name, std::bind(&OperationQueue::handleError, this, std::placeholders::_1));
 #ifndef _WIN32
@@ -67,8 +71,18 @@ OperationQueue::~OperationQueue()
 
 void OperationQueue::main()
 {
+    int numberOfWorkers = std::max(
+    1, std::min((int) std::thread::hardware_concurrency(), OperationQueueMaxNumberOfWorkers));
+    std::vector<std::future<void>> workers;
+    for (int i = 0; i < numberOfWorkers; ++i) {
+        workers.push_back(std::async(std::launch::async, &OperationQueue::work, this));
+    }
     m_timedQueue.loop(std::bind(
-    &OperationQueue::onTimed, this, std::placeholders::_1, std::placeholders::_2));
+    &OperationQueue::onExpired, this, std::placeholders::_1, std::placeholders::_2));
+    stopWorkers();
+    for (auto& worker : workers) {
+        worker.wait();
+    }
 }
 
 void OperationQueue::handleError(const Error& error)
@@ -169,9 +183,38 @@ bool OperationQueue::Operation::operator==(const Operation& other) const
     return equal;
 }
 
+bool OperationQueue::Operation::operator<(const Operation& other) const
+{
+    if (type != other.type) {
+        return type < other.type;
+    }
+    if (type == Type::Purge) {
+        return false;
+    }
+    return path < other.path;
+}
+
 OperationQueue::Parameter::Parameter()
-: source(Source::Other), frames(0), numberOfFailures(0), identifier(0), numberOfFileDescriptors(0)
+: source(Source::Other)
+, frames(0)
+, checkpointMode(AutoCheckpointOperator::CheckpointMode::Passive)
+, numberOfFailures(0)
+, identifier(0)
+, numberOfFileDescriptors(0)
+{
+}
+
+void OperationQueue::mergeParameter(Parameter& parameter, const Parameter& pending)
 {
+    // The stronger checkpoint is kept so that a pending truncation will not be downgraded.
+    CheckpointMode mode = std::max(parameter.checkpointMode, pending.checkpointMode);
+    if (mode == CheckpointMode::Passive
+        && std::min(parameter.checkpointMode, pending.checkpointMode)
+           == CheckpointMode::Incremental) {
+        // The incremental one drains the same wal as the passive one, but in bounded steps.
+        mode = CheckpointMode::Incremental;
+    }
+    parameter.checkpointMode = mode;
 }
 
 void OperationQueue::onTimed(const Operation& operation, const Parameter& parameter)
@@ -182,14 +225,14 @@ void OperationQueue::onTimed(const Operation& operation, const Parameter& parame
         doMigrate(operation.path, parameter.numberOfFailures);
         break;
     case Operation::Type::Checkpoint:
-        doCheckpoint(operation.path);
+        doCheckpoint(operation.path, parameter.checkpointMode);
         break;
     case Operation::Type::Purge:
         WCTAssert(operation.path.empty());
         doPurge(parameter);
         break;
     case Operation::Type::Integrity:
-        doCheckIntegrity(operation.path);
+        doCheckIntegrity(operation.path, parameter.numberOfFailures);
         break;
     case Operation::Type::NotifyCorruption:
         doNotifyCorruption(operation.path, parameter.identifier);
@@ -210,6 +253,129 @@ void OperationQueue::async(const Operation& operation, double delay, const Param
     m_timedQueue.queue(operation, delay, parameter, mode);
 }
 
+void OperationQueue::cancel(const Operation& operation)
+{
+    m_timedQueue.remove(operation);
+
+    std::lock_guard<std::mutex> lockGuard(m_readyLock);
+    m_readyOperations.remove_if([&operation](const ReadyOperation& ready) {
+        return ready.operation == operation;
+    });
+}
+
+#pragma mark - Worker
+OperationQueue::QueueLatency::QueueLatency()
+: numberOfOperations(0), totalLatency(0), maxLatency(0)
+{
+}
+
+OperationQueue::ReadyOperation::ReadyOperation(const Operation& operation_, const Parameter& parameter_)
+: operation(operation_), parameter(parameter_), expired(SteadyClock::now())
+{
+}
+
+void OperationQueue::onExpired(const Operation& operation, const Parameter& parameter)
+{
+    {
+        std::lock_guard<std::mutex> lockGuard(m_readyLock);
+        if (m_workersStopped) {
+            return;
+        }
+        auto iter = m_readyOperations.begin();
+        for (; iter != m_readyOperations.end(); ++iter) {
+            if (iter->operation == operation) {
+                // it's not run yet
+                Parameter merged = parameter;
+                mergeParameter(merged, iter->parameter);
+                iter->parameter = merged;
+                return;
+            }
+            if (iter->operation.type > operation.type) {
+                break;
+            }
+        }
+        // keep FIFO for those with same priority so that no database will be starved.
+        for (; iter != m_readyOperations.end(); ++iter) {
+            if (iter->operation.type > operation.type) {
+                break;
+            }
+        }
+        m_readyOperations.emplace(iter, operation, parameter);
+    }
+    m_readyConditional.notify_all();
+}
+
+void OperationQueue::work()
+{
+    Thread::setName(name);
+    while (true) {
+        std::list<ReadyOperation> runnings;
+        {
+            std::unique_lock<std::mutex> lockGuard(m_readyLock);
+            while (true) {
+                if (m_workersStopped || isExiting()) {
+                    return;
+                }
+                auto iter = std::find_if(
+                m_readyOperations.begin(),
+                m_readyOperations.end(),
+                [this](const ReadyOperation& ready) {
+                    return ready.operation.path.empty()
+                           || m_runningPaths.find(ready.operation.path)
+                              == m_runningPaths.end();
+                });
+                if (iter != m_readyOperations.end()) {
+                    runnings.splice(runnings.begin(), m_readyOperations, iter);
+                    break;
+                }
+                m_readyConditional.wait_for(lockGuard, OperationQueueTimeIntervalForWaitingWorks);
+            }
+            const ReadyOperation& running = runnings.front();
+            if (!running.operation.path.empty()) {
+                m_runningPaths.emplace(running.operation.path);
+            }
+            double latency = SteadyClock::timeIntervalSinceSteadyClockToNow(running.expired);
+            QueueLatency& queueLatency = m_queueLatencies[running.operation.type];
+            ++queueLatency.numberOfOperations;
+            queueLatency.totalLatency += latency;
+            queueLatency.maxLatency = std::max(queueLatency.maxLatency, latency);
+        }
+
+        const ReadyOperation& running = runnings.front();
+        onTimed(running.operation, running.parameter);
+
+        {
+            std::lock_guard<std::mutex> lockGuard(m_readyLock);
+            if (!running.operation.path.empty()) {
+                m_runningPaths.erase(running.operation.path);
+            }
+        }
+        // operations of this path may be waiting
+        m_readyConditional.notify_all();
+    }
+}
+
+void OperationQueue::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lockGuard(m_readyLock);
+        m_workersStopped = true;
+        m_readyOperations.clear();
+    }
+    m_readyConditional.notify_all();
+}
+
+OperationQueue::QueueLatency OperationQueue::getQueueLatency(Operation::Type type) const
+{
+    std::lock_guard<std::mutex> lockGuard(m_readyLock);
+    QueueLatency queueLatency;
+    auto iter = m_queueLatencies.find(type);
+    if (iter != m_queueLatencies.end()) {
+        queueLatency = iter->second;
+    }
+    return queueLatency;
+}
+
 #pragma mark - Record
 OperationQueue::Record::Record()
 : registeredForMigration(false), registeredForBackup(false), registeredForCheckpoint(false)
@@ -232,7 +398,7 @@ void OperationQueue::registerAsNoMigrationRequired(const UnsafeStringView& path)
     LockGuard lockGuard(m_lock);
     m_records[path].registeredForMigration = false;
     Operation operation(Operation::Type::Migrate, path);
-    m_timedQueue.remove(operation);
+    cancel(operation);
 }
 
 void OperationQueue::asyncMigrate(const UnsafeStringView& path)
@@ -244,7 +410,7 @@ void OperationQueue::stopMigrate(const UnsafeStringView& path)
 {
     LockGuard lockGuard(m_lock);
     Operation operation(Operation::Type::Migrate, path);
-    m_timedQueue.remove(operation);
+    cancel(operation);
 }
 
 void OperationQueue::asyncMigrate(const UnsafeStringView& path, double delay, int numberOfFailures)
@@ -304,7 +470,7 @@ void OperationQueue::registerAsNoMergeFTSIndexRequired(const UnsafeStringView& p
     LockGuard lockGuard(m_lock);
     m_records[path].registeredForMergeFTSIndex = false;
     Operation operation(Operation::Type::MergeIndex, path);
-    m_timedQueue.remove(operation);
+    cancel(operation);
 }
 
 void OperationQueue::asyncMergeFTSIndex(const UnsafeStringView& path,
@@ -346,7 +512,7 @@ void OperationQueue::registerAsNoBackupRequired(const UnsafeStringView& path)
     LockGuard lockGuard(m_lock);
     m_records[path].registeredForBackup = false;
     Operation operation(Operation::Type::Backup, path);
-    m_timedQueue.remove(operation);
+    cancel(operation);
 }
 
 void OperationQueue::asyncBackup(const UnsafeStringView& path)
@@ -393,10 +559,10 @@ void OperationQueue::registerAsNoCheckpointRequired(const UnsafeStringView& path
     m_records[path].registeredForCheckpoint = false;
 
     Operation operation(Operation::Type::Checkpoint, path);
-    m_timedQueue.remove(operation);
+    cancel(operation);
 }
 
-void OperationQueue::asyncCheckpoint(const UnsafeStringView& path)
+void OperationQueue::asyncCheckpoint(const UnsafeStringView& path, double delay, CheckpointMode mode)
 {
     WCTAssert(!path.empty());
 
@@ -405,15 +571,21 @@ void OperationQueue::asyncCheckpoint(const UnsafeStringView& path)
     if (iter != m_records.end() && iter->second.registeredForCheckpoint) {
         Operation operation(Operation::Type::Checkpoint, path);
         Parameter parameter;
-        async(operation, OperationQueueTimeIntervalForCheckpoint, parameter, AsyncMode::ForwardOnly);
+        parameter.checkpointMode = mode;
+        async(operation, delay, parameter, AsyncMode::ForwardOnly);
     }
 }
 
-void OperationQueue::doCheckpoint(const UnsafeStringView& path)
+void OperationQueue::doCheckpoint(const UnsafeStringView& path, CheckpointMode mode)
 {
     WCTAssert(!path.empty());
 
-    m_event->checkpointShouldBeOperated(path);
+    auto done = m_event->checkpointShouldBeOperated(path, mode);
+    if (done.succeed() && !done.value()) {
+        // Schedule the next step until the wal is drained.
+        asyncCheckpoint(
+        path, OperationQueueTimeIntervalForCheckpointStep, CheckpointMode::Incremental);
+    }
 }
 
 #pragma mark - Purge
@@ -491,17 +663,38 @@ void OperationQueue::asyncCheckIntegrity(const UnsafeStringView& path, uint32_t
 
     SharedLockGuard lockGuard(m_lock);
     if (m_corrupteds.find(identifier) == m_corrupteds.end()) {
-        Operation operation(Operation::Type::Integrity, path);
-        Parameter parameter; // useless
-        async(operation, 0, parameter);
+        asyncCheckIntegrity(path, 0, 0);
     }
 }
 
-void OperationQueue::doCheckIntegrity(const UnsafeStringView& path)
+void OperationQueue::asyncCheckIntegrity(const UnsafeStringView& path, double delay, int numberOfFailures)
+{
+    WCTAssert(!path.empty());
+    WCTAssert(numberOfFailures >= 0
+              && numberOfFailures < OperationQueueTolerableFailuresForIntegrityCheck);
+
+    Operation operation(Operation::Type::Integrity, path);
+    Parameter parameter;
+    parameter.numberOfFailures = numberOfFailures;
+    async(operation, delay, parameter);
+}
+
+void OperationQueue::doCheckIntegrity(const UnsafeStringView& path, int numberOfFailures)
 {
     WCTAssert(!path.empty());
+    WCTAssert(numberOfFailures >= 0
+              && numberOfFailures < OperationQueueTolerableFailuresForIntegrityCheck);
 
-    m_event->integrityShouldBeChecked(path);
+    // The check is split into slices so that the wal won't be pinned for too long.
+    auto done = m_event->integrityShouldBeChecked(path);
+    if (done.succeed()) {
+        if (!done.value()) {
+            asyncCheckIntegrity(path, OperationQueueTimeIntervalForIntegrityCheck, numberOfFailures);
+        }
+    } else if (numberOfFailures + 1 < OperationQueueTolerableFailuresForIntegrityCheck) {
+        asyncCheckIntegrity(
+        path, OperationQueueTimeIntervalForRetringAfterFailure, numberOfFailures + 1);
+    }
 }
 
 #pragma mark - Corrupted
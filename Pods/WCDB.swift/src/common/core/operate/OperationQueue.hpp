@@ -29,6 +29,8 @@
 #include "StringView.hpp"
 #include "Time.hpp"
 #include "TimedQueue.hpp"
+#include <future>
+#include <list>
 #include <map>
 #include <set>
 
@@ -48,8 +50,10 @@ public:
 protected:
     virtual Optional<bool> migrationShouldBeOperated(const UnsafeStringView& path) = 0;
     virtual void backupShouldBeOperated(const UnsafeStringView& path) = 0;
-    virtual void checkpointShouldBeOperated(const UnsafeStringView& path) = 0;
-    virtual void integrityShouldBeChecked(const UnsafeStringView& path) = 0;
+    virtual Optional<bool>
+    checkpointShouldBeOperated(const UnsafeStringView& path, AutoCheckpointOperator::CheckpointMode mode)
+    = 0;
+    virtual Optional<bool> integrityShouldBeChecked(const UnsafeStringView& path) = 0;
     virtual void purgeShouldBeOperated() = 0;
 
     using TableArray = AutoMergeFTSIndexOperator::TableArray;
@@ -81,17 +85,18 @@ private:
     mutable SharedLock m_lock;
 
 #pragma mark - Operation
-protected:
+public:
     struct Operation {
     public:
+        // Declared in the descending order of priority.
         enum class Type {
-            Integrity,
             Purge,
             NotifyCorruption,
             Checkpoint,
-            Backup,
             Migrate,
             MergeIndex,
+            Backup,
+            Integrity,
         };
 
         const Type type;
@@ -101,9 +106,11 @@ protected:
         Operation(Type type, const UnsafeStringView& path);
 
         bool operator==(const Operation& other) const;
+        bool operator<(const Operation& other) const;
     };
     typedef struct Operation Operation;
 
+protected:
     struct Parameter {
         Parameter();
         enum class Source {
@@ -116,6 +123,7 @@ protected:
         } source;
 
         int frames;
+        AutoCheckpointOperator::CheckpointMode checkpointMode;
         int numberOfFailures;
         uint32_t identifier;
         uint32_t numberOfFileDescriptors;
@@ -123,6 +131,7 @@ protected:
         TableArray modifiedTables;
     };
     typedef struct Parameter Parameter;
+    static void mergeParameter(Parameter& parameter, const Parameter& pending);
 
     void onTimed(const Operation& operation, const Parameter& parameter);
 
@@ -131,8 +140,41 @@ protected:
                double delay,
                const Parameter& parameter,
                AsyncMode mode = AsyncMode::ForwardOnly);
+    void cancel(const Operation& operation);
     TimedQueue<Operation, Parameter> m_timedQueue;
 
+#pragma mark - Worker
+public:
+    struct QueueLatency {
+        QueueLatency();
+        uint64_t numberOfOperations;
+        double totalLatency;
+        double maxLatency;
+    };
+    // Latency between the time operation expired and the time it starts running.
+    QueueLatency getQueueLatency(Operation::Type type) const;
+
+protected:
+    // Expired operations are run by a pool of workers.
+    // Operations of the same path never run concurrently, and those with higher priority run first.
+    struct ReadyOperation {
+        ReadyOperation(const Operation& operation, const Parameter& parameter);
+        const Operation operation;
+        Parameter parameter;
+        const SteadyClock expired;
+    };
+    void onExpired(const Operation& operation, const Parameter& parameter);
+    void work();
+    void stopWorkers();
+
+    mutable std::mutex m_readyLock;
+    Conditional m_readyConditional;
+    // sorted by priority and expired time
+    std::list<ReadyOperation> m_readyOperations;
+    std::set<StringView> m_runningPaths;
+    std::map<Operation::Type, QueueLatency> m_queueLatencies;
+    bool m_workersStopped;
+
 #pragma mark - Record
 protected:
     struct Record {
@@ -184,10 +226,10 @@ public:
     void registerAsRequiredCheckpoint(const UnsafeStringView& path);
     void registerAsNoCheckpointRequired(const UnsafeStringView& path);
 
-    void asyncCheckpoint(const UnsafeStringView& path) override final;
+    void asyncCheckpoint(const UnsafeStringView& path, double delay, CheckpointMode mode) override final;
 
 protected:
-    void doCheckpoint(const UnsafeStringView& path);
+    void doCheckpoint(const UnsafeStringView& path, CheckpointMode mode);
 
 #pragma mark - Purge
 protected:
@@ -208,8 +250,9 @@ public:
 
 protected:
     void asyncCheckIntegrity(const UnsafeStringView& path, uint32_t identifier);
+    void asyncCheckIntegrity(const UnsafeStringView& path, double delay, int numberOfFailures);
 
-    void doCheckIntegrity(const UnsafeStringView& path);
+    void doCheckIntegrity(const UnsafeStringView& path, int numberOfFailures);
 
     // identifier of the corrupted database file -> the times of ignored corruption
     // it will be kept forever in memory since the identifier will be changed after removed/recovered
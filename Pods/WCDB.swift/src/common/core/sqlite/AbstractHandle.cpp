@@ -249,28 +249,42 @@ HandleStatement *AbstractHandle::getOrCreatePreparedStatement(const Statement &s
         Notifier::shared().notify(m_error);
         return nullptr;
     }
-    auto iter = m_preparedStatements.find(sql);
-    HandleStatement *preparedStatement;
-    if (iter == m_preparedStatements.end()) {
-        preparedStatement = getStatement();
-        m_preparedStatements[sql] = preparedStatement;
-    } else {
-        preparedStatement = iter->second;
+    HandleStatement *preparedStatement = m_preparedStatements.find(statement);
+    if (preparedStatement != nullptr) {
+        if (!preparedStatement->isPrepared() && !preparedStatement->prepare(statement)) {
+            return nullptr;
+        }
+        return preparedStatement;
     }
+    preparedStatement = getStatement();
     WCTAssert(preparedStatement != nullptr);
-    if (!preparedStatement->isPrepared() && !preparedStatement->prepare(statement)) {
+    if (!preparedStatement->prepare(statement)) {
+        returnStatement(preparedStatement);
         return nullptr;
     }
+    m_preparedStatements.insert(statement, preparedStatement);
     return preparedStatement;
 }
 
 void AbstractHandle::returnAllPreparedStatement()
 {
-    for (const auto &iter : m_preparedStatements) {
-        iter.second->finalize();
-        returnStatement(iter.second);
+    for (HandleStatement *evicted : m_preparedStatements.recycle()) {
+        evicted->finalize();
+        returnStatement(evicted);
+    }
+}
+
+void AbstractHandle::finalizeAllPreparedStatement()
+{
+    for (HandleStatement *preparedStatement : m_preparedStatements.clear()) {
+        preparedStatement->finalize();
+        returnStatement(preparedStatement);
     }
-    m_preparedStatements.clear();
+}
+
+void AbstractHandle::setPreparedStatementCacheMeter(PreparedStatementCacheMeter *meter)
+{
+    m_preparedStatements.setMeter(meter);
 }
 
 #pragma mark - Meta
@@ -563,11 +577,31 @@ bool AbstractHandle::checkpoint(CheckpointMode mode)
     static_assert((int) CheckpointMode::Restart == SQLITE_CHECKPOINT_RESTART, "");
     static_assert((int) CheckpointMode::Truncate == SQLITE_CHECKPOINT_TRUNCATE, "");
     WCTAssert(isOpened());
+    WCTRemedialAssert(mode != CheckpointMode::Incremental,
+                      "Incremental checkpoint should be done by checkpointFrames.",
+                      return false;);
 
     return APIExit(sqlite3_wal_checkpoint_v2(
     m_handle, Syntax::mainSchema.data(), (int) mode, nullptr, nullptr));
 }
 
+Optional<bool> AbstractHandle::checkpointFrames(int numberOfFrames)
+{
+    WCTAssert(isOpened());
+    WCTAssert(numberOfFrames > 0);
+
+    int numberOfWalFrames = 0;
+    int numberOfCheckpointedFrames = 0;
+    if (!APIExit(sqlite3_wal_checkpoint_frames(m_handle,
+                                               Syntax::mainSchema.data(),
+                                               numberOfFrames,
+                                               &numberOfWalFrames,
+                                               &numberOfCheckpointedFrames))) {
+        return NullOpt;
+    }
+    return numberOfCheckpointedFrames >= numberOfWalFrames;
+}
+
 void AbstractHandle::disableCheckpointWhenClosing(bool disable)
 {
     WCTAssert(isOpened());
@@ -776,6 +810,24 @@ bool AbstractHandle::setCipherKey(const UnsafeData &data)
     return APIExit(sqlite3_key(m_handle, data.buffer(), (int) data.size()));
 }
 
+UnsafeData AbstractHandle::getDerivedCipherKey()
+{
+    WCTAssert(isOpened());
+    void *key = nullptr;
+    int size = 0;
+    sqlite3CodecGetKey(m_handle,
+                       sqlcipher_find_db_index(m_handle, Schema::main().getDescription().data()),
+                       &key,
+                       &size);
+    // passphrase will be returned if the key is not derived yet.
+    unsigned char *buffer = static_cast<unsigned char *>(key);
+    if (buffer == nullptr || size <= 3 || buffer[0] != 'x' || buffer[1] != '\''
+        || buffer[size - 1] != '\'') {
+        return UnsafeData();
+    }
+    return UnsafeData(buffer, size);
+}
+
 bool AbstractHandle::setCipherPageSize(int pageSize)
 {
     WCTAssert(isOpened());
@@ -28,6 +28,7 @@
 #include "ErrorProne.hpp"
 #include "HandleNotification.hpp"
 #include "HandleStatement.hpp"
+#include "PreparedStatementCache.hpp"
 #include "StringView.hpp"
 #include "Tag.hpp"
 #include "WCDBOptional.hpp"
@@ -98,11 +99,16 @@ public:
     virtual void resetAllStatements();
     virtual void finalizeStatements();
     HandleStatement *getOrCreatePreparedStatement(const Statement &statement);
+    // Prepared statements are reset and kept in cache within the budget of meter.
     virtual void returnAllPreparedStatement();
+    void setPreparedStatementCacheMeter(PreparedStatementCacheMeter *meter);
+
+protected:
+    void finalizeAllPreparedStatement();
 
 private:
     std::list<HandleStatement> m_handleStatements;
-    StringViewMap<HandleStatement *> m_preparedStatements;
+    PreparedStatementCache m_preparedStatements;
 
 #pragma mark - Meta
 public:
@@ -154,12 +160,16 @@ public:
     void enableExtendedResultCodes(bool enable);
 
     enum class CheckpointMode {
+        // Passive checkpoint that is done in several steps, each of which backfills a limited number of frames.
+        Incremental = -1,
         Passive = 0,
         Full,
         Restart,
         Truncate,
     };
     bool checkpoint(CheckpointMode mode);
+    // Returns whether all the frames of wal are checkpointed.
+    Optional<bool> checkpointFrames(int numberOfFrames);
     void disableCheckpointWhenClosing(bool disable);
     void setWALFilePersist(int persist);
 
@@ -241,6 +251,8 @@ public:
     size_t getCipherPageSize();
     void *getCipherContext();
     bool setCipherKey(const UnsafeData &data);
+    // Raw key formatted as x'<key><salt>', which is available after key derived. Otherwise, empty data will be returned.
+    UnsafeData getDerivedCipherKey();
     bool setCipherPageSize(int pageSize);
     StringView getCipherSalt();
     bool setCipherSalt(const UnsafeStringView &salt);
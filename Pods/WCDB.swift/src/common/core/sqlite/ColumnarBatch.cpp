@@ -0,0 +1,219 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ColumnarBatch.hpp"
+#include "Assertion.hpp"
+#include <string.h>
+
+namespace WCDB {
+
+ColumnarBatch::ColumnarBatch(int capacity)
+: m_capacity(capacity), m_numberOfColumns(0), m_numberOfRows(0)
+{
+    WCTAssert(m_capacity > 0);
+}
+
+#pragma mark - Fill
+void ColumnarBatch::reset(int numberOfColumns)
+{
+    WCTAssert(numberOfColumns >= 0);
+    m_numberOfColumns = numberOfColumns;
+    m_numberOfRows = 0;
+    size_t numberOfCells = (size_t) m_capacity * m_numberOfColumns;
+    if (m_types.size() < numberOfCells) {
+        m_types.resize(numberOfCells);
+        m_values.resize(numberOfCells);
+        m_sizes.resize(numberOfCells);
+    }
+    m_bytes.clear();
+}
+
+int ColumnarBatch::addRow()
+{
+    WCTAssert(!isFull());
+    return m_numberOfRows++;
+}
+
+size_t ColumnarBatch::indexOf(int row, int column) const
+{
+    WCTAssert(row >= 0 && row < m_numberOfRows);
+    WCTAssert(column >= 0 && column < m_numberOfColumns);
+    return (size_t) column * m_capacity + row;
+}
+
+uint64_t ColumnarBatch::appendBytes(const void *bytes, size_t size, bool nullTerminated)
+{
+    uint64_t offset = m_bytes.size();
+    m_bytes.resize(offset + size + (nullTerminated ? 1 : 0));
+    if (size > 0) {
+        memcpy(m_bytes.data() + offset, bytes, size);
+    }
+    if (nullTerminated) {
+        m_bytes[offset + size] = '\0';
+    }
+    return offset;
+}
+
+void ColumnarBatch::setNull(int row, int column)
+{
+    size_t index = indexOf(row, column);
+    m_types[index] = ColumnType::Null;
+    m_values[index].integer = 0;
+    m_sizes[index] = 0;
+}
+
+void ColumnarBatch::setInteger(int row, int column, const Integer &value)
+{
+    size_t index = indexOf(row, column);
+    m_types[index] = ColumnType::Integer;
+    m_values[index].integer = value;
+    m_sizes[index] = 0;
+}
+
+void ColumnarBatch::setDouble(int row, int column, const Float &value)
+{
+    size_t index = indexOf(row, column);
+    m_types[index] = ColumnType::Float;
+    m_values[index].floatValue = value;
+    m_sizes[index] = 0;
+}
+
+void ColumnarBatch::setText(int row, int column, const Text &value)
+{
+    size_t index = indexOf(row, column);
+    m_types[index] = ColumnType::Text;
+    m_values[index].offset = appendBytes(value.data(), value.length(), true);
+    m_sizes[index] = value.length();
+}
+
+void ColumnarBatch::setBLOB(int row, int column, const BLOB &value)
+{
+    size_t index = indexOf(row, column);
+    m_types[index] = ColumnType::BLOB;
+    m_values[index].offset = appendBytes(value.buffer(), value.size(), false);
+    m_sizes[index] = value.size();
+}
+
+#pragma mark - Row
+int ColumnarBatch::getCapacity() const
+{
+    return m_capacity;
+}
+
+int ColumnarBatch::getNumberOfRows() const
+{
+    return m_numberOfRows;
+}
+
+int ColumnarBatch::getNumberOfColumns() const
+{
+    return m_numberOfColumns;
+}
+
+bool ColumnarBatch::isFull() const
+{
+    return m_numberOfRows >= m_capacity;
+}
+
+ColumnType ColumnarBatch::getType(int row, int column) const
+{
+    return m_types[indexOf(row, column)];
+}
+
+ColumnarBatch::Integer ColumnarBatch::getInteger(int row, int column) const
+{
+    size_t index = indexOf(row, column);
+    switch (m_types[index]) {
+    case ColumnType::Integer:
+        return m_values[index].integer;
+    case ColumnType::Float:
+        return (Integer) m_values[index].floatValue;
+    default:
+        return 0;
+    }
+}
+
+ColumnarBatch::Float ColumnarBatch::getDouble(int row, int column) const
+{
+    size_t index = indexOf(row, column);
+    switch (m_types[index]) {
+    case ColumnType::Integer:
+        return (Float) m_values[index].integer;
+    case ColumnType::Float:
+        return m_values[index].floatValue;
+    default:
+        return 0;
+    }
+}
+
+ColumnarBatch::Text ColumnarBatch::getText(int row, int column) const
+{
+    size_t index = indexOf(row, column);
+    if (m_types[index] != ColumnType::Text && m_types[index] != ColumnType::BLOB) {
+        return UnsafeStringView();
+    }
+    return UnsafeStringView(
+    reinterpret_cast<const char *>(m_bytes.data() + m_values[index].offset),
+    (size_t) m_sizes[index]);
+}
+
+const ColumnarBatch::BLOB ColumnarBatch::getBLOB(int row, int column) const
+{
+    size_t index = indexOf(row, column);
+    if (m_types[index] != ColumnType::Text && m_types[index] != ColumnType::BLOB) {
+        return UnsafeData();
+    }
+    return UnsafeData::immutable(m_bytes.data() + m_values[index].offset,
+                                 (size_t) m_sizes[index]);
+}
+
+#pragma mark - Column
+const ColumnType *ColumnarBatch::getTypes(int column) const
+{
+    WCTAssert(column >= 0 && column < m_numberOfColumns);
+    return m_types.data() + (size_t) column * m_capacity;
+}
+
+const ColumnarBatch::Value *ColumnarBatch::getValues(int column) const
+{
+    WCTAssert(column >= 0 && column < m_numberOfColumns);
+    return m_values.data() + (size_t) column * m_capacity;
+}
+
+const uint64_t *ColumnarBatch::getSizes(int column) const
+{
+    WCTAssert(column >= 0 && column < m_numberOfColumns);
+    return m_sizes.data() + (size_t) column * m_capacity;
+}
+
+const unsigned char *ColumnarBatch::getBytes() const
+{
+    return m_bytes.data();
+}
+
+size_t ColumnarBatch::getNumberOfBytes() const
+{
+    return m_bytes.size();
+}
+
+} //namespace WCDB
@@ -0,0 +1,107 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "ColumnType.hpp"
+#include "CoreConst.h"
+#include "UnsafeData.hpp"
+#include <vector>
+
+namespace WCDB {
+
+/*
+ * A reusable batch of rows stored column by column.
+ * Integer/Float values are kept inline, while Text/BLOB values are copied into a single arena,
+ * so that filling a batch allocates nothing once it has grown to the size of its data.
+ * Text in the arena is always null-terminated.
+ */
+class ColumnarBatch final {
+public:
+    ColumnarBatch(int capacity = ColumnarBatchDefaultNumberOfRows);
+    ColumnarBatch(const ColumnarBatch &) = delete;
+    ColumnarBatch &operator=(const ColumnarBatch &) = delete;
+
+    using Integer = ColumnTypeInfo<ColumnType::Integer>::UnderlyingType;
+    using Text = ColumnTypeInfo<ColumnType::Text>::UnderlyingType;
+    using Float = ColumnTypeInfo<ColumnType::Float>::UnderlyingType;
+    using BLOB = ColumnTypeInfo<ColumnType::BLOB>::UnderlyingType;
+
+    union Value {
+        Integer integer;
+        Float floatValue;
+        // offset of Text/BLOB in the arena
+        uint64_t offset;
+    };
+
+#pragma mark - Fill
+public:
+    // Drop all the rows but keep the memory.
+    void reset(int numberOfColumns);
+    // return the index of the new row
+    int addRow();
+
+    void setNull(int row, int column);
+    void setInteger(int row, int column, const Integer &value);
+    void setDouble(int row, int column, const Float &value);
+    void setText(int row, int column, const Text &value);
+    void setBLOB(int row, int column, const BLOB &value);
+
+#pragma mark - Row
+public:
+    int getCapacity() const;
+    int getNumberOfRows() const;
+    int getNumberOfColumns() const;
+    bool isFull() const;
+
+    ColumnType getType(int row, int column) const;
+    Integer getInteger(int row, int column) const;
+    Float getDouble(int row, int column) const;
+    Text getText(int row, int column) const;
+    const BLOB getBLOB(int row, int column) const;
+
+#pragma mark - Column
+public:
+    // Each column is a contiguous array of getNumberOfRows() elements.
+    // They are valid until the next time the batch is filled.
+    const ColumnType *getTypes(int column) const;
+    const Value *getValues(int column) const;
+    // size in bytes of Text/BLOB, excluding the null terminator of Text
+    const uint64_t *getSizes(int column) const;
+    const unsigned char *getBytes() const;
+    size_t getNumberOfBytes() const;
+
+private:
+    size_t indexOf(int row, int column) const;
+    uint64_t appendBytes(const void *bytes, size_t size, bool nullTerminated);
+
+    int m_capacity;
+    int m_numberOfColumns;
+    int m_numberOfRows;
+    std::vector<ColumnType> m_types;
+    std::vector<Value> m_values;
+    std::vector<uint64_t> m_sizes;
+    std::vector<unsigned char> m_bytes;
+};
+
+} //namespace WCDB
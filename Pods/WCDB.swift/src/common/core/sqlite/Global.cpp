@@ -149,6 +149,16 @@ void Global::setNotificationForLockEvent(const UnsafeStringView &name,
                                          const ShmLockDidChangeNotification &shmLockDidChange)
 {
     LockGuard lockGuard(m_lock);
+    if (willLock == nullptr && lockDidChange == nullptr && willShmLock == nullptr
+        && shmLockDidChange == nullptr) {
+        m_lockEventNotifications.erase(name);
+        return;
+    }
+    WCTRemedialAssert(m_lockEventNotifications.empty()
+                      || m_lockEventNotifications.find(name)
+                         != m_lockEventNotifications.end(),
+                      "Context of the file can't be shared by multiple listeners of lock events.",
+                      return;);
     LockEvent event;
     event.willLock = willLock;
     event.lockDidChange = lockDidChange;
@@ -157,12 +167,12 @@ void Global::setNotificationForLockEvent(const UnsafeStringView &name,
     m_lockEventNotifications[name] = event;
 }
 
-void Global::willLock(void *parameter, const char *path, int type)
+void Global::willLock(void *parameter, const char *path, void **context, int type)
 {
-    reinterpret_cast<Global *>(parameter)->postWillLockNotification(path, type);
+    reinterpret_cast<Global *>(parameter)->postWillLockNotification(path, context, type);
 }
 
-void Global::postWillLockNotification(const char *path_, int type_)
+void Global::postWillLockNotification(const char *path_, void **context, int type_)
 {
     UnsafeStringView path = path_;
     WCTAssert(!path.empty());
@@ -174,17 +184,17 @@ void Global::postWillLockNotification(const char *path_, int type_)
     SharedLockGuard lockGuard(m_lock);
     for (const auto &iter : m_lockEventNotifications) {
         if (iter.second.willLock != nullptr) {
-            iter.second.willLock(path, type);
+            iter.second.willLock(path, context, type);
         }
     }
 }
 
-void Global::lockDidChange(void *parameter, const char *path, int type)
+void Global::lockDidChange(void *parameter, const char *path, void **context, int type)
 {
-    reinterpret_cast<Global *>(parameter)->postLockDidChangeNotification(path, type);
+    reinterpret_cast<Global *>(parameter)->postLockDidChangeNotification(path, context, type);
 }
 
-void Global::postLockDidChangeNotification(const char *path_, int type_)
+void Global::postLockDidChangeNotification(const char *path_, void **context, int type_)
 {
     UnsafeStringView path = path_;
     WCTAssert(!path.empty());
@@ -196,17 +206,17 @@ void Global::postLockDidChangeNotification(const char *path_, int type_)
     SharedLockGuard lockGuard(m_lock);
     for (const auto &iter : m_lockEventNotifications) {
         if (iter.second.lockDidChange != nullptr) {
-            iter.second.lockDidChange(path, type);
+            iter.second.lockDidChange(path, context, type);
         }
     }
 }
 
-void Global::willShmLock(void *parameter, const char *path, int flags, int mask)
+void Global::willShmLock(void *parameter, const char *path, void **context, int flags, int mask)
 {
-    reinterpret_cast<Global *>(parameter)->postWillShmLockNotification(path, flags, mask);
+    reinterpret_cast<Global *>(parameter)->postWillShmLockNotification(path, context, flags, mask);
 }
 
-void Global::postWillShmLockNotification(const char *path_, int flags, int mask)
+void Global::postWillShmLockNotification(const char *path_, void **context, int flags, int mask)
 {
     UnsafeStringView path = path_;
     WCTAssert(!path.empty());
@@ -223,18 +233,24 @@ void Global::postWillShmLockNotification(const char *path_, int flags, int mask)
     SharedLockGuard lockGuard(m_lock);
     for (const auto &iter : m_lockEventNotifications) {
         if (iter.second.willShmLock != nullptr) {
-            iter.second.willShmLock(path, type, mask);
+            iter.second.willShmLock(path, context, type, mask);
         }
     }
 }
 
-void Global::shmLockDidChange(void *parameter, const char *path, void *identifier, int sharedMask, int exclusiveMask)
+void Global::shmLockDidChange(void *parameter,
+                              const char *path,
+                              void **context,
+                              void *identifier,
+                              int sharedMask,
+                              int exclusiveMask)
 {
     reinterpret_cast<Global *>(parameter)->postShmLockDidChangeNotification(
-    path, identifier, sharedMask, exclusiveMask);
+    path, context, identifier, sharedMask, exclusiveMask);
 }
 
 void Global::postShmLockDidChangeNotification(const char *path_,
+                                              void **context,
                                               void *identifier,
                                               int sharedMask,
                                               int exclusiveMask)
@@ -247,7 +263,7 @@ void Global::postShmLockDidChangeNotification(const char *path_,
     SharedLockGuard lockGuard(m_lock);
     for (const auto &iter : m_lockEventNotifications) {
         if (iter.second.shmLockDidChange != nullptr) {
-            iter.second.shmLockDidChange(path, identifier, sharedMask, exclusiveMask);
+            iter.second.shmLockDidChange(path, context, identifier, sharedMask, exclusiveMask);
         }
     }
 }
@@ -82,10 +82,12 @@ public:
         Shared = 4,
         Exclusive = 8,
     };
-    typedef std::function<void(const UnsafeStringView& /* path */, PagerLock)> WillLockNotification;
-    typedef std::function<void(const UnsafeStringView& /* path */, PagerLock)> LockDidChangeNotification;
-    typedef std::function<void(const UnsafeStringView& /* path */, ShmLock, int /* mask */)> WillShmLockNotification;
-    typedef std::function<void(const UnsafeStringView& /* path */, void* /* identifier */, int /* sharedMask */, int /* exclMask */)> ShmLockDidChangeNotification;
+    // Context is kept by the file during its lifetime and it's nullptr when the file is opened.
+    // The file has only one context, so only one listener of lock events can be set at a time.
+    typedef std::function<void(const UnsafeStringView& /* path */, void** /* context */, PagerLock)> WillLockNotification;
+    typedef std::function<void(const UnsafeStringView& /* path */, void** /* context */, PagerLock)> LockDidChangeNotification;
+    typedef std::function<void(const UnsafeStringView& /* path */, void** /* context */, ShmLock, int /* mask */)> WillShmLockNotification;
+    typedef std::function<void(const UnsafeStringView& /* path */, void** /* context */, void* /* identifier */, int /* sharedMask */, int /* exclMask */)> ShmLockDidChangeNotification;
     void setNotificationForLockEvent(const UnsafeStringView& name,
                                      const WillLockNotification& willLock,
                                      const LockDidChangeNotification& lockDidChange,
@@ -93,18 +95,24 @@ public:
                                      const ShmLockDidChangeNotification& shmLockDidChange);
 
 private:
-    static void willLock(void* parameter, const char* path, int type);
-    void postWillLockNotification(const char* path, int type);
+    static void willLock(void* parameter, const char* path, void** context, int type);
+    void postWillLockNotification(const char* path, void** context, int type);
 
-    static void lockDidChange(void* parameter, const char* path, int type);
-    void postLockDidChangeNotification(const char* path, int type);
-
-    static void willShmLock(void* parameter, const char* path, int flags, int mask);
-    void postWillShmLockNotification(const char* path, int flags, int mask);
+    static void lockDidChange(void* parameter, const char* path, void** context, int type);
+    void postLockDidChangeNotification(const char* path, void** context, int type);
 
     static void
-    shmLockDidChange(void* parameter, const char* path, void* identifier, int sharedMask, int exclusiveMask);
+    willShmLock(void* parameter, const char* path, void** context, int flags, int mask);
+    void postWillShmLockNotification(const char* path, void** context, int flags, int mask);
+
+    static void shmLockDidChange(void* parameter,
+                                 const char* path,
+                                 void** context,
+                                 void* identifier,
+                                 int sharedMask,
+                                 int exclusiveMask);
     void postShmLockDidChangeNotification(const char* path,
+                                          void** context,
                                           void* identifier,
                                           int sharedMask,
                                           int exclusiveMask);
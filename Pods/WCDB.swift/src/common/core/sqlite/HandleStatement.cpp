@@ -26,10 +26,12 @@
 #include "AbstractHandle.hpp"
 #include "Assertion.hpp"
 #include "BaseBinding.hpp"
+#include "ColumnarBatch.hpp"
 #include "Core.hpp"
 #include "InnerHandle.hpp"
 #include "MigratingHandle.hpp"
 #include "MigrationInfo.hpp"
+#include "RowDecoder.hpp"
 #include "SQLite.h"
 #include "WINQ.h"
 #include <string.h>
@@ -354,6 +356,22 @@ void HandleStatement::reset()
     APIExit(sqlite3_reset(m_stmt));
 }
 
+void HandleStatement::recycle()
+{
+    if (m_stmt != nullptr) {
+        // no need to call APIExit since it returns the code of last step only.
+        sqlite3_reset(m_stmt);
+        sqlite3_clear_bindings(m_stmt);
+        m_done = false;
+    }
+}
+
+int HandleStatement::getMemoryUsed()
+{
+    WCTAssert(isPrepared());
+    return sqlite3_stmt_status(m_stmt, SQLITE_STMTSTATUS_MEMUSED, 0);
+}
+
 bool HandleStatement::done()
 {
     return m_done;
@@ -469,6 +487,26 @@ void HandleStatement::bindBLOB(const BLOB &value, int index)
     WCDB_UNUSED(succeed);
 }
 
+void HandleStatement::bindStaticText(const Text &value, int index)
+{
+    WCTAssert(isPrepared());
+    WCTAssert(!isBusy());
+    bool succeed = APIExit(sqlite3_bind_text(
+    m_stmt, index, value.data(), (int) value.length(), SQLITE_STATIC));
+    WCTAssert(succeed);
+    WCDB_UNUSED(succeed);
+}
+
+void HandleStatement::bindStaticBLOB(const BLOB &value, int index)
+{
+    WCTAssert(isPrepared());
+    WCTAssert(!isBusy());
+    bool succeed = APIExit(sqlite3_bind_blob(
+    m_stmt, index, value.buffer(), (int) value.size(), SQLITE_STATIC));
+    WCTAssert(succeed);
+    WCDB_UNUSED(succeed);
+}
+
 void HandleStatement::bindNull(int index)
 {
     WCTAssert(isPrepared());
@@ -609,6 +647,89 @@ OptionalMultiRows HandleStatement::getAllRows()
     return !result.hasValue() ? MultiRowsValue() : result;
 }
 
+bool HandleStatement::stepBatch(ColumnarBatch &batch)
+{
+    int numberOfColumns = getNumberOfColumns();
+    batch.reset(numberOfColumns);
+    while (!batch.isFull()) {
+        if (!step()) {
+            return false;
+        }
+        if (done()) {
+            break;
+        }
+        int row = batch.addRow();
+        for (int i = 0; i < numberOfColumns; ++i) {
+            switch (getType(i)) {
+            case ColumnType::Null:
+                batch.setNull(row, i);
+                break;
+            case ColumnType::Integer:
+                batch.setInteger(row, i, getInteger(i));
+                break;
+            case ColumnType::Float:
+                batch.setDouble(row, i, getDouble(i));
+                break;
+            case ColumnType::Text:
+                batch.setText(row, i, getText(i));
+                break;
+            case ColumnType::BLOB:
+                batch.setBLOB(row, i, getBLOB(i));
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+Optional<int> HandleStatement::stepRows(RowDecoder &decoder, void *rows, int capacity)
+{
+    WCTAssert(isPrepared());
+    WCTAssert(rows != nullptr && capacity > 0);
+    WCTRemedialAssert(decoder.getMaxColumn() < getNumberOfColumns(),
+                      "The layout of decoder doesn't match the statement.",
+                      return NullOpt;);
+    decoder.reset();
+    const auto &fields = decoder.getFields();
+    unsigned char *row = static_cast<unsigned char *>(rows);
+    int numberOfRows = 0;
+    while (numberOfRows < capacity) {
+        if (!step()) {
+            return NullOpt;
+        }
+        if (done()) {
+            break;
+        }
+        // Read the columns directly since the statement is known to be busy with a row.
+        for (const auto &field : fields) {
+            if (sqlite3_column_type(m_stmt, field.column) == SQLITE_NULL) {
+                decoder.setNull(row, field);
+                continue;
+            }
+            switch (field.type) {
+            case RowDecoder::FieldType::Integer:
+                decoder.setInteger(row, field, sqlite3_column_int64(m_stmt, field.column));
+                break;
+            case RowDecoder::FieldType::Float:
+                decoder.setDouble(row, field, sqlite3_column_double(m_stmt, field.column));
+                break;
+            case RowDecoder::FieldType::Text: {
+                const unsigned char *text = sqlite3_column_text(m_stmt, field.column);
+                decoder.setBytes(row, field, text, sqlite3_column_bytes(m_stmt, field.column));
+            } break;
+            case RowDecoder::FieldType::BLOB: {
+                const void *blob = sqlite3_column_blob(m_stmt, field.column);
+                decoder.setBytes(row, field, blob, sqlite3_column_bytes(m_stmt, field.column));
+            } break;
+            }
+        }
+        row += decoder.getRowSize();
+        ++numberOfRows;
+    }
+    decoder.finish();
+    return numberOfRows;
+}
+
 signed long long HandleStatement::getColumnSize(int index)
 {
     WCTAssert(isPrepared());
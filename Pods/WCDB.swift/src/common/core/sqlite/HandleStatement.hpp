@@ -32,6 +32,9 @@
 
 namespace WCDB {
 
+class ColumnarBatch;
+class RowDecoder;
+
 class HandleStatement : public HandleRelated {
     friend class AbstractHandle;
 
@@ -55,6 +58,9 @@ public:
     virtual bool step();
     virtual bool done();
     virtual void reset();
+    // Reset and clear all the bindings so that the statement can be reused later.
+    void recycle();
+    int getMemoryUsed();
 
     using Integer = ColumnTypeInfo<ColumnType::Integer>::UnderlyingType;
     using Text = ColumnTypeInfo<ColumnType::Text>::UnderlyingType;
@@ -66,6 +72,9 @@ public:
     virtual void bindText(const Text &value, int index = 1);
     virtual void bindBLOB(const BLOB &value, int index = 1);
     virtual void bindNull(int index = 1);
+    // Bind without copying. The value must be kept alive until the statement is rebound, recycled or finalized.
+    void bindStaticText(const Text &value, int index = 1);
+    void bindStaticBLOB(const BLOB &value, int index = 1);
     virtual void
     bindPointer(void *ptr, int index, const Text &type, void (*destructor)(void *));
     int bindParameterIndex(const Text &parameterName);
@@ -86,6 +95,12 @@ public:
     virtual OptionalOneColumn getOneColumn(int index = 0);
     virtual OneRowValue getOneRow();
     virtual OptionalMultiRows getAllRows();
+    // Step and fill at most batch.getCapacity() rows into the batch, which will be reset first.
+    // Fewer rows than the capacity means that it's done. It returns false on error.
+    bool stepBatch(ColumnarBatch &batch);
+    // Step and decode at most capacity rows into the rows with the layout of decoder.
+    // Fewer rows than the capacity means that it's done.
+    Optional<int> stepRows(RowDecoder &decoder, void *rows, int capacity);
 
     virtual const UnsafeStringView getOriginColumnName(int index);
     virtual const UnsafeStringView getColumnName(int index);
@@ -0,0 +1,188 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PreparedStatementCache.hpp"
+#include "Assertion.hpp"
+#include "CoreConst.h"
+#include "HandleStatement.hpp"
+#include "Statement.hpp"
+
+namespace WCDB {
+
+#pragma mark - Meter
+PreparedStatementCacheMeter::PreparedStatementCacheMeter()
+: m_maxCount(PreparedStatementCacheDefaultMaxCount)
+, m_maxMemory(PreparedStatementCacheDefaultMaxMemory)
+, m_hits(0)
+, m_misses(0)
+, m_evictions(0)
+{
+}
+
+void PreparedStatementCacheMeter::setBudget(size_t maxCount, size_t maxMemory)
+{
+    m_maxCount.store(maxCount, std::memory_order_relaxed);
+    m_maxMemory.store(maxMemory, std::memory_order_relaxed);
+}
+
+size_t PreparedStatementCacheMeter::getMaxCount() const
+{
+    return m_maxCount.load(std::memory_order_relaxed);
+}
+
+size_t PreparedStatementCacheMeter::getMaxMemory() const
+{
+    return m_maxMemory.load(std::memory_order_relaxed);
+}
+
+PreparedStatementCacheMeter::Statistics PreparedStatementCacheMeter::getStatistics() const
+{
+    Statistics statistics;
+    statistics.hits = m_hits.load(std::memory_order_relaxed);
+    statistics.misses = m_misses.load(std::memory_order_relaxed);
+    statistics.evictions = m_evictions.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void PreparedStatementCacheMeter::increaseHits()
+{
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PreparedStatementCacheMeter::increaseMisses()
+{
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PreparedStatementCacheMeter::increaseEvictions(size_t count)
+{
+    m_evictions.fetch_add(count, std::memory_order_relaxed);
+}
+
+#pragma mark - Cache
+PreparedStatementCache::PreparedStatementCache()
+: m_memoryUsed(0), m_meter(nullptr)
+{
+}
+
+void PreparedStatementCache::setMeter(PreparedStatementCacheMeter *meter)
+{
+    m_meter = meter;
+}
+
+HandleStatement *PreparedStatementCache::find(const Statement &statement)
+{
+    size_t fingerprint = statement.getFingerprint();
+    auto range = m_map.equal_range(fingerprint);
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        List::iterator entry = iter->second;
+        if (entry->sql.equal(statement.getDescription())) {
+            m_list.splice(m_list.begin(), m_list, entry);
+            if (m_meter != nullptr) {
+                m_meter->increaseHits();
+            }
+            return entry->handleStatement;
+        }
+    }
+    if (m_meter != nullptr) {
+        m_meter->increaseMisses();
+    }
+    return nullptr;
+}
+
+void PreparedStatementCache::insert(const Statement &statement, HandleStatement *handleStatement)
+{
+    WCTAssert(handleStatement != nullptr);
+    Entry entry;
+    entry.fingerprint = statement.getFingerprint();
+    entry.sql = statement.getDescription();
+    entry.cost = entry.sql.length() + handleStatement->getMemoryUsed();
+    entry.handleStatement = handleStatement;
+    m_list.push_front(std::move(entry));
+    m_map.emplace(m_list.front().fingerprint, m_list.begin());
+    m_memoryUsed += m_list.front().cost;
+}
+
+void PreparedStatementCache::remove(List::iterator entry)
+{
+    auto range = m_map.equal_range(entry->fingerprint);
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        if (iter->second == entry) {
+            m_map.erase(iter);
+            break;
+        }
+    }
+    WCTAssert(m_memoryUsed >= entry->cost);
+    m_memoryUsed -= entry->cost;
+    m_list.erase(entry);
+}
+
+std::vector<HandleStatement *> PreparedStatementCache::recycle()
+{
+    size_t maxCount = PreparedStatementCacheDefaultMaxCount;
+    size_t maxMemory = PreparedStatementCacheDefaultMaxMemory;
+    if (m_meter != nullptr) {
+        maxCount = m_meter->getMaxCount();
+        maxMemory = m_meter->getMaxMemory();
+    }
+
+    std::vector<HandleStatement *> evicteds;
+    while (!m_list.empty() && (m_list.size() > maxCount || m_memoryUsed > maxMemory)) {
+        auto last = std::prev(m_list.end());
+        evicteds.push_back(last->handleStatement);
+        remove(last);
+    }
+    for (auto &entry : m_list) {
+        entry.handleStatement->recycle();
+    }
+    if (m_meter != nullptr && !evicteds.empty()) {
+        m_meter->increaseEvictions(evicteds.size());
+    }
+    return evicteds;
+}
+
+std::vector<HandleStatement *> PreparedStatementCache::clear()
+{
+    std::vector<HandleStatement *> handleStatements;
+    handleStatements.reserve(m_list.size());
+    for (const auto &entry : m_list) {
+        handleStatements.push_back(entry.handleStatement);
+    }
+    m_list.clear();
+    m_map.clear();
+    m_memoryUsed = 0;
+    return handleStatements;
+}
+
+size_t PreparedStatementCache::size() const
+{
+    return m_list.size();
+}
+
+size_t PreparedStatementCache::getMemoryUsed() const
+{
+    return m_memoryUsed;
+}
+
+} //namespace WCDB
@@ -0,0 +1,115 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "StringView.hpp"
+#include <atomic>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace WCDB {
+
+class HandleStatement;
+class Statement;
+
+/*
+ * Budget and counters shared by the prepared statement caches of all handles in a pool.
+ * All of the methods are thread-safe.
+ */
+class PreparedStatementCacheMeter final {
+public:
+    PreparedStatementCacheMeter();
+    PreparedStatementCacheMeter(const PreparedStatementCacheMeter &) = delete;
+    PreparedStatementCacheMeter &operator=(const PreparedStatementCacheMeter &) = delete;
+
+    // 0 means that no statement will be kept after the handle is recycled.
+    void setBudget(size_t maxCount, size_t maxMemory);
+    size_t getMaxCount() const;
+    size_t getMaxMemory() const;
+
+    struct Statistics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+    Statistics getStatistics() const;
+
+    void increaseHits();
+    void increaseMisses();
+    void increaseEvictions(size_t count);
+
+private:
+    std::atomic<size_t> m_maxCount;
+    std::atomic<size_t> m_maxMemory;
+    std::atomic<uint64_t> m_hits;
+    std::atomic<uint64_t> m_misses;
+    std::atomic<uint64_t> m_evictions;
+};
+
+/*
+ * LRU cache of prepared statements in a handle, keyed by the fingerprint of statement.
+ * The cache may exceed the budget while the handle is in use,
+ * since the returned statements can not be finalized until the handle is recycled.
+ * It's not thread-safe.
+ */
+class PreparedStatementCache final {
+public:
+    PreparedStatementCache();
+    PreparedStatementCache(const PreparedStatementCache &) = delete;
+    PreparedStatementCache &operator=(const PreparedStatementCache &) = delete;
+
+    void setMeter(PreparedStatementCacheMeter *meter);
+
+    HandleStatement *find(const Statement &statement);
+    void insert(const Statement &statement, HandleStatement *handleStatement);
+
+    // Reset all the cached statements and remove the least recently used ones exceeding the budget.
+    // The removed statements are returned to be finalized.
+    std::vector<HandleStatement *> recycle();
+    std::vector<HandleStatement *> clear();
+
+    size_t size() const;
+    size_t getMemoryUsed() const;
+
+private:
+    struct Entry {
+        size_t fingerprint;
+        StringView sql;
+        size_t cost;
+        HandleStatement *handleStatement;
+    };
+    using List = std::list<Entry>;
+    using Map = std::unordered_multimap<size_t, List::iterator>;
+
+    void remove(List::iterator entry);
+
+    List m_list;
+    Map m_map;
+    size_t m_memoryUsed;
+    PreparedStatementCacheMeter *m_meter;
+};
+
+} //namespace WCDB
@@ -0,0 +1,155 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RowDecoder.hpp"
+#include "Assertion.hpp"
+#include <algorithm>
+#include <string.h>
+
+namespace WCDB {
+
+RowDecoder::Field::Field(int column_, size_t offset_, FieldType type_, ssize_t nullOffset_)
+: column(column_), offset(offset_), nullOffset(nullOffset_), type(type_)
+{
+}
+
+size_t RowDecoder::Field::getSize() const
+{
+    switch (type) {
+    case FieldType::Integer:
+        return sizeof(Integer);
+    case FieldType::Float:
+        return sizeof(Float);
+    default:
+        return sizeof(Span);
+    }
+}
+
+RowDecoder::RowDecoder(const std::vector<Field> &fields, size_t rowSize)
+: m_fields(fields), m_rowSize(rowSize), m_maxColumn(-1)
+{
+    for (const Field &field : m_fields) {
+        WCTAssert(isValidField(field, m_rowSize));
+        m_maxColumn = std::max(m_maxColumn, field.column);
+    }
+}
+
+bool RowDecoder::isValidField(const Field &field, size_t rowSize)
+{
+    if (field.column < 0 || field.type < FieldType::Integer || field.type > FieldType::BLOB) {
+        return false;
+    }
+    if (field.offset > rowSize || field.getSize() > rowSize - field.offset) {
+        return false;
+    }
+    if (field.type >= FieldType::Text && field.offset % alignof(Span) != 0) {
+        return false;
+    }
+    return field.nullOffset < 0 || (size_t) field.nullOffset + sizeof(bool) <= rowSize;
+}
+
+const std::vector<RowDecoder::Field> &RowDecoder::getFields() const
+{
+    return m_fields;
+}
+
+size_t RowDecoder::getRowSize() const
+{
+    return m_rowSize;
+}
+
+int RowDecoder::getMaxColumn() const
+{
+    return m_maxColumn;
+}
+
+#pragma mark - Decode
+void RowDecoder::reset()
+{
+    m_bytes.clear();
+    m_pendingSpans.clear();
+}
+
+void RowDecoder::setNotNull(unsigned char *row, const Field &field)
+{
+    if (field.nullOffset >= 0) {
+        row[field.nullOffset] = false;
+    }
+}
+
+void RowDecoder::setNull(void *row, const Field &field)
+{
+    unsigned char *bytes = static_cast<unsigned char *>(row);
+    if (field.nullOffset >= 0) {
+        bytes[field.nullOffset] = true;
+    }
+    // Null is decoded as zero or empty span.
+    memset(bytes + field.offset, 0, field.getSize());
+}
+
+void RowDecoder::setInteger(void *row, const Field &field, const Integer &value)
+{
+    WCTAssert(field.type == FieldType::Integer);
+    unsigned char *bytes = static_cast<unsigned char *>(row);
+    setNotNull(bytes, field);
+    memcpy(bytes + field.offset, &value, sizeof(value));
+}
+
+void RowDecoder::setDouble(void *row, const Field &field, const Float &value)
+{
+    WCTAssert(field.type == FieldType::Float);
+    unsigned char *bytes = static_cast<unsigned char *>(row);
+    setNotNull(bytes, field);
+    memcpy(bytes + field.offset, &value, sizeof(value));
+}
+
+void RowDecoder::setBytes(void *row, const Field &field, const void *bytes, size_t size)
+{
+    WCTAssert(field.type == FieldType::Text || field.type == FieldType::BLOB);
+    unsigned char *rowBytes = static_cast<unsigned char *>(row);
+    setNotNull(rowBytes, field);
+    bool nullTerminated = field.type == FieldType::Text;
+    uint64_t offset = m_bytes.size();
+    m_bytes.resize(offset + size + (nullTerminated ? 1 : 0));
+    if (size > 0) {
+        memcpy(m_bytes.data() + offset, bytes, size);
+    }
+    if (nullTerminated) {
+        m_bytes[offset + size] = '\0';
+    }
+    Span *span = reinterpret_cast<Span *>(rowBytes + field.offset);
+    span->bytes = nullptr;
+    span->size = size;
+    m_pendingSpans.emplace_back(span, offset);
+}
+
+void RowDecoder::finish()
+{
+    for (const auto &pendingSpan : m_pendingSpans) {
+        pendingSpan.first->bytes = m_bytes.data() + pendingSpan.second;
+    }
+    m_pendingSpans.clear();
+}
+
+} //namespace WCDB
@@ -0,0 +1,104 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "ColumnType.hpp"
+#include <sys/types.h>
+#include <vector>
+
+namespace WCDB {
+
+/*
+ * A layout that decodes the result rows of a statement into the structs of the caller.
+ * Each field refers to a result column and to an offset in the struct, so that only the projected columns are read.
+ * Integer/Float values are written inline, while Text/BLOB values are written as spans into the arena of the decoder,
+ * which are valid until the next time it decodes.
+ */
+class RowDecoder final {
+public:
+    using Integer = ColumnTypeInfo<ColumnType::Integer>::UnderlyingType;
+    using Float = ColumnTypeInfo<ColumnType::Float>::UnderlyingType;
+
+    enum class FieldType : signed char {
+        Integer = 1,
+        Float,
+        Text,
+        BLOB,
+    };
+    struct Field {
+        Field(int column, size_t offset, FieldType type, ssize_t nullOffset = -1);
+        int column;
+        // offset of the value in the row
+        size_t offset;
+        // offset of a bool in the row that tells whether the column is null, or -1 if it's not required
+        ssize_t nullOffset;
+        FieldType type;
+
+        size_t getSize() const;
+    };
+    typedef struct Field Field;
+
+    // Text is null-terminated in the arena, while the size excludes the terminator.
+    struct Span {
+        const unsigned char *bytes;
+        uint64_t size;
+    };
+    typedef struct Span Span;
+
+    RowDecoder(const std::vector<Field> &fields, size_t rowSize);
+    RowDecoder(const RowDecoder &) = delete;
+    RowDecoder &operator=(const RowDecoder &) = delete;
+
+    static bool isValidField(const Field &field, size_t rowSize);
+
+    const std::vector<Field> &getFields() const;
+    size_t getRowSize() const;
+    // -1 if there is no field.
+    int getMaxColumn() const;
+
+#pragma mark - Decode
+public:
+    // Drop all the decoded bytes but keep the memory.
+    void reset();
+
+    void setNull(void *row, const Field &field);
+    void setInteger(void *row, const Field &field, const Integer &value);
+    void setDouble(void *row, const Field &field, const Float &value);
+    void setBytes(void *row, const Field &field, const void *bytes, size_t size);
+
+    // The spans are pointed to the arena only after all the rows are decoded, since the arena may be moved while growing.
+    void finish();
+
+private:
+    void setNotNull(unsigned char *row, const Field &field);
+
+    std::vector<Field> m_fields;
+    size_t m_rowSize;
+    int m_maxColumn;
+    std::vector<unsigned char> m_bytes;
+    std::vector<std::pair<Span *, uint64_t /* offset */>> m_pendingSpans;
+};
+
+} //namespace WCDB
@@ -25,6 +25,7 @@
 #include "Crawlable.hpp"
 #include "Assertion.hpp"
 #include "Cell.hpp"
+#include "CrawlerPool.hpp"
 #include "Page.hpp"
 #include "Pager.hpp"
 #include "StringView.hpp"
@@ -36,7 +37,11 @@ namespace Repair {
 
 #pragma mark - Initialize
 Crawlable::Crawlable()
-: m_associatedPager(nullptr), m_suspend(false), m_isCrawling(false)
+: m_associatedPager(nullptr)
+, m_numberOfCrawlingWorkers(1)
+, m_crawlerPool(nullptr)
+, m_suspend(false)
+, m_isCrawling(false)
 {
 }
 
@@ -44,7 +49,22 @@ Crawlable::~Crawlable() = default;
 
 void Crawlable::setAssociatedPager(Pager *pager)
 {
+    WCTAssert(!m_isCrawling);
     m_associatedPager = pager;
+    m_crawlerPool = nullptr;
+}
+
+#pragma mark - Parallel
+void Crawlable::setNumberOfCrawlingWorkers(int numberOfWorkers)
+{
+    WCTAssert(!m_isCrawling);
+    m_numberOfCrawlingWorkers = numberOfWorkers;
+    m_crawlerPool = nullptr;
+}
+
+bool Crawlable::isCellOrderRequired() const
+{
+    return true;
 }
 
 void Crawlable::suspend()
@@ -80,6 +100,10 @@ bool Crawlable::crawl(int rootpageno)
     WCTAssert(m_associatedPager != nullptr);
     WCTAssert(!m_isCrawling);
     m_isCrawling = true;
+    if (m_crawlerPool == nullptr && m_numberOfCrawlingWorkers > 1) {
+        m_crawlerPool.reset(
+        new CrawlerPool(*this, *m_associatedPager, m_numberOfCrawlingWorkers));
+    }
     std::set<int> crawledInteriorPages;
     safeCrawl(rootpageno, crawledInteriorPages, 1);
     m_isCrawling = false;
@@ -91,6 +115,9 @@ void Crawlable::safeCrawl(int rootpageno, std::set<int> &crawledInteriorPages, i
     if (m_suspend) {
         return;
     }
+    if (!willReadPage(rootpageno, height)) {
+        return;
+    }
     Page rootpage(rootpageno, m_associatedPager);
     if (!rootpage.initialize()) {
         markAsError();
@@ -107,6 +134,10 @@ void Crawlable::safeCrawl(int rootpageno, std::set<int> &crawledInteriorPages, i
             return;
         }
         crawledInteriorPages.emplace(rootpageno);
+        if (height == 1 && m_crawlerPool != nullptr
+            && m_crawlerPool->crawl(rootpage, height, crawledInteriorPages)) {
+            break;
+        }
         for (int i = 0; i < rootpage.getNumberOfSubpages(); ++i) {
             int pageno = rootpage.getSubpageno(i);
             safeCrawl(pageno, crawledInteriorPages, height + 1);
@@ -134,6 +165,13 @@ void Crawlable::onCellCrawled(const Cell &cell)
     WCDB_UNUSED(cell)
 }
 
+bool Crawlable::willReadPage(int pageno, int height)
+{
+    WCDB_UNUSED(pageno)
+    WCDB_UNUSED(height)
+    return true;
+}
+
 bool Crawlable::willCrawlPage(const Page &page, int height)
 {
     WCDB_UNUSED(page)
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "Pager.hpp"
+#include <memory>
 #include <set>
 
 namespace WCDB {
@@ -32,6 +33,7 @@ namespace WCDB {
 namespace Repair {
 
 class Cell;
+class CrawlerPool;
 class Page;
 class Pager;
 
@@ -46,6 +48,21 @@ public:
 private:
     Pager *m_associatedPager;
 
+#pragma mark - Parallel
+public:
+    // B-tree will be crawled by multiple workers if it's greater than 1, while all the callbacks are serialized.
+    void setNumberOfCrawlingWorkers(int numberOfWorkers);
+
+protected:
+    // Cells are delivered in the order of B-tree, which is the ascending order of rowid, if it's required.
+    // Otherwise, they are delivered as soon as they are crawled by any of the workers.
+    virtual bool isCellOrderRequired() const;
+
+private:
+    friend class CrawlerPool;
+    int m_numberOfCrawlingWorkers;
+    std::unique_ptr<CrawlerPool> m_crawlerPool;
+
 #pragma mark - Suspend
 public:
     void suspend(); // thread-safe
@@ -67,6 +84,8 @@ protected:
     bool crawl(int rootpageno);
 
     virtual void onCellCrawled(const Cell &cell);
+    //return false to skip reading current page, which is already handled by the crawlable
+    virtual bool willReadPage(int pageno, int height);
     //return false to skip current page
     virtual bool willCrawlPage(const Page &page, int height);
     virtual void onCrawlerError();
@@ -0,0 +1,380 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CrawlerPool.hpp"
+#include "Assertion.hpp"
+#include "Cell.hpp"
+#include "CoreConst.h"
+#include "Crawlable.hpp"
+#include "Page.hpp"
+#include "StringView.hpp"
+#include <future>
+#include <thread>
+
+namespace WCDB {
+
+namespace Repair {
+
+#pragma mark - Initialize
+CrawlerPool::CrawlerPool(Crawlable &crawlable, Pager &pager, int numberOfWorkers)
+: m_jobsStopped(false)
+, m_crawlable(crawlable)
+, m_pager(pager)
+, m_numberOfPreparedWorkers(0)
+, m_numberOfPendingTasks(0)
+, m_crawledInteriorPages(nullptr)
+{
+    WCTAssert(numberOfWorkers > 1);
+    for (int i = 0; i < numberOfWorkers; ++i) {
+        m_workers.push_back(std::unique_ptr<Worker>(new Worker));
+    }
+}
+
+CrawlerPool::~CrawlerPool() = default;
+
+CrawlerPool::Task::Task(int pageno_, int height_) : pageno(pageno_), height(height_)
+{
+}
+
+int CrawlerPool::defaultNumberOfWorkers()
+{
+    return std::min((int) std::thread::hardware_concurrency(), RepairMaxNumberOfCrawlingWorkers);
+}
+
+int CrawlerPool::prepareWorkers()
+{
+    // forked pagers are kept for the following crawls
+    while (m_numberOfPreparedWorkers < (int) m_workers.size()) {
+        Worker &worker = *m_workers[m_numberOfPreparedWorkers];
+        worker.pager = m_pager.fork();
+        if (!worker.pager->initialize()) {
+            worker.pager = nullptr;
+            break;
+        }
+        ++m_numberOfPreparedWorkers;
+    }
+    return m_numberOfPreparedWorkers;
+}
+
+#pragma mark - Crawl
+bool CrawlerPool::crawl(const Page &interiorPage, int height, std::set<int> &crawledInteriorPages)
+{
+    WCTAssert(interiorPage.getType() == Page::Type::InteriorTable);
+    int numberOfWorkers = prepareWorkers();
+    if (numberOfWorkers == 0) {
+        return false;
+    }
+    m_crawledInteriorPages = &crawledInteriorPages;
+
+    if (m_crawlable.isCellOrderRequired()) {
+        crawlInOrder(interiorPage, height);
+        m_crawledInteriorPages = nullptr;
+        return true;
+    }
+
+    // distribute the subpages evenly so that all workers can start without stealing
+    for (int i = 0; i < interiorPage.getNumberOfSubpages(); ++i) {
+        pushTask(*m_workers[i % numberOfWorkers],
+                 Task(interiorPage.getSubpageno(i), height + 1));
+    }
+
+    std::vector<std::future<void>> futures;
+    for (int i = 1; i < numberOfWorkers; ++i) {
+        futures.push_back(std::async(std::launch::async, &CrawlerPool::work, this, i));
+    }
+    work(0);
+    for (auto &future : futures) {
+        future.wait();
+    }
+
+    WCTAssert(m_numberOfPendingTasks == 0);
+    m_crawledInteriorPages = nullptr;
+    return true;
+}
+
+void CrawlerPool::work(int index)
+{
+    Task task(0, 0);
+    while (m_numberOfPendingTasks > 0) {
+        if (popTask(index, task)) {
+            crawlPage(*m_workers[index], task);
+            finishTask();
+        } else {
+            std::unique_lock<std::mutex> lockGuard(m_idleLock);
+            if (m_numberOfPendingTasks > 0) {
+                // tasks of other workers may be split later, so wait for a while and retry.
+                m_idle.wait_for(lockGuard, 0.001);
+            }
+        }
+    }
+}
+
+void CrawlerPool::crawlPage(Worker &worker, const Task &task)
+{
+    std::vector<int> subpagenos;
+    std::vector<Cell> cells;
+    std::unique_ptr<Page> page = parsePage(worker, task, subpagenos, cells);
+    for (int subpageno : subpagenos) {
+        pushTask(worker, Task(subpageno, task.height + 1));
+    }
+    if (!cells.empty()) {
+        std::lock_guard<std::mutex> lockGuard(m_sinkLock);
+        for (const auto &cell : cells) {
+            m_crawlable.onCellCrawled(cell);
+        }
+    }
+}
+
+std::unique_ptr<Page> CrawlerPool::parsePage(Worker &worker,
+                                             const Task &task,
+                                             std::vector<int> &subpagenos,
+                                             std::vector<Cell> &cells)
+{
+    if (m_crawlable.m_suspend) {
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lockGuard(m_sinkLock);
+        if (!m_crawlable.willReadPage(task.pageno, task.height)) {
+            return nullptr;
+        }
+    }
+    std::unique_ptr<Page> page(new Page(task.pageno, worker.pager.get()));
+    if (!page->initialize()) {
+        markWorkerAsError(worker);
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lockGuard(m_sinkLock);
+        if (!m_crawlable.willCrawlPage(*page, task.height)) {
+            return nullptr;
+        }
+    }
+    switch (page->getType()) {
+    case Page::Type::InteriorTable:
+        if (!markInteriorPageAsCrawled(task.pageno)) {
+            //avoid dead loop
+            std::lock_guard<std::mutex> lockGuard(m_sinkLock);
+            m_crawlable.markAsCorrupted(task.pageno, "Page is already crawled.");
+            return nullptr;
+        }
+        subpagenos.reserve(page->getNumberOfSubpages());
+        for (int i = 0; i < page->getNumberOfSubpages(); ++i) {
+            subpagenos.push_back(page->getSubpageno(i));
+        }
+        break;
+    case Page::Type::LeafTable:
+        // parse cells outside the sink
+        cells.reserve(page->getNumberOfCells());
+        for (int i = 0; i < page->getNumberOfCells(); ++i) {
+            Cell cell = page->getCell(i);
+            if (cell.initialize()) {
+                cells.push_back(std::move(cell));
+            } else {
+                markWorkerAsError(worker);
+            }
+        }
+        break;
+    default: {
+        std::lock_guard<std::mutex> lockGuard(m_sinkLock);
+        m_crawlable.markAsCorrupted(
+        task.pageno, StringView::formatted("Unexpected page type: %d", page->getType()));
+        return nullptr;
+    }
+    }
+    return page;
+}
+
+void CrawlerPool::markWorkerAsError(Worker &worker)
+{
+    std::lock_guard<std::mutex> lockGuard(m_sinkLock);
+    m_pager.mergeError(worker.pager->getError());
+    m_crawlable.markAsError();
+}
+
+bool CrawlerPool::markInteriorPageAsCrawled(int pageno)
+{
+    WCTAssert(m_crawledInteriorPages != nullptr);
+    std::lock_guard<std::mutex> lockGuard(m_crawledLock);
+    return m_crawledInteriorPages->emplace(pageno).second;
+}
+
+#pragma mark - Crawl In Order
+CrawlerPool::Job::Job(int pageno, int height)
+: task(pageno, height), submitted(false), taken(false), done(false)
+{
+}
+
+void CrawlerPool::crawlInOrder(const Page &interiorPage, int height)
+{
+    // The pending pages are kept in the order of B-tree.
+    // The ones within the window are submitted so that workers read them ahead.
+    std::deque<SharedJob> jobs;
+    for (int i = 0; i < interiorPage.getNumberOfSubpages(); ++i) {
+        jobs.push_back(std::make_shared<Job>(interiorPage.getSubpageno(i), height + 1));
+    }
+    size_t window = (size_t) m_numberOfPreparedWorkers * RepairNumberOfReadAheadPagesPerWorker;
+
+    m_jobsStopped = false;
+    std::vector<std::future<void>> futures;
+    for (int i = 1; i < m_numberOfPreparedWorkers; ++i) {
+        futures.push_back(std::async(std::launch::async, &CrawlerPool::workInOrder, this, i));
+    }
+    while (!jobs.empty()) {
+        for (size_t i = 0; i < std::min(jobs.size(), window); ++i) {
+            if (!jobs[i]->submitted) {
+                jobs[i]->submitted = true;
+                submitJob(jobs[i]);
+            }
+        }
+        SharedJob job = jobs.front();
+        jobs.pop_front();
+        waitJob(0, *job);
+        if (!job->cells.empty()) {
+            std::lock_guard<std::mutex> lockGuard(m_sinkLock);
+            for (const auto &cell : job->cells) {
+                m_crawlable.onCellCrawled(cell);
+            }
+        }
+        // depth-first
+        for (auto iter = job->subpagenos.rbegin(); iter != job->subpagenos.rend(); ++iter) {
+            jobs.push_front(std::make_shared<Job>(*iter, job->task.height + 1));
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lockGuard(m_jobLock);
+        m_jobsStopped = true;
+        m_submittedJobs.clear();
+    }
+    m_jobChanged.notify_all();
+    for (auto &future : futures) {
+        future.wait();
+    }
+}
+
+void CrawlerPool::workInOrder(int index)
+{
+    while (true) {
+        SharedJob job;
+        {
+            std::unique_lock<std::mutex> lockGuard(m_jobLock);
+            while (m_submittedJobs.empty() && !m_jobsStopped) {
+                m_jobChanged.wait(lockGuard);
+            }
+            if (m_jobsStopped) {
+                break;
+            }
+            job = m_submittedJobs.front();
+            m_submittedJobs.pop_front();
+            if (job->taken) {
+                continue;
+            }
+            job->taken = true;
+        }
+        runJob(*m_workers[index], *job);
+    }
+}
+
+void CrawlerPool::submitJob(const SharedJob &job)
+{
+    {
+        std::lock_guard<std::mutex> lockGuard(m_jobLock);
+        m_submittedJobs.push_back(job);
+    }
+    m_jobChanged.notify_one();
+}
+
+void CrawlerPool::waitJob(int index, Job &job)
+{
+    {
+        std::unique_lock<std::mutex> lockGuard(m_jobLock);
+        if (job.taken) {
+            while (!job.done) {
+                m_jobChanged.wait(lockGuard);
+            }
+            return;
+        }
+        job.taken = true;
+    }
+    runJob(*m_workers[index], job);
+}
+
+void CrawlerPool::runJob(Worker &worker, Job &job)
+{
+    job.page = parsePage(worker, job.task, job.subpagenos, job.cells);
+    {
+        std::lock_guard<std::mutex> lockGuard(m_jobLock);
+        job.done = true;
+    }
+    m_jobChanged.notify_all();
+}
+
+#pragma mark - Task
+void CrawlerPool::pushTask(Worker &worker, const Task &task)
+{
+    ++m_numberOfPendingTasks;
+    {
+        std::lock_guard<std::mutex> lockGuard(worker.lock);
+        worker.tasks.push_back(task);
+    }
+    m_idle.notify_one();
+}
+
+bool CrawlerPool::popTask(int index, Task &task)
+{
+    int numberOfWorkers = m_numberOfPreparedWorkers;
+    // Own tasks are popped in LIFO order to crawl depth-first, which keeps the page cache hot.
+    {
+        Worker &worker = *m_workers[index];
+        std::lock_guard<std::mutex> lockGuard(worker.lock);
+        if (!worker.tasks.empty()) {
+            task = worker.tasks.back();
+            worker.tasks.pop_back();
+            return true;
+        }
+    }
+    // Tasks of others are stolen in FIFO order, which are always the largest subtrees.
+    for (int i = 1; i < numberOfWorkers; ++i) {
+        Worker &victim = *m_workers[(index + i) % numberOfWorkers];
+        std::lock_guard<std::mutex> lockGuard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void CrawlerPool::finishTask()
+{
+    if (--m_numberOfPendingTasks == 0) {
+        std::lock_guard<std::mutex> lockGuard(m_idleLock);
+        m_idle.notify_all();
+    }
+}
+
+} //namespace Repair
+
+} //namespace WCDB
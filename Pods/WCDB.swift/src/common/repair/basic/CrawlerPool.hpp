@@ -0,0 +1,133 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Cell.hpp"
+#include "Lock.hpp"
+#include "Pager.hpp"
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace WCDB {
+
+namespace Repair {
+
+class Crawlable;
+class Page;
+
+// Workers crawl the subtrees of an interior page in parallel.
+// Each worker reads pages through its own forked pager and steals tasks from others when it's idle.
+// If the order of cells is required, workers read ahead of the current page instead,
+// while the cells are delivered in the order of B-tree by the crawling thread.
+// All the callbacks of crawlable are serialized.
+class CrawlerPool final {
+public:
+    CrawlerPool(Crawlable &crawlable, Pager &pager, int numberOfWorkers);
+    ~CrawlerPool();
+
+    CrawlerPool() = delete;
+    CrawlerPool(const CrawlerPool &) = delete;
+    CrawlerPool &operator=(const CrawlerPool &) = delete;
+
+    // min(number of cores, RepairMaxNumberOfCrawlingWorkers)
+    static int defaultNumberOfWorkers();
+
+    // Crawl the subpages of the interior page, which is already accepted by the crawlable.
+    // Return false if no worker is available.
+    bool crawl(const Page &interiorPage, int height, std::set<int> &crawledInteriorPages);
+
+protected:
+    struct Task {
+        Task(int pageno, int height);
+        int pageno;
+        int height;
+    };
+    struct Worker {
+        std::unique_ptr<Pager> pager;
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+    int prepareWorkers();
+    void work(int index);
+    void crawlPage(Worker &worker, const Task &task);
+    // Return the page if it's accepted by the crawlable, with the subpages of interior page or the initialized cells of leaf page.
+    std::unique_ptr<Page>
+    parsePage(Worker &worker, const Task &task, std::vector<int> &subpagenos, std::vector<Cell> &cells);
+
+    void pushTask(Worker &worker, const Task &task);
+    bool popTask(int index, Task &task);
+    void finishTask();
+
+    struct Job {
+        Job(int pageno, int height);
+        Task task;
+        // accessed by the crawling thread only
+        bool submitted;
+        // guarded by the job lock
+        bool taken;
+        bool done;
+        // cells refer to the page
+        std::unique_ptr<Page> page;
+        std::vector<int> subpagenos;
+        std::vector<Cell> cells;
+    };
+    typedef std::shared_ptr<Job> SharedJob;
+    void crawlInOrder(const Page &interiorPage, int height);
+    void workInOrder(int index);
+    void submitJob(const SharedJob &job);
+    // Run it by the worker if it's not taken yet. Otherwise, wait until it's done.
+    void waitJob(int index, Job &job);
+    void runJob(Worker &worker, Job &job);
+
+    std::mutex m_jobLock;
+    Conditional m_jobChanged;
+    std::deque<SharedJob> m_submittedJobs;
+    bool m_jobsStopped;
+
+    bool markInteriorPageAsCrawled(int pageno);
+    void markWorkerAsError(Worker &worker);
+
+    Crawlable &m_crawlable;
+    Pager &m_pager;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    int m_numberOfPreparedWorkers;
+
+    std::atomic<int> m_numberOfPendingTasks;
+    std::mutex m_idleLock;
+    Conditional m_idle;
+
+    std::mutex m_crawledLock;
+    std::set<int> *m_crawledInteriorPages;
+
+    // serialize all callbacks of crawlable
+    std::mutex m_sinkLock;
+};
+
+} //namespace Repair
+
+} //namespace WCDB
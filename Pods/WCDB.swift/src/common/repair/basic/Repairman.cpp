@@ -37,7 +37,11 @@ namespace Repair {
 
 #pragma mark - Initialize
 Repairman::Repairman(const UnsafeStringView &path)
-: Crawlable(), Progress(), m_pager(path), m_milestone(1000), m_mile(0)
+: Crawlable()
+, Progress()
+, m_pager(path)
+, m_milestone(RepairInitialNumberOfCellsPerMilestone)
+, m_mile(0)
 {
     setAssociatedPager(&m_pager);
 }
@@ -102,8 +106,12 @@ bool Repairman::markAsMilestone()
     m_mile = 0;
     if (m_assembleDelegate->markAsMilestone()) {
         markSegmentedScoreCounted();
+        // Each milestone is a commit. Grow it while committing goes well to reduce the cost of syncing,
+        // and shrink it back after failure so that less score is dropped next time.
+        m_milestone = std::min(m_milestone * 2, RepairMaxNumberOfCellsPerMilestone);
         return true;
     }
+    m_milestone = RepairInitialNumberOfCellsPerMilestone;
     markSegmentedScoreDropped();
     tryUpgrateAssembleError();
     return false;
@@ -25,6 +25,7 @@
 #include "FullCrawler.hpp"
 #include "Assemble.hpp"
 #include "Assertion.hpp"
+#include "CrawlerPool.hpp"
 #include "MasterItem.hpp"
 #include "Page.hpp"
 #include "SequenceCrawler.hpp"
@@ -42,6 +43,7 @@ FullCrawler::FullCrawler(const UnsafeStringView &source)
 {
     m_sequenceCrawler.setAssociatedPager(&m_pager);
     m_masterCrawler.setAssociatedPager(&m_pager);
+    setNumberOfCrawlingWorkers(CrawlerPool::defaultNumberOfWorkers());
 }
 
 FullCrawler::~FullCrawler() = default;
@@ -25,6 +25,7 @@
 #include "Factory.hpp"
 #include "Assemble.hpp"
 #include "Assertion.hpp"
+#include "CoreConst.h"
 #include "FileManager.hpp"
 #include "Material.hpp"
 #include "Path.hpp"
@@ -37,7 +38,9 @@ namespace Repair {
 
 #pragma mark - Factory
 Factory::Factory(const UnsafeStringView &database_)
-: database(database_), directory(factoryPathForDatabase(database_))
+: database(database_)
+, directory(factoryPathForDatabase(database_))
+, m_numberOfIncrementalBackups(RepairMaxNumberOfIncrementalBackups)
 {
 }
 
@@ -114,6 +117,21 @@ Factory::Filter Factory::getFilter() const
     return m_filter;
 }
 
+#pragma mark - Incremental Backup
+bool Factory::shouldBackupIncrementally() const
+{
+    return m_numberOfIncrementalBackups < RepairMaxNumberOfIncrementalBackups;
+}
+
+void Factory::markAsBackedUp(bool incremental) const
+{
+    if (incremental) {
+        ++m_numberOfIncrementalBackups;
+    } else {
+        m_numberOfIncrementalBackups = 0;
+    }
+}
+
 FactoryDepositor Factory::depositor() const
 {
     return FactoryDepositor(*this);
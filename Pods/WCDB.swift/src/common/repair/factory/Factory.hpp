@@ -31,6 +31,7 @@
 #include "StringView.hpp"
 #include "Time.hpp"
 #include "WCDBOptional.hpp"
+#include <atomic>
 #include <future>
 #include <list>
 
@@ -74,6 +75,15 @@ public:
 protected:
     Filter m_filter;
 
+#pragma mark - Incremental Backup
+public:
+    // The first backup and the one after every `RepairMaxNumberOfIncrementalBackups` incremental backups crawl the whole database.
+    bool shouldBackupIncrementally() const;
+    void markAsBackedUp(bool incremental) const;
+
+protected:
+    mutable std::atomic<int> m_numberOfIncrementalBackups;
+
 #pragma mark - Helper
 public:
     static std::list<StringView>
@@ -50,6 +50,9 @@ bool FactoryBackup::work(const UnsafeStringView& database)
     backup.setBackupSharedDelegate(m_sharedDelegate);
     backup.setBackupExclusiveDelegate(m_exclusiveDelegate);
     backup.filter(factory.getFilter());
+    if (factory.shouldBackupIncrementally()) {
+        loadBaseMaterial(database, backup);
+    }
     if (!backup.work()) {
         // Treat database empty error as succeed
         if (backup.getError().code() == Error::Code::Empty) {
@@ -78,10 +81,31 @@ bool FactoryBackup::work(const UnsafeStringView& database)
             return false;
         }
     }
+    factory.markAsBackedUp(backup.isIncremental());
     notifiyBackupEnd(database, materialPath.value(), backup);
     return true;
 }
 
+void FactoryBackup::loadBaseMaterial(const UnsafeStringView& database, Backup& backup)
+{
+    // The newest material is the base one, while the new material will be serialized to the other one.
+    auto materialPaths = Factory::materialsForDeserializingForDatabase(database);
+    if (!materialPaths.succeed() || materialPaths.value().empty()) {
+        return;
+    }
+    Material material;
+    bool succeed;
+    if (!m_sharedDelegate->isCipherDB()) {
+        succeed = material.deserialize(materialPaths.value().front());
+    } else {
+        material.setCipherDelegate(m_cipherDelegate);
+        succeed = material.decryptedDeserialize(materialPaths.value().front());
+    }
+    if (succeed) {
+        backup.setBaseMaterial(material);
+    }
+}
+
 void FactoryBackup::notifiyBackupBegin(const UnsafeStringView& database)
 {
     Error error(Error::Code::Notice, Error::Level::Notice, "Backup Begin.");
@@ -107,6 +131,12 @@ void FactoryBackup::notifiyBackupEnd(const UnsafeStringView& database,
         error.infos.insert_or_assign("TableCount", backup.getMaterial().contents.size());
         error.infos.insert_or_assign("AssociatedTableCount", associatedTableCount);
         error.infos.insert_or_assign("LeafPageCount", leafPageCount);
+        error.infos.insert_or_assign("Incremental", backup.isIncremental());
+        error.infos.insert_or_assign("ReusedPageCount", backup.getNumberOfReusedPages());
+        error.infos.insert_or_assign(
+        "ReusedSize", (int64_t) backup.getNumberOfReusedPages() * backup.getMaterial().info.pageSize);
+        // read but unchanged since the base material, which could be reused if the wal were not restarted
+        error.infos.insert_or_assign("UnchangedPageCount", backup.getNumberOfUnchangedPages());
         error.infos.insert_or_assign(ErrorStringKeyPath, database);
         Notifier::shared().notify(error);
     }
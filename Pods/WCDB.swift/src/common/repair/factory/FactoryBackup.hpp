@@ -44,6 +44,9 @@ public:
     void notifiyBackupEnd(const UnsafeStringView& database,
                           const UnsafeStringView& materialPath,
                           Backup& backup);
+
+protected:
+    void loadBaseMaterial(const UnsafeStringView& database, Backup& backup);
 };
 
 } //namespace Repair
@@ -26,6 +26,7 @@
 #include "Assertion.hpp"
 #include "Cell.hpp"
 #include "CoreConst.h"
+#include "CrawlerPool.hpp"
 #include "FileManager.hpp"
 #include "MasterItem.hpp"
 #include "Notifier.hpp"
@@ -82,9 +83,17 @@ bool BackupDelegateHolder::isDelegateValid() const
 
 #pragma mark - Initialize
 Backup::Backup(const UnsafeStringView &path)
-: Crawlable(), m_pager(path), m_masterCrawler()
+: Crawlable()
+, m_pager(path)
+, m_baseChecksumAlgorithm(Checksum::Algorithm::CRC32)
+, m_baseComparable(false)
+, m_incremental(false)
+, m_numberOfReusedPages(0)
+, m_numberOfUnchangedPages(0)
+, m_masterCrawler()
 {
     setAssociatedPager(&m_pager);
+    setNumberOfCrawlingWorkers(CrawlerPool::defaultNumberOfWorkers());
     m_masterCrawler.setAssociatedPager(&m_pager);
 }
 
@@ -144,6 +153,7 @@ bool Backup::work()
             m_material.info.walSalt = m_pager.getWalSalt();
             m_material.info.numberOfWalFrames = m_pager.getNumberOfWalFrames();
         }
+        m_incremental = canBackupIncrementally();
         succeed = m_masterCrawler.work(this);
     } while (false);
 
@@ -175,6 +185,67 @@ Material::Content &Backup::getOrCreateContent(const UnsafeStringView &tableName)
     return iter->second;
 }
 
+#pragma mark - Incremental
+void Backup::setBaseMaterial(const Material &material)
+{
+    m_baseInfo = material.info;
+    m_baseChecksumAlgorithm = material.checksumAlgorithm;
+    VerifiedPagenos::Builder builder;
+    for (const auto &content : material.contents) {
+        for (const auto &element : content.second.verifiedPagenos) {
+            builder.append(element.first, element.second);
+        }
+    }
+    builder.build(m_baseVerifiedPagenos);
+}
+
+bool Backup::isIncremental() const
+{
+    return m_incremental;
+}
+
+int Backup::getNumberOfReusedPages() const
+{
+    return m_numberOfReusedPages;
+}
+
+int Backup::getNumberOfUnchangedPages() const
+{
+    return m_numberOfUnchangedPages;
+}
+
+bool Backup::canBackupIncrementally()
+{
+    WCTAssert(m_pager.isInitialized());
+    m_baseComparable = !m_baseVerifiedPagenos.empty()
+                       && m_baseChecksumAlgorithm == m_material.checksumAlgorithm
+                       && m_baseInfo.pageSize == m_material.info.pageSize
+                       && m_baseInfo.reservedBytes == m_material.info.reservedBytes;
+    if (!m_baseComparable) {
+        return false;
+    }
+    // All the pages are changed through the wal frames, and the frames are appended until the wal is restarted with a new salt.
+    // So the pages that are not in the frames after the base one must be the same as before.
+    // Otherwise, the leaf pages are compared with the base one by one while they are crawled.
+    if (m_baseInfo.numberOfWalFrames == 0 || m_baseInfo.walSalt != m_material.info.walSalt
+        || m_baseInfo.numberOfWalFrames > m_material.info.numberOfWalFrames) {
+        return false;
+    }
+    m_changedPagenos = m_pager.getWalPagesChangedAfterFrame((int) m_baseInfo.numberOfWalFrames);
+    return true;
+}
+
+void Backup::compareWithBase(int pageno, uint32_t hash)
+{
+    if (!m_baseComparable) {
+        return;
+    }
+    auto baseHash = m_baseVerifiedPagenos.find(pageno);
+    if (baseHash.succeed() && baseHash.value() == hash) {
+        ++m_numberOfUnchangedPages;
+    }
+}
+
 #pragma mark - Filter
 void Backup::filter(const Filter &tableShouldBeBackedUp)
 {
@@ -197,6 +268,28 @@ void Backup::onCellCrawled(const Cell &cell)
     WCTAssert(false);
 }
 
+// Only the pagenos of leaf pages are collected, whose order doesn't matter.
+bool Backup::isCellOrderRequired() const
+{
+    return false;
+}
+
+bool Backup::willReadPage(int pageno, int height)
+{
+    WCDB_UNUSED(height)
+    if (!m_incremental || m_changedPagenos.find(pageno) != m_changedPagenos.end()) {
+        return true;
+    }
+    auto hash = m_baseVerifiedPagenos.find(pageno);
+    if (!hash.succeed()) {
+        return true;
+    }
+    // It's an unchanged leaf page.
+    m_verifiedPagenos.append(pageno, hash.value());
+    ++m_numberOfReusedPages;
+    return false;
+}
+
 bool Backup::willCrawlPage(const Page &page, int height)
 {
     if (m_exclusiveDelegate->backupSuspended()) {
@@ -208,11 +301,9 @@ bool Backup::willCrawlPage(const Page &page, int height)
     case Page::Type::InteriorTable:
         return true;
     case Page::Type::LeafTable: {
-        bool emplaced
-        = m_verifiedPagenos.emplace(page.number, page.getData().hash()).second;
-        if (!emplaced) {
-            markAsCorrupted(page.number, "Page is already crawled.");
-        }
+        uint32_t hash = page.getData().hash(m_material.checksumAlgorithm);
+        compareWithBase(page.number, hash);
+        m_verifiedPagenos.append(page.number, hash);
         return false;
     }
     default:
@@ -242,9 +333,14 @@ void Backup::onMasterCellCrawled(const Cell &cell, const MasterItem &master)
         if (master.type.caseInsensitiveEqual("table")
             && master.name.caseInsensitiveEqual(master.tableName)) {
             if (!crawl(master.rootpage)) {
+                m_verifiedPagenos.clear();
+                return;
+            }
+            uint32_t duplicated = m_verifiedPagenos.build(content.verifiedPagenos);
+            if (duplicated != 0) {
+                markAsCorrupted(duplicated, "Page is already crawled.");
                 return;
             }
-            content.verifiedPagenos = std::move(m_verifiedPagenos);
             content.sql = master.sql;
         } else {
             if (!master.sql.empty()) {
@@ -28,6 +28,7 @@
 #include "MasterCrawler.hpp"
 #include "Material.hpp"
 #include "SequenceCrawler.hpp"
+#include <set>
 #include <vector>
 
 namespace WCDB {
@@ -105,7 +106,33 @@ public:
 protected:
     Material m_material;
     Material::Content &getOrCreateContent(const UnsafeStringView &tableName);
-    std::map<uint32_t, uint32_t> m_verifiedPagenos;
+    VerifiedPagenos::Builder m_verifiedPagenos;
+
+#pragma mark - Incremental
+public:
+    // The leaf pages that are not changed since the base material will not be read again, while their hashes are reused.
+    // It takes effect only when the wal is not restarted since the base material was made.
+    // Since the backup is triggered by checkpoint, the wal is usually restarted with a new salt in the meantime,
+    // and the pages changed in the previous wal can't be told any more.
+    // In that case, all the leaf pages are read and compared with the hashes of base material instead,
+    // so that the number of unchanged pages measures how many pages could be reused.
+    void setBaseMaterial(const Material &material);
+    bool isIncremental() const;
+    int getNumberOfReusedPages() const;
+    int getNumberOfUnchangedPages() const;
+
+protected:
+    bool canBackupIncrementally();
+    void compareWithBase(int pageno, uint32_t hash);
+    Material::Info m_baseInfo;
+    Checksum::Algorithm m_baseChecksumAlgorithm;
+    // all the leaf pages in base material
+    VerifiedPagenos m_baseVerifiedPagenos;
+    bool m_baseComparable;
+    std::set<int> m_changedPagenos;
+    bool m_incremental;
+    int m_numberOfReusedPages;
+    int m_numberOfUnchangedPages;
 
 #pragma mark - Filter
 public:
@@ -119,8 +146,10 @@ protected:
 #pragma mark - Crawlable
 protected:
     void onCellCrawled(const Cell &cell) override final;
+    bool willReadPage(int pageno, int height) override final;
     bool willCrawlPage(const Page &page, int height) override final;
     void onCrawlerError() override final;
+    bool isCellOrderRequired() const override final;
 
 #pragma mark - MasterCrawlerDelegate
 protected:
@@ -33,22 +33,28 @@
 #include "Serialization.hpp"
 #include "WCDBError.hpp"
 #include <cstring>
+#include <limits>
 
 namespace WCDB {
 
 namespace Repair {
 
+Material::Material() : checksumAlgorithm(Checksum::defaultAlgorithm())
+{
+}
+
 Material::~Material() = default;
 
 #pragma mark - Serialization
 bool Material::serialize(Serialization &serialization) const
 {
     //Header
-    if (!serialization.expand(Material::headerSize)) {
+    if (!serialization.expand(Material::headerSize + sizeof(uint32_t))) {
         return false;
     }
     serialization.put4BytesUInt(magic);
     serialization.put4BytesUInt(version);
+    serialization.put4BytesUInt((uint32_t) checksumAlgorithm);
 
     //Info
     if (!info.serialize(serialization)) {
@@ -77,9 +83,9 @@ bool Material::serialize(Serialization &serialization) const
     return serializeData(serialization, encoder.finalize());
 }
 
-bool Material::serializeData(Serialization &serialization, const Data &data)
+bool Material::serializeData(Serialization &serialization, const Data &data) const
 {
-    uint32_t checksum = data.empty() ? 0 : data.hash();
+    uint32_t checksum = data.empty() ? 0 : data.hash(checksumAlgorithm);
     return serialization.put4BytesUInt(checksum) && serialization.putSizedData(data);
 }
 
@@ -196,7 +202,20 @@ bool Material::deserialize(Deserialization &deserialization)
         markAsCorrupt("Magic");
         return false;
     }
-    if (versionValue != 0x01000000) {
+    if (versionValue == Material::versionWithoutChecksumAlgorithm) {
+        checksumAlgorithm = Checksum::Algorithm::CRC32;
+    } else if (versionValue == Material::versionWithPairedVerifiedPagenos
+               || versionValue == Material::version) {
+        if (!deserialization.canAdvance(sizeof(uint32_t))) {
+            markAsCorrupt("Header");
+            return false;
+        }
+        checksumAlgorithm = (Checksum::Algorithm) deserialization.advance4BytesUInt();
+        if (!Checksum::isValid(checksumAlgorithm)) {
+            markAsCorrupt("Checksum Algorithm");
+            return false;
+        }
+    } else {
         markAsCorrupt("Version");
         return false;
     }
@@ -222,7 +241,7 @@ bool Material::deserialize(Deserialization &deserialization)
         }
 
         Content content;
-        if (!content.deserialize(decoder)) {
+        if (!content.deserialize(decoder, versionValue)) {
             return false;
         }
         contents[std::move(tableName)] = std::move(content);
@@ -230,7 +249,7 @@ bool Material::deserialize(Deserialization &deserialization)
     return true;
 }
 
-Optional<Data> Material::deserializeData(Deserialization &deserialization)
+Optional<Data> Material::deserializeData(Deserialization &deserialization) const
 {
     if (!deserialization.canAdvance(sizeof(uint32_t))) {
         markAsCorrupt("Checksum");
@@ -245,7 +264,7 @@ Optional<Data> Material::deserializeData(Deserialization &deserialization)
     Data data;
     if (!intermediate.second.empty()) {
         data = intermediate.second;
-        if (checksum != data.hash()) {
+        if (checksum != data.hash(checksumAlgorithm)) {
             markAsCorrupt("Checksum");
             return NullOpt;
         }
@@ -306,15 +325,21 @@ bool Material::decryptedDeserialize(const UnsafeStringView &path)
         return false;
     }
 
-    unsigned char *rawAdder = rawData.buffer();
+    // All the pages are decrypted in one batch and then the reserved bytes are stripped.
+    Data pages(rawData.size());
+    if (pages.size() != rawData.size()) {
+        return false;
+    }
+    int numberOfDecryptedPages
+    = sqlite3CodecDecryptPages(pCodec, rawData.buffer(), pages.buffer(), 1, pageCount);
+    if (numberOfDecryptedPages != pageCount) {
+        markAsCorrupt(StringView::formatted("Page %d", numberOfDecryptedPages + 1));
+        return false;
+    }
+
+    const unsigned char *pData = pages.buffer();
     unsigned char *dataAdder = decryptData.buffer();
     for (int pageNo = 1; pageNo <= pageCount; pageNo++) {
-        unsigned char *pData
-        = (unsigned char *) sqlite3Codec(pCodec, rawAdder, pageNo, 4);
-        if (pData == nullptr) {
-            markAsCorrupt(StringView::formatted("Page %d", pageNo));
-            return false;
-        }
         if (pageNo == 1) {
             memcpy(dataAdder, pData + saltBytes, usableSize - saltBytes);
             dataAdder += usableSize - saltBytes;
@@ -322,7 +347,7 @@ bool Material::decryptedDeserialize(const UnsafeStringView &path)
             memcpy(dataAdder, pData, usableSize);
             dataAdder += usableSize;
         }
-        rawAdder += pageSize;
+        pData += pageSize;
     }
     if (!deserialize(decryptData)) {
         return false;
@@ -404,17 +429,24 @@ bool Material::Content::serialize(Serialization &serialization) const
     if (!serialization.putVarint(verifiedPagenos.size())) {
         return false;
     }
-    for (const auto &element : verifiedPagenos) {
-        if (!serialization.putVarint(element.first)
-            || !serialization.put4BytesUInt(element.second)) {
-            return false;
-        }
+    const auto &hashes = verifiedPagenos.getHashes();
+    const auto &deltas = verifiedPagenos.getDeltas();
+    if (!serialization.expand(hashes.size() * sizeof(uint32_t))) {
+        return false;
     }
-    return true;
+    for (const auto &hash : hashes) {
+        serialization.put4BytesUInt(hash);
+    }
+    return serialization.putSizedData(UnsafeData::immutable(deltas.data(), deltas.size()));
 }
 
 #pragma mark - Deserialization
 bool Material::Content::deserialize(Deserialization &deserialization)
+{
+    return deserialize(deserialization, Material::version);
+}
+
+bool Material::Content::deserialize(Deserialization &deserialization, uint32_t materialVersion)
 {
     size_t lengthOfVarint;
     uint64_t varint;
@@ -459,10 +491,46 @@ bool Material::Content::deserialize(Deserialization &deserialization)
         markAsCorrupt("NumberOfPages");
         return false;
     }
-    verifiedPagenos.clear();
+    if (materialVersion == Material::version) {
+        return deserializeVerifiedPagenos(deserialization, numberOfPages);
+    }
+    return deserializePairedVerifiedPagenos(deserialization, numberOfPages);
+}
+
+bool Material::Content::deserializeVerifiedPagenos(Deserialization &deserialization, int numberOfPages)
+{
+    if (!deserialization.canAdvance(numberOfPages * sizeof(uint32_t))) {
+        markAsCorrupt("PageChecksum");
+        return false;
+    }
+    std::vector<uint32_t> hashes;
+    hashes.reserve(numberOfPages);
+    for (int i = 0; i < numberOfPages; ++i) {
+        hashes.push_back(deserialization.advance4BytesUInt());
+    }
+    auto sizedDeltas = deserialization.advanceSizedData();
+    if (sizedDeltas.first == 0) {
+        markAsCorrupt("Pageno");
+        return false;
+    }
+    const UnsafeData &data = sizedDeltas.second;
+    std::vector<unsigned char> deltas(data.buffer(), data.buffer() + data.size());
+    if (!verifiedPagenos.reset(std::move(hashes), std::move(deltas))) {
+        markAsCorrupt("Pageno");
+        return false;
+    }
+    return true;
+}
+
+bool Material::Content::deserializePairedVerifiedPagenos(Deserialization &deserialization,
+                                                         int numberOfPages)
+{
+    VerifiedPagenos::Builder builder;
     for (int i = 0; i < numberOfPages; ++i) {
+        size_t lengthOfVarint;
+        uint64_t varint;
         std::tie(lengthOfVarint, varint) = deserialization.advanceVarint();
-        if (lengthOfVarint == 0) {
+        if (lengthOfVarint == 0 || varint > std::numeric_limits<uint32_t>::max()) {
             markAsCorrupt("Pageno");
             return false;
         }
@@ -471,8 +539,9 @@ bool Material::Content::deserialize(Deserialization &deserialization)
             return false;
         }
         uint32_t checksum = deserialization.advance4BytesUInt();
-        verifiedPagenos[(uint32_t) varint] = checksum;
+        builder.append((uint32_t) varint, checksum);
     }
+    builder.build(verifiedPagenos);
     return true;
 }
 
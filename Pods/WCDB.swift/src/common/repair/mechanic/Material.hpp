@@ -24,9 +24,11 @@
 
 #pragma once
 
+#include "Checksum.hpp"
 #include "Cipher.hpp"
 #include "Serialization.hpp"
 #include "StringView.hpp"
+#include "VerifiedPagenos.hpp"
 #include "WCDBOptional.hpp"
 #include <list>
 #include <map>
@@ -48,10 +50,11 @@ public:
     bool encryptedSerialize(const UnsafeStringView &path, const UnsafeStringView &salt) const;
     using Serializable::serialize;
 
+    Material();
     ~Material() override final;
 
 protected:
-    static bool serializeData(Serialization &serialization, const Data &data);
+    bool serializeData(Serialization &serialization, const Data &data) const;
     static void markAsEmpty(const UnsafeStringView &element);
 
 #pragma mark - Deserializable
@@ -61,16 +64,25 @@ public:
     using Deserializable::deserialize;
 
 protected:
-    static Optional<Data> deserializeData(Deserialization &deserialization);
+    Optional<Data> deserializeData(Deserialization &deserialization) const;
     static void markAsCorrupt(const UnsafeStringView &element);
 
 #pragma mark - Header
 protected:
     static constexpr const uint32_t magic = 0x57434442;
-    static constexpr const uint32_t version = 0x01000000; //1.0.0.0
+    static constexpr const uint32_t version = 0x01020000; //1.2.0.0
+    // Materials of 1.0.0.0 have no checksum algorithm in the header and are always verified by CRC32.
+    static constexpr const uint32_t versionWithoutChecksumAlgorithm = 0x01000000; //1.0.0.0
+    // Materials of 1.1.0.0 serialize the verified pagenos as pairs of pageno and hash.
+    static constexpr const uint32_t versionWithPairedVerifiedPagenos = 0x01010000; //1.1.0.0
     static constexpr const uint8_t saltBytes = 16;
     static constexpr const int headerSize = sizeof(magic) + sizeof(version); //magic + version
 
+#pragma mark - Checksum
+public:
+    // It's used for both the pages and the contents of material.
+    Checksum::Algorithm checksumAlgorithm;
+
 #pragma mark - Info
 public:
     class Info final : public Serializable, public Deserializable {
@@ -104,13 +116,18 @@ public:
         StringView sql;
         std::list<StringView> associatedSQLs;
         int64_t sequence;
-        std::map<uint32_t, uint32_t> verifiedPagenos;
+        VerifiedPagenos verifiedPagenos;
 #pragma mark - Serializable
     public:
         bool serialize(Serialization &serialization) const override final;
 #pragma mark - Deserializable
     public:
         bool deserialize(Deserialization &deserialization) override final;
+        bool deserialize(Deserialization &deserialization, uint32_t materialVersion);
+
+    protected:
+        bool deserializePairedVerifiedPagenos(Deserialization &deserialization, int numberOfPages);
+        bool deserializeVerifiedPagenos(Deserialization &deserialization, int numberOfPages);
     };
 
     StringViewMap<Content> contents;
@@ -160,10 +160,11 @@ bool Mechanic::willCrawlPage(const Page &page, int)
                         "Unexpected page type: %d.", page.getType(), page.getType()));
         return false;
     }
-    if (page.getData().hash() != m_checksum) {
+    uint32_t checksum = page.getData().hash(m_material->checksumAlgorithm);
+    if (checksum != m_checksum) {
         markAsCorrupted(page.number,
                         StringView::formatted(
-                        "Mismatched hash: %u for %u.", page.getData().hash(), m_checksum));
+                        "Mismatched hash: %u for %u.", checksum, m_checksum));
         return false;
     }
     markPageAsCounted(page);
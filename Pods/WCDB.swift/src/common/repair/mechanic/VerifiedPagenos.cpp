@@ -0,0 +1,257 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VerifiedPagenos.hpp"
+#include "Assertion.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace WCDB {
+
+namespace Repair {
+
+#pragma mark - Initialize
+VerifiedPagenos::VerifiedPagenos() = default;
+
+VerifiedPagenos::~VerifiedPagenos() = default;
+
+size_t VerifiedPagenos::size() const
+{
+    return m_hashes.size();
+}
+
+bool VerifiedPagenos::empty() const
+{
+    return m_hashes.empty();
+}
+
+void VerifiedPagenos::putVarint(std::vector<unsigned char> &buffer, uint32_t value)
+{
+    while (value >= 0x80) {
+        buffer.push_back((unsigned char) ((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back((unsigned char) value);
+}
+
+bool VerifiedPagenos::getVarint(const std::vector<unsigned char> &buffer,
+                                size_t &offset,
+                                uint32_t &value)
+{
+    uint64_t result = 0;
+    for (int shift = 0; shift < 35 && offset < buffer.size(); shift += 7) {
+        unsigned char byte = buffer[offset++];
+        result |= (uint64_t) (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            if (result > std::numeric_limits<uint32_t>::max()) {
+                return false;
+            }
+            value = (uint32_t) result;
+            return true;
+        }
+    }
+    return false;
+}
+
+#pragma mark - Find
+Optional<uint32_t> VerifiedPagenos::find(uint32_t pageno) const
+{
+    auto iter = std::upper_bound(
+    m_anchors.begin(), m_anchors.end(), pageno, [](uint32_t pageno, const Anchor &anchor) {
+        return pageno < anchor.pageno;
+    });
+    if (iter == m_anchors.begin()) {
+        return NullOpt;
+    }
+    --iter;
+    size_t index = (iter - m_anchors.begin()) * numberOfPagenosPerAnchor;
+    size_t offset = iter->offset;
+    uint32_t current = iter->pageno;
+    while (current < pageno) {
+        if (++index >= m_hashes.size()) {
+            return NullOpt;
+        }
+        uint32_t delta = 0;
+        getVarint(m_deltas, offset, delta);
+        current += delta;
+    }
+    if (current != pageno) {
+        return NullOpt;
+    }
+    return m_hashes[index];
+}
+
+bool VerifiedPagenos::buildAnchors()
+{
+    m_anchors.clear();
+    m_anchors.reserve(m_hashes.size() / numberOfPagenosPerAnchor + 1);
+    size_t offset = 0;
+    uint64_t pageno = 0;
+    for (size_t index = 0; index < m_hashes.size(); ++index) {
+        uint32_t delta;
+        if (!getVarint(m_deltas, offset, delta) || delta == 0) {
+            return false;
+        }
+        pageno += delta;
+        if (pageno > std::numeric_limits<uint32_t>::max()) {
+            return false;
+        }
+        if (index % numberOfPagenosPerAnchor == 0) {
+            m_anchors.push_back({ (uint32_t) pageno, (uint32_t) offset });
+        }
+    }
+    return offset == m_deltas.size();
+}
+
+#pragma mark - Iterator
+VerifiedPagenos::Iterator::Iterator(const VerifiedPagenos &verifiedPagenos, size_t index)
+: m_verifiedPagenos(verifiedPagenos), m_index(index), m_offset(0), m_pageno(0)
+{
+    if (m_index < m_verifiedPagenos.size()) {
+        WCTAssert(m_index == 0);
+        getVarint(m_verifiedPagenos.m_deltas, m_offset, m_pageno);
+    }
+}
+
+std::pair<uint32_t, uint32_t> VerifiedPagenos::Iterator::operator*() const
+{
+    WCTAssert(m_index < m_verifiedPagenos.size());
+    return { m_pageno, m_verifiedPagenos.m_hashes[m_index] };
+}
+
+VerifiedPagenos::Iterator &VerifiedPagenos::Iterator::operator++()
+{
+    if (++m_index < m_verifiedPagenos.size()) {
+        uint32_t delta = 0;
+        getVarint(m_verifiedPagenos.m_deltas, m_offset, delta);
+        m_pageno += delta;
+    }
+    return *this;
+}
+
+bool VerifiedPagenos::Iterator::operator!=(const Iterator &other) const
+{
+    return m_index != other.m_index;
+}
+
+VerifiedPagenos::Iterator VerifiedPagenos::begin() const
+{
+    return Iterator(*this, 0);
+}
+
+VerifiedPagenos::Iterator VerifiedPagenos::end() const
+{
+    return Iterator(*this, size());
+}
+
+#pragma mark - Builder
+VerifiedPagenos::Builder::Builder() = default;
+
+VerifiedPagenos::Builder::~Builder() = default;
+
+void VerifiedPagenos::Builder::append(uint32_t pageno, uint32_t hash)
+{
+    m_pages.emplace_back(pageno, hash);
+}
+
+bool VerifiedPagenos::Builder::empty() const
+{
+    return m_pages.empty();
+}
+
+void VerifiedPagenos::Builder::clear()
+{
+    m_pages.clear();
+}
+
+uint32_t VerifiedPagenos::Builder::build(VerifiedPagenos &verifiedPagenos)
+{
+    // Stable sort keeps the first one of the duplicated pages.
+    std::stable_sort(m_pages.begin(),
+                     m_pages.end(),
+                     [](const std::pair<uint32_t, uint32_t> &lhs,
+                        const std::pair<uint32_t, uint32_t> &rhs) {
+                         return lhs.first < rhs.first;
+                     });
+    uint32_t duplicated = 0;
+    std::vector<uint32_t> hashes;
+    std::vector<unsigned char> deltas;
+    hashes.reserve(m_pages.size());
+    deltas.reserve(m_pages.size() * 2);
+    uint32_t previous = 0;
+    for (const auto &page : m_pages) {
+        if (page.first == previous) {
+            if (duplicated == 0) {
+                duplicated = page.first;
+            }
+            continue;
+        }
+        WCTAssert(page.first > previous);
+        putVarint(deltas, page.first - previous);
+        hashes.push_back(page.second);
+        previous = page.first;
+    }
+    m_pages.clear();
+    m_pages.shrink_to_fit();
+
+    verifiedPagenos.m_hashes = std::move(hashes);
+    verifiedPagenos.m_deltas = std::move(deltas);
+    verifiedPagenos.m_hashes.shrink_to_fit();
+    verifiedPagenos.m_deltas.shrink_to_fit();
+    // Drop all of them so that none of the pages is treated as verified.
+    WCTRemedialAssert(verifiedPagenos.buildAnchors(),
+                      "Deltas of verified pagenos are malformed.",
+                      verifiedPagenos.m_hashes.clear();
+                      verifiedPagenos.m_deltas.clear();
+                      verifiedPagenos.m_anchors.clear(););
+    return duplicated;
+}
+
+#pragma mark - Serialization
+const std::vector<uint32_t> &VerifiedPagenos::getHashes() const
+{
+    return m_hashes;
+}
+
+const std::vector<unsigned char> &VerifiedPagenos::getDeltas() const
+{
+    return m_deltas;
+}
+
+bool VerifiedPagenos::reset(std::vector<uint32_t> &&hashes, std::vector<unsigned char> &&deltas)
+{
+    m_hashes = std::move(hashes);
+    m_deltas = std::move(deltas);
+    if (!buildAnchors()) {
+        m_hashes.clear();
+        m_deltas.clear();
+        m_anchors.clear();
+        return false;
+    }
+    return true;
+}
+
+} //namespace Repair
+
+} //namespace WCDB
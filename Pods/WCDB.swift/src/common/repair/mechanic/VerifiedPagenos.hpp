@@ -0,0 +1,123 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "WCDBOptional.hpp"
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace WCDB {
+
+namespace Repair {
+
+// Pagenos and their hashes of the verified pages, which are sorted by pageno.
+// Hashes are kept as raw 32-bit integers, while the pagenos are kept as varint deltas.
+// It costs about 6 bytes per page, comparing to 48 bytes of std::map.
+class VerifiedPagenos final {
+#pragma mark - Initialize
+public:
+    VerifiedPagenos();
+    ~VerifiedPagenos();
+
+    size_t size() const;
+    bool empty() const;
+
+protected:
+    std::vector<uint32_t> m_hashes;
+    // varint deltas of sorted pagenos
+    std::vector<unsigned char> m_deltas;
+
+    static void putVarint(std::vector<unsigned char> &buffer, uint32_t value);
+    static bool getVarint(const std::vector<unsigned char> &buffer, size_t &offset, uint32_t &value);
+
+#pragma mark - Find
+public:
+    Optional<uint32_t> find(uint32_t pageno) const;
+
+protected:
+    // It's anchored every `numberOfPagenosPerAnchor` pagenos for binary search.
+    static constexpr const size_t numberOfPagenosPerAnchor = 64;
+    struct Anchor {
+        uint32_t pageno;
+        // offset of the next delta
+        uint32_t offset;
+    };
+    std::vector<Anchor> m_anchors;
+    // Return false if the deltas are illegal.
+    bool buildAnchors();
+
+#pragma mark - Iterator
+public:
+    class Iterator final {
+    public:
+        // pageno -> hash
+        std::pair<uint32_t, uint32_t> operator*() const;
+        Iterator &operator++();
+        bool operator!=(const Iterator &other) const;
+
+    protected:
+        friend class VerifiedPagenos;
+        Iterator(const VerifiedPagenos &verifiedPagenos, size_t index);
+        const VerifiedPagenos &m_verifiedPagenos;
+        size_t m_index;
+        size_t m_offset;
+        uint32_t m_pageno;
+    };
+    Iterator begin() const;
+    Iterator end() const;
+
+#pragma mark - Builder
+public:
+    // Pages can be appended in any order, and they are sorted while building.
+    class Builder final {
+    public:
+        Builder();
+        ~Builder();
+
+        void append(uint32_t pageno, uint32_t hash);
+        bool empty() const;
+        void clear();
+
+        // The builder is cleared after building.
+        // Return the first duplicated pageno if any page is appended more than once, otherwise 0, which is never a legal pageno.
+        uint32_t build(VerifiedPagenos &verifiedPagenos);
+
+    protected:
+        std::vector<std::pair<uint32_t, uint32_t>> m_pages;
+    };
+
+#pragma mark - Serialization
+public:
+    // Raw hashes and the varint deltas. It's decoded without rebuilding any sorted map.
+    const std::vector<uint32_t> &getHashes() const;
+    const std::vector<unsigned char> &getDeltas() const;
+    // Return false if the deltas are illegal or mismatched with the number of hashes.
+    bool reset(std::vector<uint32_t> &&hashes, std::vector<unsigned char> &&deltas);
+};
+
+} //namespace Repair
+
+} //namespace WCDB
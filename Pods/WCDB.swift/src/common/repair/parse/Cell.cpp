@@ -28,6 +28,7 @@
 #include "Pager.hpp"
 #include "Serialization.hpp"
 #include "StringView.hpp"
+#include <algorithm>
 #include <cstring>
 #include <set>
 
@@ -125,25 +126,35 @@ int64_t Cell::integerValue(int index) const
         return true;
     } else {
         int length = getLengthOfSerialType(serialType);
-        WCTAssert(m_deserialization.isEnough(cell.second + length));
+        const Deserialization *deserialization = &m_deserialization;
+        offset_t offset = cell.second;
+        Deserialization gathered;
+        if (!m_deserialization.isEnough(cell.second + length)) {
+            gathered.reset(acquirePayload(cell.second, length));
+            if (!gathered.isEnough(length)) {
+                return 0;
+            }
+            deserialization = &gathered;
+            offset = 0;
+        }
         switch (length) {
         case 1:
-            value = m_deserialization.get1ByteInt(cell.second);
+            value = deserialization->get1ByteInt(offset);
             break;
         case 2:
-            value = m_deserialization.get2BytesInt(cell.second);
+            value = deserialization->get2BytesInt(offset);
             break;
         case 3:
-            value = m_deserialization.get3BytesInt(cell.second);
+            value = deserialization->get3BytesInt(offset);
             break;
         case 4:
-            value = m_deserialization.get4BytesInt(cell.second);
+            value = deserialization->get4BytesInt(offset);
             break;
         case 6:
-            value = m_deserialization.get6BytesInt(cell.second);
+            value = deserialization->get6BytesInt(offset);
             break;
         case 8:
-            value = m_deserialization.get8BytesInt(cell.second);
+            value = deserialization->get8BytesInt(offset);
             break;
         default:
             WCTAssert(false);
@@ -159,8 +170,14 @@ double Cell::doubleValue(int index) const
     WCTAssert(index < m_columns.size());
     WCTAssert(getValueType(index) == Type::Real);
     const auto &cell = m_columns[index];
-    WCTAssert(m_deserialization.isEnough(cell.second + 8));
-    return m_deserialization.get8BytesDouble(cell.second);
+    if (m_deserialization.isEnough(cell.second + 8)) {
+        return m_deserialization.get8BytesDouble(cell.second);
+    }
+    Deserialization gathered(acquirePayload(cell.second, 8));
+    if (!gathered.isEnough(8)) {
+        return 0;
+    }
+    return gathered.get8BytesDouble(0);
 }
 
 UnsafeStringView Cell::textValue(int index) const
@@ -169,20 +186,13 @@ UnsafeStringView Cell::textValue(int index) const
     WCTAssert(index < m_columns.size());
     WCTAssert(getValueType(index) == Type::Text);
     const auto &cell = m_columns[index];
-    return UnsafeStringView(
-    reinterpret_cast<const char *>(m_payload.buffer() + cell.second),
-    getLengthOfSerialType(cell.first));
+    const UnsafeData data = acquirePayload(cell.second, getLengthOfSerialType(cell.first));
+    return UnsafeStringView(reinterpret_cast<const char *>(data.buffer()), data.size());
 }
 
 StringView Cell::stringValue(int index) const
 {
-    WCTAssert(isInitialized());
-    WCTAssert(index < m_columns.size());
-    WCTAssert(getValueType(index) == Type::Text);
-    const auto &cell = m_columns[index];
-    int length = getLengthOfSerialType(cell.first);
-    WCTAssert(m_deserialization.isEnough(cell.second + length));
-    return m_deserialization.getString(cell.second, length);
+    return StringView(textValue(index));
 }
 
 const UnsafeData Cell::blobValue(int index) const
@@ -191,9 +201,43 @@ const UnsafeData Cell::blobValue(int index) const
     WCTAssert(index < m_columns.size());
     WCTAssert(getValueType(index) == Type::BLOB);
     const auto &cell = m_columns[index];
-    int size = getLengthOfSerialType(cell.first);
-    WCTAssert(m_deserialization.isEnough(cell.second + size));
-    return m_deserialization.getData(cell.second, size);
+    return acquirePayload(cell.second, getLengthOfSerialType(cell.first));
+}
+
+UnsafeData Cell::acquirePayload(int offset, int size) const
+{
+    WCTAssert(!m_payloadSegments.empty());
+    WCTAssert(offset >= 0 && size >= 0);
+    auto iter = std::upper_bound(m_offsetsOfSegments.begin(), m_offsetsOfSegments.end(), offset);
+    WCTAssert(iter != m_offsetsOfSegments.begin());
+    size_t index = std::distance(m_offsetsOfSegments.begin(), iter) - 1;
+    const Data &segment = m_payloadSegments[index];
+    int offsetWithinSegment = offset - m_offsetsOfSegments[index];
+    WCTAssert(offsetWithinSegment >= 0);
+    if ((size_t) (offsetWithinSegment + size) <= segment.size()) {
+        return segment.subdata(offsetWithinSegment, size);
+    }
+    auto gathered = m_gatheredValues.find(offset);
+    if (gathered != m_gatheredValues.end()) {
+        WCTAssert(gathered->second.size() == (size_t) size);
+        return gathered->second;
+    }
+    Data value(size);
+    if (value.empty()) {
+        // It fails to allocate memory and the error is set as threaded error.
+        return UnsafeData::null();
+    }
+    int cursor = 0;
+    for (; index < m_payloadSegments.size() && cursor < size; ++index) {
+        const Data &source = m_payloadSegments[index];
+        int copySize = std::min(size - cursor, (int) source.size() - offsetWithinSegment);
+        memcpy(value.buffer() + cursor, source.buffer() + offsetWithinSegment, copySize);
+        cursor += copySize;
+        offsetWithinSegment = 0;
+    }
+    WCTAssert(cursor == size);
+    m_gatheredValues.emplace(offset, value);
+    return value;
 }
 
 #pragma mark - Initializeable
@@ -228,6 +272,11 @@ bool Cell::doInitialize()
     }
     //parse payload
     int offsetOfPayload = m_pointer + lengthOfPayloadSize + lengthOfRowid;
+    m_payloadSegments.clear();
+    m_offsetsOfSegments.clear();
+    m_gatheredValues.clear();
+    m_payloadSegments.push_back(m_page->getData().subdata(offsetOfPayload, localPayloadSize));
+    m_offsetsOfSegments.push_back(0);
     if (localPayloadSize < payloadSize) {
         //append overflow pages
         deserialization.seek(offsetOfPayload + localPayloadSize);
@@ -236,15 +285,11 @@ bool Cell::doInitialize()
             return false;
         }
         int overflowPageno = deserialization.advance4BytesInt();
-        m_overflowedPayloadHolder = Data(payloadSize);
-        if (m_overflowedPayloadHolder.empty()) {
-            assignWithSharedThreadedError();
-            return false;
-        }
-        //fill payload with local data
-        memcpy(m_overflowedPayloadHolder.buffer(),
-               m_page->getData().buffer() + offsetOfPayload,
-               localPayloadSize);
+        int sizeOfOverflowPage = m_pager->getUsableSize() - 4;
+        // Overflow pages are usually allocated in sequence, so the whole chain is read ahead.
+        m_pager->prefetchPages(overflowPageno,
+                               (payloadSize - localPayloadSize + sizeOfOverflowPage - 1)
+                               / sizeOfOverflowPage);
 
         int cursorOfPayload = localPayloadSize;
         std::set<int> overflowPagenos;
@@ -264,18 +309,18 @@ bool Cell::doInitialize()
                 return false;
             }
             overflowPagenos.emplace(overflowPageno);
-            //fill payload with overflow data
+            //refer to overflow data
             UnsafeData overflow = m_pager->acquirePageData(overflowPageno);
             if (overflow.empty()) {
                 return false;
             }
-            int overflowSize
-            = std::min(payloadSize - cursorOfPayload, m_pager->getUsableSize() - 4);
-            WCTAssert(cursorOfPayload + overflowSize
-                      <= m_overflowedPayloadHolder.size());
-            memcpy(m_overflowedPayloadHolder.buffer() + cursorOfPayload,
-                   overflow.buffer() + 4,
-                   overflowSize);
+            int overflowSize = std::min(payloadSize - cursorOfPayload, sizeOfOverflowPage);
+            m_payloadSegments.push_back(overflow.subdata(4, overflowSize));
+            if (m_payloadSegments.back().empty()) {
+                assignWithSharedThreadedError();
+                return false;
+            }
+            m_offsetsOfSegments.push_back(cursorOfPayload);
             cursorOfPayload += overflowSize;
             //next overflow page
             Deserialization overflowDeserialization(overflow);
@@ -286,14 +331,8 @@ bool Cell::doInitialize()
             markPagerAsCorrupted(m_page->number, "Unexpected termination of OverflowPage.");
             return false;
         }
-        m_payload = m_overflowedPayloadHolder;
-    } else {
-        //non-overflow
-        m_nonOverflowedPayloadHolder
-        = m_page->getData().subdata(offsetOfPayload, localPayloadSize);
-        m_payload = m_nonOverflowedPayloadHolder;
     }
-    m_deserialization.reset(m_payload);
+    m_deserialization.reset(m_payloadSegments.front());
     //parse value offsets
     int lengthOfOffsetOfValues, offsetOfValues;
     std::tie(lengthOfOffsetOfValues, offsetOfValues) = m_deserialization.advanceVarint();
@@ -307,10 +346,18 @@ bool Cell::doInitialize()
     const int endOfValues = payloadSize;
     const int endOfSerialTypes = offsetOfValues;
 
+    // The serial types are in the local payload unless there are too many columns.
+    Deserialization *serialTypes = &m_deserialization;
+    Deserialization gatheredSerialTypes;
+    if (!m_deserialization.isEnough(endOfSerialTypes) && endOfSerialTypes <= endOfValues) {
+        gatheredSerialTypes.reset(acquirePayload(0, endOfSerialTypes));
+        serialTypes = &gatheredSerialTypes;
+    }
+
     while (cursorOfSerialTypes < endOfSerialTypes) {
         int lengthOfSerialType, serialType;
-        m_deserialization.seek(cursorOfSerialTypes);
-        std::tie(lengthOfSerialType, serialType) = m_deserialization.advanceVarint();
+        serialTypes->seek(cursorOfSerialTypes);
+        std::tie(lengthOfSerialType, serialType) = serialTypes->advanceVarint();
         if (lengthOfSerialType == 0) {
             markPagerAsCorrupted(m_page->number, "Unable to deserialize SerialType.");
             return false;
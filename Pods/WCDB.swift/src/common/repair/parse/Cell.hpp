@@ -28,6 +28,8 @@
 #include "MappedData.hpp"
 #include "PagerRelated.hpp"
 #include "Serialization.hpp"
+#include <map>
+#include <vector>
 
 namespace WCDB {
 
@@ -68,10 +70,14 @@ protected:
     int64_t m_rowid;
     int m_pointer;
 
+    // The payload of an overflowed cell is scattered over the local page and its overflow pages.
+    // Segments are page-backed and a value across them is gathered only when it's acquired.
+    UnsafeData acquirePayload(int offset, int size) const;
+    std::vector<Data> m_payloadSegments;
+    std::vector<int> m_offsetsOfSegments;
+    mutable std::map<int, Data> m_gatheredValues;
+    // deserialization of the first segment
     Deserialization m_deserialization;
-    Data m_overflowedPayloadHolder;
-    Data m_nonOverflowedPayloadHolder;
-    Data m_payload;
     //serial type -> offset of value
     std::vector<std::pair<int, int>> m_columns;
 
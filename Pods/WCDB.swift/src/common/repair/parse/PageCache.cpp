@@ -0,0 +1,204 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PageCache.hpp"
+#include "Assertion.hpp"
+#include <atomic>
+
+namespace WCDB {
+
+namespace Repair {
+
+#pragma mark - Initialize
+PageCache &PageCache::shared()
+{
+    static PageCache *s_pageCache = new PageCache(RepairPageCacheMaxAllowedMemory);
+    return *s_pageCache;
+}
+
+PageCache::PageCache(size_t maxAllowedMemory)
+: m_maxAllowedMemoryPerShard(maxAllowedMemory / RepairNumberOfPageCacheShards)
+{
+    static_assert((RepairNumberOfPageCacheShards & (RepairNumberOfPageCacheShards - 1)) == 0, "");
+}
+
+PageCache::~PageCache() = default;
+
+#pragma mark - Key
+PageCache::Key::Key() : scope(0), version(0), number(0)
+{
+}
+
+PageCache::Key::Key(uint64_t scope_, uint64_t version_, uint32_t number_)
+: scope(scope_), version(version_), number(number_)
+{
+}
+
+bool PageCache::Key::operator==(const Key &other) const
+{
+    return scope == other.scope && version == other.version && number == other.number;
+}
+
+size_t PageCache::KeyHash::operator()(const Key &key) const
+{
+    uint64_t hash = key.scope * 0x9E3779B97F4A7C15ULL;
+    hash ^= key.version + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    hash ^= key.number + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    return (size_t) (hash ^ (hash >> 32));
+}
+
+uint64_t PageCache::newScope()
+{
+    static std::atomic<uint64_t> *s_scope = new std::atomic<uint64_t>(0);
+    return ++(*s_scope);
+}
+
+PageCache::ScopeOfFile::ScopeOfFile()
+: raw(newScope()), decoded(newScope()), numberOfReferences(0)
+{
+}
+
+uint64_t PageCache::retainScopeOfFile(const UnsafeStringView &path, bool decoded)
+{
+    std::lock_guard<std::mutex> lockGuard(m_scopesLock);
+    auto iter = m_scopesOfFiles.find(path);
+    if (iter == m_scopesOfFiles.end()) {
+        iter = m_scopesOfFiles.emplace(path, ScopeOfFile()).first;
+    }
+    ++iter->second.numberOfReferences;
+    return decoded ? iter->second.decoded : iter->second.raw;
+}
+
+void PageCache::releaseScopeOfFile(const UnsafeStringView &path)
+{
+    std::lock_guard<std::mutex> lockGuard(m_scopesLock);
+    auto iter = m_scopesOfFiles.find(path);
+    WCTRemedialAssert(iter != m_scopesOfFiles.end(), "Scope of file is not retained.", return;);
+    // The pages of the dropped scope are left to be evicted in CLOCK order.
+    if (--iter->second.numberOfReferences == 0) {
+        m_scopesOfFiles.erase(iter);
+    }
+}
+
+#pragma mark - Cache
+PageCache::Slot::Slot() : referenced(false)
+{
+}
+
+PageCache::Shard::Shard() : hand(0), usedMemory(0)
+{
+}
+
+PageCache::Shard &PageCache::getShard(size_t hash)
+{
+    // the low bits are used by the buckets of unordered map
+    return m_shards[(hash >> 16) & (RepairNumberOfPageCacheShards - 1)];
+}
+
+UnsafeData PageCache::get(const Key &key)
+{
+    size_t hash = KeyHash()(key);
+    Shard &shard = getShard(hash);
+    std::lock_guard<std::mutex> lockGuard(shard.lock);
+    auto iter = shard.indexes.find(key);
+    if (iter == shard.indexes.end()) {
+        return UnsafeData::null();
+    }
+    Slot &slot = shard.slots[iter->second];
+    slot.referenced = true;
+    return slot.data;
+}
+
+void PageCache::insert(const Key &key, const UnsafeData &data)
+{
+    WCTAssert(!data.empty());
+    if (data.size() > m_maxAllowedMemoryPerShard) {
+        return;
+    }
+    size_t hash = KeyHash()(key);
+    Shard &shard = getShard(hash);
+    std::lock_guard<std::mutex> lockGuard(shard.lock);
+    if (shard.indexes.find(key) != shard.indexes.end()) {
+        // it's inserted by another pager in the meantime
+        return;
+    }
+    while (shard.usedMemory + data.size() > m_maxAllowedMemoryPerShard && evictOne(shard))
+        ;
+    size_t index;
+    if (!shard.freeSlots.empty()) {
+        index = shard.freeSlots.back();
+        shard.freeSlots.pop_back();
+    } else {
+        index = shard.slots.size();
+        shard.slots.emplace_back();
+    }
+    Slot &slot = shard.slots[index];
+    slot.key = key;
+    slot.data = data;
+    slot.referenced = false;
+    shard.indexes.emplace(key, index);
+    shard.usedMemory += data.size();
+}
+
+bool PageCache::evictOne(Shard &shard)
+{
+    if (shard.indexes.empty()) {
+        return false;
+    }
+    // Each page gets a second chance if it's referenced since the hand passed it last time.
+    do {
+        if (shard.hand >= shard.slots.size()) {
+            shard.hand = 0;
+        }
+        Slot &slot = shard.slots[shard.hand++];
+        if (slot.data.empty()) {
+            continue;
+        }
+        if (slot.referenced) {
+            slot.referenced = false;
+            continue;
+        }
+        shard.usedMemory -= slot.data.size();
+        shard.indexes.erase(slot.key);
+        shard.freeSlots.push_back(shard.hand - 1);
+        slot.data = UnsafeData::null();
+        return true;
+    } while (true);
+}
+
+void PageCache::purge()
+{
+    for (auto &shard : m_shards) {
+        std::lock_guard<std::mutex> lockGuard(shard.lock);
+        shard.indexes.clear();
+        shard.slots.clear();
+        shard.freeSlots.clear();
+        shard.hand = 0;
+        shard.usedMemory = 0;
+    }
+}
+
+} //namespace Repair
+
+} //namespace WCDB
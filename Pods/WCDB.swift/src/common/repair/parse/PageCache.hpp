@@ -0,0 +1,119 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "CoreConst.h"
+#include "StringView.hpp"
+#include "UnsafeData.hpp"
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace WCDB {
+
+namespace Repair {
+
+// Pages are shared between pagers through this process-wide cache,
+// so that a wal frame is mapped and a cipher page is decoded only once.
+// It's sharded by the hash of key and each shard evicts its pages in CLOCK order.
+class PageCache final {
+#pragma mark - Initialize
+public:
+    static PageCache &shared();
+
+    PageCache(size_t maxAllowedMemory);
+    ~PageCache();
+
+    PageCache() = delete;
+    PageCache(const PageCache &) = delete;
+    PageCache &operator=(const PageCache &) = delete;
+
+#pragma mark - Key
+public:
+    struct Key {
+        Key();
+        Key(uint64_t scope, uint64_t version, uint32_t number);
+        bool operator==(const Key &other) const;
+
+        uint64_t scope;
+        uint64_t version;
+        uint32_t number;
+    };
+
+    // Pages in different scopes are never mixed up.
+    static uint64_t newScope();
+    // All the living pagers of the same path share the scope of file, while the raw pages and the decoded pages are in different scopes.
+    // The scope is dropped once it's released by all the pagers, so that the pages cached before are never hit again.
+    uint64_t retainScopeOfFile(const UnsafeStringView &path, bool decoded);
+    void releaseScopeOfFile(const UnsafeStringView &path);
+
+protected:
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    struct ScopeOfFile {
+        ScopeOfFile();
+        uint64_t raw;
+        uint64_t decoded;
+        int numberOfReferences;
+    };
+    std::mutex m_scopesLock;
+    StringViewMap<ScopeOfFile> m_scopesOfFiles;
+
+#pragma mark - Cache
+public:
+    // Null data will be returned if it's not cached.
+    UnsafeData get(const Key &key);
+    void insert(const Key &key, const UnsafeData &data);
+    void purge();
+
+protected:
+    struct Slot {
+        Slot();
+        Key key;
+        UnsafeData data;
+        bool referenced;
+    };
+    struct Shard {
+        Shard();
+        std::mutex lock;
+        std::unordered_map<Key, size_t, KeyHash> indexes;
+        std::vector<Slot> slots;
+        std::vector<size_t> freeSlots;
+        size_t hand;
+        size_t usedMemory;
+    };
+    Shard &getShard(size_t hash);
+    static bool evictOne(Shard &shard);
+
+    const size_t m_maxAllowedMemoryPerShard;
+    std::array<Shard, RepairNumberOfPageCacheShards> m_shards;
+};
+
+} //namespace Repair
+
+} //namespace WCDB
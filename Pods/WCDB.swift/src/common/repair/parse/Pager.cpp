@@ -47,12 +47,22 @@ Pager::Pager(const UnsafeStringView& path)
 , m_fileSize(0)
 , m_wal(this)
 , m_walImportance(true)
-, m_cache(maxAllowedCacheMemory)
+, m_cacheScope(0)
+, m_walCacheScope(0)
+, m_retainsScopesOfFiles(false)
 , m_highWater(std::make_shared<ShareableHighWater>())
 {
 }
 
-Pager::~Pager() = default;
+Pager::~Pager()
+{
+    if (m_retainsScopesOfFiles) {
+        PageCache::shared().releaseScopeOfFile(m_wal.getPath());
+        if (m_pCodec != nullptr) {
+            PageCache::shared().releaseScopeOfFile(getPath());
+        }
+    }
+}
 
 void Pager::setPageSize(int pageSize)
 {
@@ -112,12 +122,20 @@ UnsafeData Pager::acquirePageData(int number, offset_t offset, size_t size)
     WCTAssert(isInitialized());
     WCTAssert(number > 0);
     WCTAssert(offset + size <= m_pageSize);
-    if (m_cache.exists(number)) {
-        return m_cache.get(number).subdata(offset, size);
+    bool inWal = m_wal.containsPage(number);
+    // The mapped pages of database file are already cached by the file handle.
+    bool cacheable = inWal || m_pCodec != nullptr;
+    PageCache::Key key;
+    if (cacheable) {
+        key = getCacheKey(number);
+        UnsafeData cached = PageCache::shared().get(key);
+        if (!cached.empty()) {
+            return cached.subdata(offset, size);
+        }
     }
     UnsafeData data;
-    if (m_wal.containsPage(number)) {
-        data = m_wal.acquirePageData(number, m_highWater);
+    if (inWal) {
+        data = m_wal.acquirePageData(number);
     } else {
         if (number > m_numberOfPages) {
             markAsCorrupted(
@@ -141,18 +159,35 @@ UnsafeData Pager::acquirePageData(int number, offset_t offset, size_t size)
         return MappedData::null();
     }
     if (m_pCodec) {
-        void* decodedBuffer = sqlite3Codec(m_pCodec, data.buffer(), number, 4);
-        if (decodedBuffer == nullptr) {
+        // Decode to a buffer of its own since the codec context is shared by the forked pagers.
+        Data decoded(m_pageSize);
+        if (decoded.empty()) {
+            assignWithSharedThreadedError();
+            return MappedData::null();
+        }
+        if (sqlite3CodecDecryptPages(m_pCodec, data.buffer(), decoded.buffer(), number, 1) != 1) {
             markAsCorrupted(number, "Decode page data fail!");
             return MappedData::null();
         }
-        data = Data(reinterpret_cast<unsigned char*>(decodedBuffer), m_pageSize, m_highWater);
+        data = decoded;
+    }
+    if (cacheable) {
+        PageCache::shared().insert(key, data);
     }
-    m_cache.insert(number, data);
     tryPurgeCache();
     return data.subdata(offset, size);
 }
 
+void Pager::prefetchPages(int number, int count)
+{
+    WCTAssert(isInitialized());
+    if (number <= 0 || number > m_numberOfPages || count <= 1) {
+        return;
+    }
+    count = std::min(count, m_numberOfPages - number + 1);
+    m_fileHandle.prefetch((offset_t) (number - 1) * m_pageSize, (size_t) count * m_pageSize);
+}
+
 UnsafeData Pager::acquireHeader()
 {
     WCTAssert(m_fileHandle.isOpened());
@@ -166,13 +201,16 @@ UnsafeData Pager::acquireHeader()
     } else {
         data = m_fileHandle.map(0, m_pageSize);
         if (data.size() == m_pageSize) {
-            void* decodedBuffer = sqlite3Codec(m_pCodec, data.buffer(), 1, 4);
-            if (decodedBuffer == nullptr) {
+            Data decoded(m_pageSize);
+            if (decoded.empty()) {
+                assignWithSharedThreadedError();
+                return MappedData::null();
+            }
+            if (sqlite3CodecDecryptPages(m_pCodec, data.buffer(), decoded.buffer(), 1, 1) != 1) {
                 markAsCorrupted(1, "Decode page data fail!");
                 return MappedData::null();
             }
-            data
-            = Data(reinterpret_cast<unsigned char*>(decodedBuffer), m_pageSize).subdata(0, 100);
+            data = decoded.subdata(0, 100);
         } else {
             assignWithSharedThreadedError();
         }
@@ -215,6 +253,30 @@ int Pager::getNumberOfWalFrames() const
     return m_wal.getNumberOfFrames();
 }
 
+std::set<int> Pager::getWalPagesChangedAfterFrame(int frameno) const
+{
+    return m_wal.getPagesChangedAfterFrame(frameno);
+}
+
+#pragma mark - Fork
+std::unique_ptr<Pager> Pager::fork() const
+{
+    WCTAssert(isInitialized());
+    std::unique_ptr<Pager> forked(new Pager(getPath()));
+    forked->m_pCodec = m_pCodec;
+    forked->m_pageSize = m_pageSize;
+    forked->m_reservedBytes = m_reservedBytes;
+    forked->m_fileSize = m_fileSize;
+    forked->m_walImportance = m_walImportance;
+    forked->m_wal.inherit(m_wal);
+    return forked;
+}
+
+void Pager::mergeError(const Error& error)
+{
+    setError(error);
+}
+
 #pragma mark - Error
 void Pager::markAsCorrupted(int page, const UnsafeStringView& message)
 {
@@ -238,15 +300,18 @@ void Pager::markAsError(Error::Code code)
 #pragma mark - Initializeable
 bool Pager::doInitialize()
 {
-    auto fileSize = FileManager::getFileSize(getPath());
-    if (!fileSize.succeed()) {
-        assignWithSharedThreadedError();
-        return false;
-    }
-    m_fileSize = fileSize.value();
+    // forked pager inherits the file size
     if (m_fileSize == 0) {
-        markAsError(Error::Code::Empty);
-        return false;
+        auto fileSize = FileManager::getFileSize(getPath());
+        if (!fileSize.succeed()) {
+            assignWithSharedThreadedError();
+            return false;
+        }
+        m_fileSize = fileSize.value();
+        if (m_fileSize == 0) {
+            markAsError(Error::Code::Empty);
+            return false;
+        }
     }
 
     if (!m_fileHandle.open(FileHandle::Mode::ReadOnly)) {
@@ -292,6 +357,8 @@ bool Pager::doInitialize()
 
     m_numberOfPages = (int) ((m_fileSize + m_pageSize - 1) / m_pageSize);
 
+    retainScopesOfFiles();
+
     if (m_wal.initialize()) {
         return true;
     }
@@ -302,52 +369,61 @@ bool Pager::doInitialize()
     return true;
 }
 
-void Pager::tryPurgeCache()
+#pragma mark - Cache
+PageCache::Key Pager::getCacheKey(int number) const
 {
-    ssize_t allowedSize = maxAllowedCacheMemory * 2;
-    if (m_pCodec) {
-        allowedSize *= 2;
-    }
-    if (m_highWater->getCurrent() <= allowedSize) {
-        return;
-    }
-    if (m_pCodec != nullptr) {
-        m_fileHandle.purgeAll();
-        while (!m_cache.empty() && m_highWater->getCurrent() > allowedSize) {
-            m_cache.purge();
-        }
-    } else {
-        m_cache.purge(m_cache.size());
-        while (m_highWater->getCurrent() > allowedSize && m_fileHandle.purgeOne())
-            ;
+    if (!m_wal.containsPage(number)) {
+        return PageCache::Key(m_cacheScope, 0, number);
     }
+    int frameno = m_wal.getFrameOfPage(number);
+    // Committed frames are never overwritten until the wal is restarted with a new salt,
+    // so that they can be shared by all the pagers of the same wal.
+    const auto& salt = m_wal.getSalt();
+    return PageCache::Key(
+    m_walCacheScope, ((uint64_t) salt.first << 32) | salt.second, frameno);
 }
 
-Pager::Cache::Cache(size_t maxAllowedMemory)
-: LRUCache<uint32_t, UnsafeData>()
-, m_maxAllowedMemory(maxAllowedMemory)
-, m_currentUsedMemery(0)
+void Pager::retainScopesOfFiles()
 {
+    bool decoded = m_pCodec != nullptr;
+    if (decoded && !isCipherKeyVerified()) {
+        // The pages decoded by an unverified key are never shared.
+        m_cacheScope = PageCache::newScope();
+        m_walCacheScope = PageCache::newScope();
+        return;
+    }
+    m_walCacheScope = PageCache::shared().retainScopeOfFile(m_wal.getPath(), decoded);
+    if (decoded) {
+        m_cacheScope = PageCache::shared().retainScopeOfFile(getPath(), true);
+    }
+    m_retainsScopesOfFiles = true;
 }
 
-Pager::Cache::~Cache() = default;
-
-void Pager::Cache::insert(uint32_t pageNum, const UnsafeData& data)
-{
-    WCTAssert(!exists(pageNum));
-    m_currentUsedMemery += data.size();
-    put(pageNum, data);
-}
-
-bool Pager::Cache::shouldPurge() const
+bool Pager::isCipherKeyVerified()
 {
-    return m_currentUsedMemery > m_maxAllowedMemory;
+    WCTAssert(m_pCodec != nullptr);
+    // Page 1 can't be decoded by a wrong key, either failing the hmac check or mismatching the page size.
+    UnsafeData data = m_fileHandle.map(0, m_pageSize);
+    if (data.size() != m_pageSize) {
+        return false;
+    }
+    Data decoded(m_pageSize);
+    if (decoded.empty()
+        || sqlite3CodecDecryptPages(m_pCodec, data.buffer(), decoded.buffer(), 1, 1) != 1) {
+        return false;
+    }
+    Deserialization deserialization(decoded);
+    deserialization.seek(16);
+    int pageSize = deserialization.advance2BytesInt();
+    return (pageSize == 1 ? 65536 : pageSize) == m_pageSize;
 }
 
-void Pager::Cache::willPurge(const uint32_t& pageNum, const UnsafeData& data)
+void Pager::tryPurgeCache()
 {
-    WCDB_UNUSED(pageNum)
-    m_currentUsedMemery -= data.size();
+    // Only the mapped database file is counted, while the wal frames and the decoded pages are limited by the page cache.
+    ssize_t allowedSize = maxAllowedCacheMemory * 2;
+    while (m_highWater->getCurrent() > allowedSize && m_fileHandle.purgeOne())
+        ;
 }
 
 } //namespace Repair
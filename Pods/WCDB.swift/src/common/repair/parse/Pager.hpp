@@ -28,8 +28,11 @@
 #include "HighWater.hpp"
 #include "Initializeable.hpp"
 #include "PageBasedFileHandle.hpp"
+#include "PageCache.hpp"
 #include "WCDBError.hpp"
 #include "Wal.hpp"
+#include <memory>
+#include <set>
 
 namespace WCDB {
 
@@ -59,6 +62,8 @@ public:
     int getNumberOfPages() const;
     UnsafeData acquirePageData(int number);
     UnsafeData acquirePageData(int number, offset_t offset, size_t size);
+    // Hint the system to read the pages ahead. It's best effort and never fails.
+    void prefetchPages(int number, int count);
 
     int getUsableSize() const;
     int getPageSize() const;
@@ -79,11 +84,21 @@ public:
     int getDisposedWalPages() const;
     void disposeWal();
     const std::pair<uint32_t, uint32_t>& getWalSalt() const;
+    std::set<int> getWalPagesChangedAfterFrame(int frameno) const;
 
 protected:
     Wal m_wal;
     bool m_walImportance;
 
+#pragma mark - Fork
+public:
+    // Pager is not thread-safe. Parallel crawling reads pages through the forked pagers.
+    // Cipher pager is forked with the same codec context, which is only read once the keys are derived.
+    // Forked pager shares the file size and wal frames with the origin. It should be initialized before use.
+    std::unique_ptr<Pager> fork() const;
+    // Merge the error of forked pager.
+    void mergeError(const Error& error);
+
 #pragma mark - Error
 public:
     void markAsCorrupted(int page, const UnsafeStringView& message);
@@ -97,21 +112,14 @@ protected:
 #pragma mark - Cache
 protected:
     static constexpr const size_t maxAllowedCacheMemory = 16 * 1024 * 1024;
-    class Cache final : public LRUCache<uint32_t, UnsafeData> {
-    public:
-        Cache(size_t maxAllowedMemory);
-        ~Cache() override final;
-
-        void insert(uint32_t pageNum, const UnsafeData& data);
-
-    protected:
-        bool shouldPurge() const override final;
-        void willPurge(const uint32_t& pageNum, const UnsafeData& data) override final;
-        size_t m_maxAllowedMemory;
-        size_t m_currentUsedMemery;
-    };
+    PageCache::Key getCacheKey(int number) const;
+    void retainScopesOfFiles();
+    bool isCipherKeyVerified();
     void tryPurgeCache();
-    Cache m_cache;
+    // scope of the decoded pages of database file
+    uint64_t m_cacheScope;
+    uint64_t m_walCacheScope;
+    bool m_retainsScopesOfFiles;
     SharedHighWater m_highWater;
 };
 
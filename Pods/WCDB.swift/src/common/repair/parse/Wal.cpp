@@ -49,6 +49,7 @@ Wal::Wal(Pager *pager)
 , m_salt({ 0, 0 })
 , m_shmLegality(true)
 , m_shm(this)
+, m_inherited(false)
 {
 }
 
@@ -99,6 +100,12 @@ MappedData Wal::acquirePageData(int pageno, offset_t offset, size_t size, Shared
                        highWater);
 }
 
+int Wal::getFrameOfPage(int pageno) const
+{
+    WCTAssert(containsPage(pageno));
+    return m_pages2Frames.find(pageno)->second;
+}
+
 int Wal::getMaxPageno() const
 {
     if (m_pages2Frames.empty()) {
@@ -107,6 +114,17 @@ int Wal::getMaxPageno() const
     return m_pages2Frames.rbegin()->first;
 }
 
+std::set<int> Wal::getPagesChangedAfterFrame(int frameno) const
+{
+    std::set<int> pagenos;
+    for (const auto &element : m_pages2Frames) {
+        if (element.second > frameno) {
+            pagenos.emplace_hint(pagenos.end(), element.first);
+        }
+    }
+    return pagenos;
+}
+
 #pragma mark - Wal
 void Wal::setShmLegality(bool flag)
 {
@@ -191,6 +209,17 @@ bool Wal::doInitialize()
 {
     WCTAssert(m_pager->isInitialized() || m_pager->isInitializing());
 
+    if (m_inherited) {
+        if (m_pages2Frames.empty()) {
+            return true;
+        }
+        if (!m_fileHandle.open(FileHandle::Mode::ReadOnly)) {
+            assignWithSharedThreadedError();
+            return false;
+        }
+        return true;
+    }
+
     int maxWalFrame = m_maxAllowedFrame;
     if (m_shmLegality) {
         if (!m_shm.initialize()) {
@@ -301,6 +330,23 @@ bool Wal::doInitialize()
     return true;
 }
 
+#pragma mark - Inherit
+void Wal::inherit(const Wal &wal)
+{
+    WCTAssert(!isInitialized());
+    WCTAssert(wal.isInitialized() || wal.m_pages2Frames.empty());
+    m_pages2Frames = wal.m_pages2Frames;
+    m_fileSize = wal.m_fileSize;
+    m_truncate = wal.m_truncate;
+    m_maxAllowedFrame = wal.m_maxAllowedFrame;
+    m_maxFrame = wal.m_maxFrame;
+    m_isNativeChecksum = wal.m_isNativeChecksum;
+    m_salt = wal.m_salt;
+    m_shmLegality = wal.m_shmLegality;
+    m_disposedPages = wal.m_disposedPages;
+    m_inherited = true;
+}
+
 #pragma mark - Error
 void Wal::markAsCorrupted(int frame, const UnsafeStringView &message)
 {
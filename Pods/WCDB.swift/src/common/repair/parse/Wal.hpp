@@ -57,6 +57,9 @@ public:
     MappedData
     acquirePageData(int pageno, offset_t offset, size_t size, SharedHighWater highWater = nullptr);
     int getMaxPageno() const;
+    int getFrameOfPage(int pageno) const;
+    // Pages whose last committed frame is after the given frame, which are changed since then.
+    std::set<int> getPagesChangedAfterFrame(int frameno) const;
 
 protected:
     // pageno -> frameno
@@ -84,6 +87,14 @@ protected:
     bool m_shmLegality;
     Shm m_shm;
 
+#pragma mark - Inherit
+public:
+    // Inherit the parsed frames of another wal, so that it will not be parsed again while initializing.
+    void inherit(const Wal &wal);
+
+protected:
+    bool m_inherited;
+
 #pragma mark - Frame
 public:
     int getFrameSize() const;
@@ -36,7 +36,8 @@ namespace WCDB {
 namespace Repair {
 
 #pragma mark - Initialize
-SQLiteAssembler::SQLiteAssembler() : m_cellSTMT(nullptr), m_primary(-1)
+SQLiteAssembler::SQLiteAssembler()
+: m_cellSTMT(nullptr), m_primary(-1), m_numberOfColumns(0)
 {
 }
 
@@ -109,14 +110,15 @@ bool SQLiteAssembler::assembleCell(const Cell &cell)
             (sqlite3_stmt *) m_cellSTMT, bindIndex, cell.integerValue(i));
             break;
         case Cell::Text: {
+            const UnsafeStringView text = cell.textValue(i);
             sqlite3_bind_text(
-            (sqlite3_stmt *) m_cellSTMT, bindIndex, cell.textValue(i).cstring(), -1, SQLITE_TRANSIENT);
+            (sqlite3_stmt *) m_cellSTMT, bindIndex, text.data(), (int) text.length(), SQLITE_STATIC);
             break;
         }
         case Cell::BLOB: {
             const UnsafeData data = cell.blobValue(i);
             sqlite3_bind_blob(
-            (sqlite3_stmt *) m_cellSTMT, bindIndex, data.buffer(), (int) data.size(), SQLITE_TRANSIENT);
+            (sqlite3_stmt *) m_cellSTMT, bindIndex, data.buffer(), (int) data.size(), SQLITE_STATIC);
             break;
         }
         case Cell::Real:
@@ -132,8 +134,13 @@ bool SQLiteAssembler::assembleCell(const Cell &cell)
             break;
         }
     }
+    for (int i = cell.getCount(); i < m_numberOfColumns; ++i) {
+        sqlite3_bind_null((sqlite3_stmt *) m_cellSTMT, i + 2);
+    }
     bool result = step(m_cellSTMT);
+    // values are bound without copying, so they should be cleared before the cell is released.
     sqlite3_reset((sqlite3_stmt *) m_cellSTMT);
+    sqlite3_clear_bindings((sqlite3_stmt *) m_cellSTMT);
     return result;
 }
 
@@ -221,6 +228,7 @@ SQLiteAssembler::getColumnNames(const UnsafeStringView &tableName)
     finalize(&stmt);
     if (done) {
         m_primary = maxpk == 1 ? primary : -1;
+        m_numberOfColumns = (int) columns.size();
         return { true, columns };
     }
     return { false, {} };
@@ -66,6 +66,7 @@ protected:
 
     StringView m_table;
     int m_primary;
+    int m_numberOfColumns;
     void *m_cellSTMT;
 
 #pragma mark - Sequence
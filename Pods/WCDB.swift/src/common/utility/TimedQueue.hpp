@@ -26,23 +26,49 @@
 
 #include "Assertion.hpp"
 #include "Exiting.hpp"
+#include "Lock.hpp"
 #include "Time.hpp"
-#include "UniqueList.hpp"
 #include <condition_variable>
+#include <functional>
 #include <list>
+#include <map>
 #include <stdio.h>
 
 namespace WCDB {
 
+/*
+ * Timed queue is a scheduler that
+ * 1. constrained by unique key, which should be comparable.
+ * 2. expires elements in ascending order of time.
+ *
+ * Scheduling, rescheduling and removing are O(logN).
+ * All the elements expired at the same time are drained in a batch.
+ */
 template<typename Key, typename Info>
 class TimedQueue final {
 private:
-    typedef UniqueList<Key, Info, SteadyClock> List;
-    List m_list;
+    struct Element {
+        Element(const Key &key_, const Info &info_) : key(key_), info(info_) {}
+        Key key;
+        Info info;
+    };
+    // expired time -> element, elements with same expired time are kept in FIFO order.
+    typedef std::multimap<SteadyClock, Element> Schedule;
+    typedef typename Schedule::iterator ScheduleIterator;
+    Schedule m_schedule;
+    std::map<Key, ScheduleIterator> m_scheduled;
+
+    // drained elements that are not yet called back
+    typedef std::list<Element> Expireds;
+    typedef typename Expireds::iterator ExpiredIterator;
+    Expireds m_expireds;
+    std::map<Key, ExpiredIterator> m_expiring;
+
     Conditional m_conditional;
+    Conditional m_done;
     std::mutex m_lock;
     bool m_stop;
-    std::atomic<bool> m_running;
+    bool m_running;
 
 public:
     TimedQueue() : m_stop(false), m_running(false) {}
@@ -60,7 +86,20 @@ public:
         ReQueue,
     };
 
-    void queue(const Key &key, double delay, const Info &info, Mode mode = Mode::ForwardOnly)
+    // Merge the info of the pending element into the new one that replaces it.
+    // The pending info is simply overwritten if it's not set.
+    typedef std::function<void(Info & /* info */, const Info & /* pending */)> Merger;
+    void setMerger(const Merger &merger)
+    {
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        m_merger = merger;
+    }
+
+private:
+    Merger m_merger;
+
+public:
+    void queue(const Key &key, double delay, const Info &info_, Mode mode = Mode::ForwardOnly)
     {
         if (isExiting()) {
             stop();
@@ -76,13 +115,36 @@ public:
                 return;
             }
 
-            auto iter = m_list.find(key);
-            if (mode == Mode::ForwardOnly && iter != m_list.end() && iter->order() < expired) {
-                iter->value() = info;
-            } else {
-                m_list.insert(key, info, expired);
-                notify = m_list.front().key() == key;
+            Info info = info_;
+            auto expiring = m_expiring.find(key);
+            if (expiring != m_expiring.end()) {
+                if (m_merger != nullptr) {
+                    m_merger(info, expiring->second->info);
+                }
+                // It's already expired, which is always earlier.
+                if (mode == Mode::ForwardOnly) {
+                    expiring->second->info = info;
+                    return;
+                }
+                m_expireds.erase(expiring->second);
+                m_expiring.erase(expiring);
+            }
+
+            auto scheduled = m_scheduled.find(key);
+            if (scheduled != m_scheduled.end()) {
+                if (m_merger != nullptr) {
+                    m_merger(info, scheduled->second->second.info);
+                }
+                if (mode == Mode::ForwardOnly && scheduled->second->first < expired) {
+                    scheduled->second->second.info = info;
+                    return;
+                }
+                m_schedule.erase(scheduled->second);
+                m_scheduled.erase(scheduled);
             }
+            auto iter = m_schedule.emplace(expired, Element(key, info));
+            m_scheduled.emplace(key, iter);
+            notify = iter == m_schedule.begin();
         }
         if (notify) {
             m_conditional.notify_one();
@@ -96,7 +158,16 @@ public:
             if (m_stop) {
                 return;
             }
-            m_list.erase(key);
+            auto scheduled = m_scheduled.find(key);
+            if (scheduled != m_scheduled.end()) {
+                m_schedule.erase(scheduled->second);
+                m_scheduled.erase(scheduled);
+            }
+            auto expiring = m_expiring.find(key);
+            if (expiring != m_expiring.end()) {
+                m_expireds.erase(expiring->second);
+                m_expiring.erase(expiring);
+            }
         }
         if (isExiting()) {
             stop();
@@ -108,51 +179,62 @@ public:
     {
         {
             std::lock_guard<std::mutex> lockGuard(m_lock);
-            m_list.clear();
+            m_schedule.clear();
+            m_scheduled.clear();
+            m_expireds.clear();
+            m_expiring.clear();
             m_stop = true;
         }
-        m_conditional.notify_one();
+        m_conditional.notify_all();
     }
 
     void waitUntilDone()
     {
-        while (m_running.load())
-            ;
+        std::unique_lock<std::mutex> lockGuard(m_lock);
+        while (m_running) {
+            m_done.wait(lockGuard);
+        }
     }
 
     void loop(const ExpiredCallback &onElementExpired)
     {
-        m_running.store(true);
-        while (!isExiting()) {
-            std::list<std::pair<Key, Info>> expireds;
-            {
-                std::unique_lock<std::mutex> lockGuard(m_lock);
-                if (m_stop) {
-                    break;
-                }
-                auto shortest = m_list.begin();
-                if (shortest == m_list.end()) {
-                    if (!isExiting()) {
-                        m_conditional.wait(lockGuard);
-                    }
-                    continue;
+        std::unique_lock<std::mutex> lockGuard(m_lock);
+        m_running = true;
+        while (!isExiting() && !m_stop) {
+            if (!m_expireds.empty()) {
+                Element element = m_expireds.front();
+                m_expiring.erase(element.key);
+                m_expireds.pop_front();
+                lockGuard.unlock();
+                if (!isExiting()) {
+                    onElementExpired(element.key, element.info);
                 }
-                double timeInterval = shortest->order().timeIntervalSinceNow();
-                if (timeInterval > 0) {
-                    if (!isExiting()) {
-                        m_conditional.wait_for(lockGuard, timeInterval);
-                    }
-                    continue;
-                }
-                expireds.push_back(std::make_pair(shortest->key(), shortest->value()));
-                m_list.erase(shortest);
+                lockGuard.lock();
+                continue;
+            }
+            auto shortest = m_schedule.begin();
+            if (shortest == m_schedule.end()) {
+                m_conditional.wait(lockGuard);
+                continue;
+            }
+            SteadyClock now = SteadyClock::now();
+            double timeInterval = shortest->first.timeIntervalSinceSteadyClock(now);
+            if (timeInterval > 0) {
+                m_conditional.wait_for(lockGuard, timeInterval);
+                continue;
             }
-            if (!isExiting()) {
-                WCTAssert(expireds.size() == 1);
-                onElementExpired(expireds.begin()->first, expireds.begin()->second);
+            // drain all the expired elements in a batch
+            auto end = m_schedule.upper_bound(now);
+            for (auto iter = m_schedule.begin(); iter != end; ++iter) {
+                m_scheduled.erase(iter->second.key);
+                m_expireds.push_back(iter->second);
+                m_expiring.emplace(iter->second.key, std::prev(m_expireds.end()));
             }
+            m_schedule.erase(m_schedule.begin(), end);
         }
-        m_running.store(false);
+        m_running = false;
+        lockGuard.unlock();
+        m_done.notify_all();
     }
 };
 
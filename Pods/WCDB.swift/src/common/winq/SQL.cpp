@@ -43,7 +43,7 @@ SQL::SQL(SQL&& other)
 , m_hasDescription(other.m_hasDescription)
 {
     if (other.m_hasDescription) {
-        std::atomic_store(&other.m_description, std::shared_ptr<StringView>(nullptr));
+        std::atomic_store(&other.m_description, std::shared_ptr<const Description>(nullptr));
         other.m_hasDescription = false;
     }
 }
@@ -70,7 +70,7 @@ SQL& SQL::operator=(SQL&& other)
     }
     m_hasDescription = other.m_hasDescription;
     if (other.m_hasDescription) {
-        std::atomic_store(&other.m_description, std::shared_ptr<StringView>(nullptr));
+        std::atomic_store(&other.m_description, std::shared_ptr<const Description>(nullptr));
         other.m_hasDescription = false;
     }
     return *this;
@@ -89,36 +89,60 @@ void SQL::iterate(const ConstIterator& iterator) const
 void SQL::iterate(const Iterator& iterator)
 {
     if (m_hasDescription) {
-        std::atomic_store(&m_description, std::shared_ptr<StringView>(nullptr));
+        std::atomic_store(&m_description, std::shared_ptr<const Description>(nullptr));
         m_hasDescription = false;
     }
     return syntax().iterate(iterator);
 }
 
-StringView SQL::getDescription() const
+SQL::Description::Description(StringView&& sql_)
+: sql(std::move(sql_)), fingerprint(sql.hash())
+{
+}
+
+std::shared_ptr<const SQL::Description> SQL::loadDescription() const
 {
     // class SQL is not designed for thread-safe.
     // But here, the cache of `m_description` may be accessed/modified in different threads.
     // So we must make this const function thread-safe.
-    std::shared_ptr<StringView> description = std::atomic_load(&m_description);
+    std::shared_ptr<const Description> description = std::atomic_load(&m_description);
     while (description == nullptr) {
         if (syntax().isValid()) {
-            std::atomic_store(
-            &m_description, std::make_shared<StringView>(syntax().getDescription()));
+            std::atomic_store(&m_description,
+                              std::shared_ptr<const Description>(
+                              std::make_shared<Description>(syntax().getDescription())));
             description = std::atomic_load(&m_description);
             m_hasDescription = true;
         } else {
-            return StringView();
+            return nullptr;
         }
     }
-    return *description.get();
+    return description;
+}
+
+StringView SQL::getDescription() const
+{
+    std::shared_ptr<const Description> description = loadDescription();
+    if (description == nullptr) {
+        return StringView();
+    }
+    return description->sql;
+}
+
+size_t SQL::getFingerprint() const
+{
+    std::shared_ptr<const Description> description = loadDescription();
+    if (description == nullptr) {
+        return 0;
+    }
+    return description->fingerprint;
 }
 
 Syntax::Identifier& SQL::syntax()
 {
     // Note that `syntax()` is not designed for thread-safe.
     if (m_hasDescription) {
-        std::atomic_store(&m_description, std::shared_ptr<StringView>(nullptr));
+        std::atomic_store(&m_description, std::shared_ptr<const Description>(nullptr));
         m_hasDescription = false;
     }
     return *m_syntaxPtr;
@@ -48,6 +48,8 @@ public:
     void iterate(const ConstIterator& iterator) const;
 
     StringView getDescription() const;
+    // Hash of the description. It's computed once per SQL object, along with the description.
+    size_t getFingerprint() const;
 
     virtual Syntax::Identifier& syntax();
     virtual const Syntax::Identifier& syntax() const;
@@ -59,7 +61,14 @@ protected:
     SQL& operator=(SQL&& other);
 
     mutable Syntax::Identifier* m_syntaxPtr = nullptr;
-    mutable std::shared_ptr<StringView> m_description;
+
+    struct Description {
+        Description(StringView&& sql);
+        const StringView sql;
+        const size_t fingerprint;
+    };
+    std::shared_ptr<const Description> loadDescription() const;
+    mutable std::shared_ptr<const Description> m_description;
     mutable bool m_hasDescription = false;
 };
 
@@ -24,10 +24,12 @@
 
 #pragma once
 
+#include "SyntaxDescriptionStream.hpp"
 #include "ValueArray.hpp"
 #include <cassert>
 #include <list>
 #include <type_traits>
+#include <vector>
 
 namespace WCDB {
 
@@ -159,17 +161,28 @@ public:
 
     StringView getDescription() const
     {
-        std::ostringstream stream;
-        bool comma = false;
+        // Describe all the elements before borrowing the threaded stream since they may borrow it too.
+        // The length of the list is known from them, so that the buffer grows at most once.
+        std::vector<StringView> descriptions;
+        descriptions.reserve(this->size());
+        size_t length = 0;
         for (const auto& sql : *this) {
+            descriptions.push_back(sql.getDescription());
+            length += descriptions.back().length() + 2;
+        }
+        Syntax::DescriptionStream::Threaded threaded;
+        Syntax::DescriptionStream& stream = threaded.get();
+        stream.reserve(length);
+        bool comma = false;
+        for (const auto& description : descriptions) {
             if (comma) {
                 stream << ", ";
             } else {
                 comma = true;
             }
-            stream << sql.getDescription();
+            stream << description;
         }
-        return StringView(stream.str());
+        return stream.getDescription();
     }
 };
 
@@ -0,0 +1,246 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SyntaxDescriptionStream.hpp"
+#include "Assertion.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <locale>
+#include <memory>
+
+namespace WCDB {
+
+namespace Syntax {
+
+#pragma mark - DescriptionBuffer
+DescriptionBuffer::DescriptionBuffer() : DescriptionBuffer(nullptr, 0)
+{
+}
+
+DescriptionBuffer::DescriptionBuffer(char* arena, size_t capacity)
+: m_arena(arena), m_arenaCapacity(arena != nullptr ? capacity : 0), m_heap(nullptr), m_heapCapacity(0)
+{
+    setp(m_arena, m_arena + m_arenaCapacity);
+}
+
+DescriptionBuffer::~DescriptionBuffer()
+{
+    if (m_heap != nullptr) {
+        free(m_heap);
+    }
+}
+
+const char* DescriptionBuffer::data() const
+{
+    return pbase() != nullptr ? pbase() : "";
+}
+
+size_t DescriptionBuffer::length() const
+{
+    return pptr() - pbase();
+}
+
+void DescriptionBuffer::clear()
+{
+    char* begin = m_heap != nullptr ? m_heap : m_arena;
+    size_t capacity = m_heap != nullptr ? m_heapCapacity : m_arenaCapacity;
+    setp(begin, begin + capacity);
+}
+
+void DescriptionBuffer::shrink(size_t capacity)
+{
+    if (m_heap != nullptr && m_heapCapacity > capacity) {
+        free(m_heap);
+        m_heap = nullptr;
+        m_heapCapacity = 0;
+        setp(m_arena, m_arena + m_arenaCapacity);
+    }
+}
+
+bool DescriptionBuffer::reserve(size_t capacity)
+{
+    size_t oldCapacity = epptr() - pbase();
+    if (capacity <= oldCapacity) {
+        return true;
+    }
+    size_t newCapacity = std::max<size_t>(oldCapacity * 2, 256);
+    while (newCapacity < capacity) {
+        newCapacity *= 2;
+    }
+    size_t used = length();
+    char* newHeap = nullptr;
+    if (m_heap != nullptr) {
+        newHeap = (char*) realloc(m_heap, newCapacity);
+    } else {
+        newHeap = (char*) malloc(newCapacity);
+        if (newHeap != nullptr && used > 0) {
+            memcpy(newHeap, pbase(), used);
+        }
+    }
+    if (newHeap == nullptr) {
+        return false;
+    }
+    m_heap = newHeap;
+    m_heapCapacity = newCapacity;
+    setp(m_heap, m_heap + m_heapCapacity);
+    pbump((int) used);
+    return true;
+}
+
+DescriptionBuffer::int_type DescriptionBuffer::overflow(int_type ch)
+{
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+        return traits_type::not_eof(ch);
+    }
+    if (!reserve(length() + 1)) {
+        return traits_type::eof();
+    }
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+std::streamsize DescriptionBuffer::xsputn(const char* string, std::streamsize count)
+{
+    if (count <= 0) {
+        return 0;
+    }
+    if (epptr() - pptr() < count && !reserve(length() + (size_t) count)) {
+        return 0;
+    }
+    memcpy(pptr(), string, (size_t) count);
+    pbump((int) count);
+    return count;
+}
+
+#pragma mark - DescriptionStream
+DescriptionStream::DescriptionStream() : std::ostream(nullptr), m_buffer()
+{
+    rdbuf(&m_buffer);
+    imbue(std::locale::classic());
+}
+
+DescriptionStream::DescriptionStream(char* arena, size_t capacity)
+: std::ostream(nullptr), m_buffer(arena, capacity)
+{
+    rdbuf(&m_buffer);
+    imbue(std::locale::classic());
+}
+
+StringView DescriptionStream::getDescription() const
+{
+    return StringView(m_buffer.data(), m_buffer.length());
+}
+
+const char* DescriptionStream::data() const
+{
+    return m_buffer.data();
+}
+
+size_t DescriptionStream::length() const
+{
+    return m_buffer.length();
+}
+
+void DescriptionStream::clear()
+{
+    std::ostream::clear();
+    flags(std::ios_base::skipws | std::ios_base::dec);
+    precision(6);
+    width(0);
+    fill(' ');
+    m_buffer.clear();
+}
+
+void DescriptionStream::reserve(size_t length)
+{
+    if (!m_buffer.reserve(m_buffer.length() + length)) {
+        setstate(std::ios_base::badbit);
+    }
+}
+
+void DescriptionStream::describeUnsignedInteger(std::ostream& stream, uint64_t value)
+{
+    char digits[20];
+    char* end = digits + sizeof(digits);
+    char* begin = end;
+    do {
+        *--begin = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    stream.write(begin, end - begin);
+}
+
+void DescriptionStream::describeInteger(std::ostream& stream, int64_t value)
+{
+    if (value < 0) {
+        stream.put('-');
+        describeUnsignedInteger(stream, 0 - (uint64_t) value);
+    } else {
+        describeUnsignedInteger(stream, (uint64_t) value);
+    }
+}
+
+#pragma mark - Threaded
+// Heap memory of the threaded stream larger than it will be released after each describing.
+static constexpr const size_t DescriptionStreamMaxRetainedCapacity = 64 * 1024;
+
+static DescriptionStream*& threadedDescriptionStream()
+{
+    thread_local std::unique_ptr<DescriptionStream> s_stream(new DescriptionStream());
+    thread_local DescriptionStream* s_available = s_stream.get();
+    return s_available;
+}
+
+DescriptionStream::Threaded::Threaded() : m_stream(nullptr), m_borrowed(false)
+{
+    DescriptionStream*& available = threadedDescriptionStream();
+    if (available != nullptr) {
+        m_stream = available;
+        m_borrowed = true;
+        available = nullptr;
+    } else {
+        m_stream = new DescriptionStream();
+    }
+    m_stream->clear();
+}
+
+DescriptionStream::Threaded::~Threaded()
+{
+    if (m_borrowed) {
+        m_stream->m_buffer.shrink(DescriptionStreamMaxRetainedCapacity);
+        threadedDescriptionStream() = m_stream;
+    } else {
+        delete m_stream;
+    }
+}
+
+DescriptionStream& DescriptionStream::Threaded::get()
+{
+    return *m_stream;
+}
+
+} // namespace Syntax
+
+} // namespace WCDB
@@ -0,0 +1,113 @@
+//
+// Created by agent on 2026/10/17
+//
+
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "StringView.hpp"
+#include <ostream>
+#include <streambuf>
+
+namespace WCDB {
+
+namespace Syntax {
+
+/*
+ * A growable byte buffer for describing identifiers.
+ * It writes into the caller-supplied arena first and grows into heap when the arena is full.
+ */
+class WCDB_API DescriptionBuffer final : public std::streambuf {
+public:
+    DescriptionBuffer();
+    DescriptionBuffer(char* arena, size_t capacity);
+    ~DescriptionBuffer() override;
+
+    DescriptionBuffer(const DescriptionBuffer&) = delete;
+    DescriptionBuffer& operator=(const DescriptionBuffer&) = delete;
+
+    const char* data() const;
+    size_t length() const;
+
+    // Memory is kept for reusing.
+    void clear();
+    // Heap memory larger than the capacity will be released.
+    void shrink(size_t capacity);
+    bool reserve(size_t capacity);
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char* string, std::streamsize count) override;
+
+private:
+    char* m_arena;
+    size_t m_arenaCapacity;
+    char* m_heap;
+    size_t m_heapCapacity;
+};
+
+class WCDB_API DescriptionStream final : public std::ostream {
+public:
+    DescriptionStream();
+    DescriptionStream(char* arena, size_t capacity);
+
+    // Copy the described content with exactly one allocation.
+    StringView getDescription() const;
+    const char* data() const;
+    size_t length() const;
+    // Reset the content and the format state, e.g. precision.
+    void clear();
+    // Grow the buffer at once for the content of known length that will be written.
+    void reserve(size_t length);
+
+    // Integers are written without going through the locale-aware std::num_put.
+    static void describeInteger(std::ostream& stream, int64_t value);
+    static void describeUnsignedInteger(std::ostream& stream, uint64_t value);
+
+#pragma mark - Threaded
+public:
+    /*
+     * Borrow the reusable stream of current thread, which saves the allocations and the locale construction of std::ostringstream.
+     * A temporary stream will be used if the threaded one is already borrowed, e.g. describing is reentered.
+     */
+    class WCDB_API Threaded final {
+    public:
+        Threaded();
+        ~Threaded();
+
+        Threaded(const Threaded&) = delete;
+        Threaded& operator=(const Threaded&) = delete;
+
+        DescriptionStream& get();
+
+    private:
+        DescriptionStream* m_stream;
+        bool m_borrowed;
+    };
+
+private:
+    DescriptionBuffer m_buffer;
+};
+
+} // namespace Syntax
+
+} // namespace WCDB
@@ -24,6 +24,7 @@
 
 #include "Syntax.h"
 #include "SyntaxAssertion.hpp"
+#include "SyntaxDescriptionStream.hpp"
 #include "SyntaxEnum.hpp"
 
 namespace WCDB {
@@ -58,7 +59,7 @@ bool BindParameter::describle(std::ostream& stream) const
     stream << switcher;
     switch (switcher) {
     case Switch::QuestionSign:
-        stream << n;
+        DescriptionStream::describeInteger(stream, n);
         break;
     case Switch::ColonSign:
     case Switch::AtSign:
@@ -24,6 +24,7 @@
 
 #include "Syntax.h"
 #include "SyntaxAssertion.hpp"
+#include "SyntaxDescriptionStream.hpp"
 
 namespace WCDB {
 
@@ -34,9 +35,9 @@ Identifier::~Identifier() = default;
 StringView Identifier::getDescription() const
 {
     if (isValid()) {
-        std::ostringstream stream;
-        if (describle(stream)) {
-            return stream.str();
+        DescriptionStream::Threaded stream;
+        if (describle(stream.get())) {
+            return stream.get().getDescription();
         }
         WCTAssert(false);
     }
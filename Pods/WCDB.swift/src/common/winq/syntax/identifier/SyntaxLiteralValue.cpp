@@ -24,6 +24,7 @@
 
 #include "Syntax.h"
 #include "SyntaxAssertion.hpp"
+#include "SyntaxDescriptionStream.hpp"
 #include <limits>
 
 namespace WCDB {
@@ -43,14 +44,16 @@ bool LiteralValue::describle(std::ostream& stream) const
     switch (switcher) {
     case Switch::StringView: {
         stream << "'";
-        for (int i = 0; i < stringValue.length(); i++) {
-            const auto character = stringValue.at(i);
-            if (character != '\'') {
-                stream << character;
-            } else {
+        const char* data = stringValue.data();
+        size_t begin = 0;
+        for (size_t i = 0; i < stringValue.length(); i++) {
+            if (data[i] == '\'') {
+                stream.write(data + begin, i - begin);
                 stream << "''";
+                begin = i + 1;
             }
         }
+        stream.write(data + begin, stringValue.length() - begin);
         stream << "'";
     } break;
     case Switch::Null:
@@ -61,10 +64,10 @@ bool LiteralValue::describle(std::ostream& stream) const
         stream << floatValue;
         break;
     case Switch::Integer:
-        stream << integerValue;
+        DescriptionStream::describeInteger(stream, integerValue);
         break;
     case Switch::UnsignedInteger:
-        stream << unsignedIntegerValue;
+        DescriptionStream::describeUnsignedInteger(stream, unsignedIntegerValue);
         break;
     case Switch::Bool:
         stream << (boolValue ? "TRUE" : "FALSE");
@@ -913,10 +913,42 @@ public extension Database {
         WCTAPIBridge.configPinyinDict(pinyinDict)
     }
 
+    /// Configure the pinyin dict with a file saved by `savePinyinDict(to:)`.
+    /// The file is memory-mapped instead of being built from a dictionary again.
+    /// - Parameter path: Path of the saved file.
+    /// - Returns: false if the file is not found or not a valid dict file.
+    static func config(pinyinDictFile path: String) -> Bool {
+        return WCTAPIBridge.configPinyinDictFile(path)
+    }
+
+    /// Save the pinyin dict configured by `config(pinyinDict:)` to a file.
+    /// Only the keys that are single characters in Basic Multilingual Plane are saved.
+    /// - Parameter path: Path of the file to save.
+    /// - Returns: false if the pinyin dict is not configured or it fails to write the file.
+    static func savePinyinDict(to path: String) -> Bool {
+        return WCTAPIBridge.savePinyinDict(path)
+    }
+
     /// Configure the mapping relationship between traditional Chinese characters and simplified Chinese characters.
     static func config(traditionalChineseDict: [String /*Traditional Chinese character*/ : String /*Simplified Chinese character*/]) {
         WCTAPIBridge.configTraditionalChineseDict(traditionalChineseDict)
     }
+
+    /// Configure the traditional Chinese dict with a file saved by `saveTraditionalChineseDict(to:)`.
+    /// The file is memory-mapped instead of being built from a dictionary again.
+    /// - Parameter path: Path of the saved file.
+    /// - Returns: false if the file is not found or not a valid dict file.
+    static func config(traditionalChineseDictFile path: String) -> Bool {
+        return WCTAPIBridge.configTraditionalChineseDictFile(path)
+    }
+
+    /// Save the traditional Chinese dict configured by `config(traditionalChineseDict:)` to a file.
+    /// Only the keys that are single characters in Basic Multilingual Plane are saved.
+    /// - Parameter path: Path of the file to save.
+    /// - Returns: false if the traditional Chinese dict is not configured or it fails to write the file.
+    static func saveTraditionalChineseDict(to path: String) -> Bool {
+        return WCTAPIBridge.saveTraditionalChineseDict(path)
+    }
 }
 
 // checkpoint
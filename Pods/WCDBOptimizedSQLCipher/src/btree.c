@@ -9946,6 +9946,8 @@ char *sqlite3BtreeIntegrityCheck(
   BtShared *pBt = p->pBt;
   u64 savedDbFlags = pBt->db->flags;
   char zErr[100];
+  int bPartial = 0;            /* True if not checking all btrees */
+  int bCkFreelist = 1;         /* True to scan the freelist */
   VVA_ONLY( int nRef );
 
   sqlite3BtreeEnter(p);
@@ -9969,6 +9971,16 @@ char *sqlite3BtreeIntegrityCheck(
     goto integrity_ck_cleanup;
   }
 
+  /* A leading zero root page means that only the listed btrees are
+  ** checked. The freelist is checked along with the schema table only.
+  ** Since the page map only covers the listed btrees, a partial check
+  ** does NOT detect pages that are never used, nor a page that is
+  ** referenced by a listed btree and another one that is not listed. */
+  if( aRoot[0]==0 ){
+    bPartial = 1;
+    if( nRoot<2 || aRoot[1]!=1 ) bCkFreelist = 0;
+  }
+
   sCheck.aPgRef = sqlite3MallocZero((sCheck.nPage / 8)+ 1);
   if( !sCheck.aPgRef ){
     sCheck.mallocFailed = 1;
@@ -9985,15 +9997,19 @@ char *sqlite3BtreeIntegrityCheck(
 
   /* Check the integrity of the freelist
   */
-  sCheck.zPfx = "Main freelist: ";
-  checkList(&sCheck, 1, get4byte(&pBt->pPage1->aData[32]),
-            get4byte(&pBt->pPage1->aData[36]));
-  sCheck.zPfx = 0;
+  if( bCkFreelist ){
+    sCheck.zPfx = "Main freelist: ";
+    checkList(&sCheck, 1, get4byte(&pBt->pPage1->aData[32]),
+              get4byte(&pBt->pPage1->aData[36]));
+    sCheck.zPfx = 0;
+  }
 
   /* Check all the tables.
   */
 #ifndef SQLITE_OMIT_AUTOVACUUM
-  if( pBt->autoVacuum ){
+  if( bPartial ){
+    /* The max root page can only be told from all the btrees */
+  }else if( pBt->autoVacuum ){
     int mx = 0;
     int mxInHdr;
     for(i=0; (int)i<nRoot; i++) if( mx<aRoot[i] ) mx = aRoot[i];
@@ -10026,7 +10042,7 @@ char *sqlite3BtreeIntegrityCheck(
 
   /* Make sure every page in the file is referenced
   */
-  for(i=1; i<=sCheck.nPage && sCheck.mxErr; i++){
+  for(i=1; !bPartial && i<=sCheck.nPage && sCheck.mxErr; i++){
 #ifdef SQLITE_OMIT_AUTOVACUUM
     if( getPageReferenced(&sCheck, i)==0 ){
       checkAppendMsg(&sCheck, "Page %d is never used", i);
@@ -745,6 +745,39 @@ void* sqlite3_getCipherContext(sqlite3 *db, const char* schema) {
   return sqlite3PagerGetCodec(pDb->pBt->pBt->pPager);
 }
 
+/*
+ * Decrypt nPage contiguous pages starting at pgno from data to out.
+ * Unlike sqlite3Codec, the plaintext is written to the buffer of caller instead of the
+ * shared buffer of codec context, so that it can be called from multiple threads at the
+ * same time once the keys are derived.
+ *
+ * returns the number of pages decrypted, which is less than nPage if any of them fails.
+ */
+int sqlite3CodecDecryptPages(void *iCtx, const void *data, void *out, Pgno pgno, int nPage) {
+  codec_ctx *ctx = (codec_ctx *) iCtx;
+  int page_sz = sqlcipher_codec_ctx_get_pagesize(ctx);
+  int plaintext_header_sz = sqlcipher_codec_ctx_get_plaintext_header_size(ctx);
+  unsigned char *pData = (unsigned char *) data;
+  unsigned char *pOut = (unsigned char *) out;
+  int i, offset;
+
+  if(sqlcipher_codec_key_derive(ctx) != SQLITE_OK) {
+    return 0;
+  }
+
+  for(i = 0; i < nPage; i++, pgno++, pData += page_sz, pOut += page_sz) {
+    offset = 0;
+    if(pgno == 1) {
+      offset = plaintext_header_sz ? plaintext_header_sz : FILE_HEADER_SZ;
+      memcpy(pOut, plaintext_header_sz ? pData : (void *) SQLITE_FILE_HEADER, offset);
+    }
+    if(sqlcipher_page_cipher(ctx, CIPHER_READ_CTX, pgno, CIPHER_DECRYPT, page_sz - offset, pData + offset, pOut + offset) != SQLITE_OK) {
+      break;
+    }
+  }
+  return i;
+}
+
 #endif
 
 static void sqlite3FreeCodecArg(void *pCodecArg) {
@@ -290,6 +290,7 @@ const char* sqlcipher_codec_get_provider_version(codec_ctx *ctx);
 int sqlcipher_codec_hmac_sha1(const codec_ctx *ctx, const unsigned char *hmac_key, int key_sz,
                          unsigned char* in, int in_sz, unsigned char *in2, int in2_sz,
                          unsigned char *out);
+int sqlcipher_codec_keyed_hash(void *iCtx, const void *key, int nKey, const void *data, int nData, void *out);
 
 int sqlcipher_set_default_plaintext_header_size(int size);
 int sqlcipher_get_default_plaintext_header_size(void);
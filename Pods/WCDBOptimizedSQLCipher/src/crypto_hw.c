@@ -0,0 +1,415 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+** Hardware accelerated page cipher and hmac.
+**
+** This is not a standalone provider. sqlcipher_hw_setup() is called after the
+** default provider is set up, and it only replaces the cipher and hmac callbacks
+** when the CPU supports AES-NI and SHA extensions. Anything that is not supported
+** here, e.g. HMAC_SHA512 or a key size other than AES-256, falls back to the
+** callbacks of the default provider.
+**
+** Only x86 is accelerated here. On ARM, including the arm64 iOS and macOS devices
+** this pod ships on, sqlcipher_hw_setup() keeps the callbacks of the default provider
+** untouched: the CommonCrypto provider (SQLCIPHER_CRYPTO_CC) already runs AES and SHA
+** on the ARMv8 crypto extensions, so a hand-written path would only save the setup
+** of the cryptor for each page, which is not worth a second implementation to verify.
+*/
+/* BEGIN SQLCIPHER */
+#ifdef SQLITE_HAS_CODEC
+#include "crypto.h"
+#include "sqlcipher.h"
+
+#if !defined(SQLCIPHER_OMIT_CRYPTO_HW) && (defined(__x86_64__) || defined(__i386__)) \
+    && (defined(__GNUC__) || defined(__clang__))
+#define SQLCIPHER_CRYPTO_HW_X86 1
+#endif
+
+int sqlcipher_hw_setup(sqlcipher_provider *p);
+
+#ifdef SQLCIPHER_CRYPTO_HW_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SQLCIPHER_HW_AES_KEY_SZ 32
+#define SQLCIPHER_HW_AES_ROUNDS 14
+#define SQLCIPHER_HW_AES_BLOCK_SZ 16
+#define SQLCIPHER_HW_SHA_BLOCK_SZ 64
+
+#define SQLCIPHER_HW_TARGET_AES __attribute__((target("aes,sse4.1")))
+#define SQLCIPHER_HW_TARGET_SHA __attribute__((target("sha,sse4.1")))
+
+static int (*sqlcipher_hw_base_cipher)(void *ctx, int mode, unsigned char *key, int key_sz, unsigned char *iv, unsigned char *in, int in_sz, unsigned char *out) = NULL;
+static int (*sqlcipher_hw_base_hmac)(void *ctx, int algorithm, unsigned char *hmac_key, int key_sz, unsigned char *in, int in_sz, unsigned char *in2, int in2_sz, unsigned char *out) = NULL;
+
+/*
+** AES-256-CBC
+*/
+
+#define SQLCIPHER_HW_AES_EXPAND_EVEN(rcon) \
+  tmp = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(k1, rcon), 0xff); \
+  k0 = _mm_xor_si128(k0, _mm_slli_si128(k0, 4)); \
+  k0 = _mm_xor_si128(k0, _mm_slli_si128(k0, 4)); \
+  k0 = _mm_xor_si128(k0, _mm_slli_si128(k0, 4)); \
+  k0 = _mm_xor_si128(k0, tmp); \
+  *rk++ = k0;
+
+#define SQLCIPHER_HW_AES_EXPAND_ODD() \
+  tmp = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(k0, 0x00), 0xaa); \
+  k1 = _mm_xor_si128(k1, _mm_slli_si128(k1, 4)); \
+  k1 = _mm_xor_si128(k1, _mm_slli_si128(k1, 4)); \
+  k1 = _mm_xor_si128(k1, _mm_slli_si128(k1, 4)); \
+  k1 = _mm_xor_si128(k1, tmp); \
+  *rk++ = k1;
+
+SQLCIPHER_HW_TARGET_AES
+static void sqlcipher_hw_aes_expand_key(const unsigned char *key, __m128i *rk) {
+  __m128i k0 = _mm_loadu_si128((const __m128i *) key);
+  __m128i k1 = _mm_loadu_si128((const __m128i *) (key + 16));
+  __m128i tmp;
+  *rk++ = k0;
+  *rk++ = k1;
+  SQLCIPHER_HW_AES_EXPAND_EVEN(0x01) SQLCIPHER_HW_AES_EXPAND_ODD()
+  SQLCIPHER_HW_AES_EXPAND_EVEN(0x02) SQLCIPHER_HW_AES_EXPAND_ODD()
+  SQLCIPHER_HW_AES_EXPAND_EVEN(0x04) SQLCIPHER_HW_AES_EXPAND_ODD()
+  SQLCIPHER_HW_AES_EXPAND_EVEN(0x08) SQLCIPHER_HW_AES_EXPAND_ODD()
+  SQLCIPHER_HW_AES_EXPAND_EVEN(0x10) SQLCIPHER_HW_AES_EXPAND_ODD()
+  SQLCIPHER_HW_AES_EXPAND_EVEN(0x20) SQLCIPHER_HW_AES_EXPAND_ODD()
+  SQLCIPHER_HW_AES_EXPAND_EVEN(0x40)
+}
+
+SQLCIPHER_HW_TARGET_AES
+static void sqlcipher_hw_aes_cbc_encrypt(const __m128i *rk, const unsigned char *iv, const unsigned char *in, int nblocks, unsigned char *out) {
+  __m128i x = _mm_loadu_si128((const __m128i *) iv);
+  int i, r;
+  /* each block depends on the previous one, so encryption can't be parallelized */
+  for(i = 0; i < nblocks; i++) {
+    x = _mm_xor_si128(x, _mm_loadu_si128((const __m128i *) (in + i * SQLCIPHER_HW_AES_BLOCK_SZ)));
+    x = _mm_xor_si128(x, rk[0]);
+    for(r = 1; r < SQLCIPHER_HW_AES_ROUNDS; r++) {
+      x = _mm_aesenc_si128(x, rk[r]);
+    }
+    x = _mm_aesenclast_si128(x, rk[SQLCIPHER_HW_AES_ROUNDS]);
+    _mm_storeu_si128((__m128i *) (out + i * SQLCIPHER_HW_AES_BLOCK_SZ), x);
+  }
+}
+
+/* applies one step to the 8 blocks in flight */
+#define SQLCIPHER_HW_AES_PARALLEL 8
+#define SQLCIPHER_HW_AES_EACH(op) \
+  op(x0, 0) op(x1, 1) op(x2, 2) op(x3, 3) op(x4, 4) op(x5, 5) op(x6, 6) op(x7, 7)
+#define SQLCIPHER_HW_AES_LOAD(x, j) \
+  x = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (in + (i + j) * SQLCIPHER_HW_AES_BLOCK_SZ)), drk[0]);
+#define SQLCIPHER_HW_AES_DEC(x, j) x = _mm_aesdec_si128(x, k);
+#define SQLCIPHER_HW_AES_DECLAST(x, j) x = _mm_aesdeclast_si128(x, k);
+#define SQLCIPHER_HW_AES_CHAIN(x, j) \
+  x = _mm_xor_si128(x, j == 0 ? prev : _mm_loadu_si128((const __m128i *) (in + (i + j - 1) * SQLCIPHER_HW_AES_BLOCK_SZ)));
+#define SQLCIPHER_HW_AES_STORE(x, j) \
+  _mm_storeu_si128((__m128i *) (out + (i + j) * SQLCIPHER_HW_AES_BLOCK_SZ), x);
+
+SQLCIPHER_HW_TARGET_AES
+static void sqlcipher_hw_aes_cbc_decrypt(const __m128i *rk, const unsigned char *iv, const unsigned char *in, int nblocks, unsigned char *out) {
+  __m128i drk[SQLCIPHER_HW_AES_ROUNDS + 1];
+  __m128i prev = _mm_loadu_si128((const __m128i *) iv);
+  __m128i k, c, x0, x1, x2, x3, x4, x5, x6, x7;
+  int i, r;
+
+  drk[0] = rk[SQLCIPHER_HW_AES_ROUNDS];
+  for(r = 1; r < SQLCIPHER_HW_AES_ROUNDS; r++) {
+    drk[r] = _mm_aesimc_si128(rk[SQLCIPHER_HW_AES_ROUNDS - r]);
+  }
+  drk[SQLCIPHER_HW_AES_ROUNDS] = rk[0];
+
+  /* unlike encryption, all the ciphertext blocks are known in advance, so several of them are
+     decrypted in flight to hide the latency of aesdec. the ciphertext is reloaded for chaining
+     before any plaintext of the batch is stored, which makes in == out safe. */
+  for(i = 0; i + SQLCIPHER_HW_AES_PARALLEL <= nblocks; i += SQLCIPHER_HW_AES_PARALLEL) {
+    SQLCIPHER_HW_AES_EACH(SQLCIPHER_HW_AES_LOAD)
+    for(r = 1; r < SQLCIPHER_HW_AES_ROUNDS; r++) {
+      k = drk[r];
+      SQLCIPHER_HW_AES_EACH(SQLCIPHER_HW_AES_DEC)
+    }
+    k = drk[SQLCIPHER_HW_AES_ROUNDS];
+    SQLCIPHER_HW_AES_EACH(SQLCIPHER_HW_AES_DECLAST)
+    SQLCIPHER_HW_AES_EACH(SQLCIPHER_HW_AES_CHAIN)
+    prev = _mm_loadu_si128((const __m128i *) (in + (i + SQLCIPHER_HW_AES_PARALLEL - 1) * SQLCIPHER_HW_AES_BLOCK_SZ));
+    SQLCIPHER_HW_AES_EACH(SQLCIPHER_HW_AES_STORE)
+  }
+  for(; i < nblocks; i++) {
+    c = _mm_loadu_si128((const __m128i *) (in + i * SQLCIPHER_HW_AES_BLOCK_SZ));
+    x0 = _mm_xor_si128(c, drk[0]);
+    for(r = 1; r < SQLCIPHER_HW_AES_ROUNDS; r++) {
+      x0 = _mm_aesdec_si128(x0, drk[r]);
+    }
+    x0 = _mm_aesdeclast_si128(x0, drk[SQLCIPHER_HW_AES_ROUNDS]);
+    _mm_storeu_si128((__m128i *) (out + i * SQLCIPHER_HW_AES_BLOCK_SZ), _mm_xor_si128(x0, prev));
+    prev = c;
+  }
+  sqlcipher_memset(drk, 0, sizeof(drk));
+}
+
+static int sqlcipher_hw_cipher(void *ctx, int mode, unsigned char *key, int key_sz, unsigned char *iv, unsigned char *in, int in_sz, unsigned char *out) {
+  __m128i rk[SQLCIPHER_HW_AES_ROUNDS + 1];
+  if(key_sz != SQLCIPHER_HW_AES_KEY_SZ || in_sz % SQLCIPHER_HW_AES_BLOCK_SZ != 0) {
+    return sqlcipher_hw_base_cipher(ctx, mode, key, key_sz, iv, in, in_sz, out);
+  }
+  sqlcipher_hw_aes_expand_key(key, rk);
+  if(mode == CIPHER_ENCRYPT) {
+    sqlcipher_hw_aes_cbc_encrypt(rk, iv, in, in_sz / SQLCIPHER_HW_AES_BLOCK_SZ, out);
+  } else {
+    sqlcipher_hw_aes_cbc_decrypt(rk, iv, in, in_sz / SQLCIPHER_HW_AES_BLOCK_SZ, out);
+  }
+  sqlcipher_memset(rk, 0, sizeof(rk));
+  return SQLITE_OK;
+}
+
+/*
+** SHA-1 and SHA-256
+*/
+
+typedef struct {
+  int algorithm;
+  uint32_t state[8];
+  unsigned char block[SQLCIPHER_HW_SHA_BLOCK_SZ];
+  int block_sz;
+  uint64_t length;
+} sqlcipher_hw_sha_ctx;
+
+static const uint32_t sqlcipher_hw_sha256_k[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/* W[i] = SHA1MSG2(SHA1MSG1(W[i-4], W[i-3]) ^ W[i-2], W[i-1]), where W is a ring of the last 4 message words */
+#define SQLCIPHER_HW_SHA1_ROUNDS4(i, f) \
+  if(i >= 4) { \
+    msg[(i) & 3] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(msg[(i) & 3], msg[((i) + 1) & 3]), msg[((i) + 2) & 3]), msg[((i) + 3) & 3]); \
+  } \
+  e1 = (i) == 0 ? _mm_add_epi32(e0, msg[0]) : _mm_sha1nexte_epu32(e0, msg[(i) & 3]); \
+  e0 = abcd; \
+  abcd = _mm_sha1rnds4_epu32(abcd, e1, f);
+
+SQLCIPHER_HW_TARGET_SHA
+static void sqlcipher_hw_sha1_compress(uint32_t *state, const unsigned char *data, int nblocks) {
+  const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+  __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) state), 0x1b);
+  __m128i e0 = _mm_set_epi32(state[4], 0, 0, 0);
+  __m128i abcd_save, e_save, e1, msg[4];
+  int i;
+  for(; nblocks > 0; nblocks--, data += SQLCIPHER_HW_SHA_BLOCK_SZ) {
+    abcd_save = abcd;
+    e_save = e0;
+    for(i = 0; i < 4; i++) {
+      msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (data + i * 16)), mask);
+    }
+    SQLCIPHER_HW_SHA1_ROUNDS4(0, 0)  SQLCIPHER_HW_SHA1_ROUNDS4(1, 0)  SQLCIPHER_HW_SHA1_ROUNDS4(2, 0)
+    SQLCIPHER_HW_SHA1_ROUNDS4(3, 0)  SQLCIPHER_HW_SHA1_ROUNDS4(4, 0)  SQLCIPHER_HW_SHA1_ROUNDS4(5, 1)
+    SQLCIPHER_HW_SHA1_ROUNDS4(6, 1)  SQLCIPHER_HW_SHA1_ROUNDS4(7, 1)  SQLCIPHER_HW_SHA1_ROUNDS4(8, 1)
+    SQLCIPHER_HW_SHA1_ROUNDS4(9, 1)  SQLCIPHER_HW_SHA1_ROUNDS4(10, 2) SQLCIPHER_HW_SHA1_ROUNDS4(11, 2)
+    SQLCIPHER_HW_SHA1_ROUNDS4(12, 2) SQLCIPHER_HW_SHA1_ROUNDS4(13, 2) SQLCIPHER_HW_SHA1_ROUNDS4(14, 2)
+    SQLCIPHER_HW_SHA1_ROUNDS4(15, 3) SQLCIPHER_HW_SHA1_ROUNDS4(16, 3) SQLCIPHER_HW_SHA1_ROUNDS4(17, 3)
+    SQLCIPHER_HW_SHA1_ROUNDS4(18, 3) SQLCIPHER_HW_SHA1_ROUNDS4(19, 3)
+    e0 = _mm_sha1nexte_epu32(e0, e_save);
+    abcd = _mm_add_epi32(abcd, abcd_save);
+  }
+  _mm_storeu_si128((__m128i *) state, _mm_shuffle_epi32(abcd, 0x1b));
+  state[4] = (uint32_t) _mm_extract_epi32(e0, 3);
+}
+
+/* W[i] = SHA256MSG2(SHA256MSG1(W[i-4], W[i-3]) + (W[i-2]:W[i-1] >> 32), W[i-1]) */
+#define SQLCIPHER_HW_SHA256_ROUNDS4(i) \
+  if(i >= 4) { \
+    msg[(i) & 3] = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(msg[(i) & 3], msg[((i) + 1) & 3]), _mm_alignr_epi8(msg[((i) + 3) & 3], msg[((i) + 2) & 3], 4)), msg[((i) + 3) & 3]); \
+  } \
+  wk = _mm_add_epi32(msg[(i) & 3], _mm_loadu_si128((const __m128i *) (sqlcipher_hw_sha256_k + (i) * 4))); \
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk); \
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0e));
+
+SQLCIPHER_HW_TARGET_SHA
+static void sqlcipher_hw_sha256_compress(uint32_t *state, const unsigned char *data, int nblocks) {
+  const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  __m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) state), 0xb1);
+  __m128i hgfe = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) (state + 4)), 0x1b);
+  __m128i abef = _mm_alignr_epi8(dcba, hgfe, 8);
+  __m128i cdgh = _mm_blend_epi16(hgfe, dcba, 0xf0);
+  __m128i abef_save, cdgh_save, wk, msg[4];
+  int i;
+  for(; nblocks > 0; nblocks--, data += SQLCIPHER_HW_SHA_BLOCK_SZ) {
+    abef_save = abef;
+    cdgh_save = cdgh;
+    for(i = 0; i < 4; i++) {
+      msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (data + i * 16)), mask);
+    }
+    SQLCIPHER_HW_SHA256_ROUNDS4(0)  SQLCIPHER_HW_SHA256_ROUNDS4(1)  SQLCIPHER_HW_SHA256_ROUNDS4(2)
+    SQLCIPHER_HW_SHA256_ROUNDS4(3)  SQLCIPHER_HW_SHA256_ROUNDS4(4)  SQLCIPHER_HW_SHA256_ROUNDS4(5)
+    SQLCIPHER_HW_SHA256_ROUNDS4(6)  SQLCIPHER_HW_SHA256_ROUNDS4(7)  SQLCIPHER_HW_SHA256_ROUNDS4(8)
+    SQLCIPHER_HW_SHA256_ROUNDS4(9)  SQLCIPHER_HW_SHA256_ROUNDS4(10) SQLCIPHER_HW_SHA256_ROUNDS4(11)
+    SQLCIPHER_HW_SHA256_ROUNDS4(12) SQLCIPHER_HW_SHA256_ROUNDS4(13) SQLCIPHER_HW_SHA256_ROUNDS4(14)
+    SQLCIPHER_HW_SHA256_ROUNDS4(15)
+    abef = _mm_add_epi32(abef, abef_save);
+    cdgh = _mm_add_epi32(cdgh, cdgh_save);
+  }
+  dcba = _mm_shuffle_epi32(abef, 0x1b);
+  hgfe = _mm_shuffle_epi32(cdgh, 0xb1);
+  _mm_storeu_si128((__m128i *) state, _mm_blend_epi16(dcba, hgfe, 0xf0));
+  _mm_storeu_si128((__m128i *) (state + 4), _mm_alignr_epi8(hgfe, dcba, 8));
+}
+
+static int sqlcipher_hw_sha_digest_sz(int algorithm) {
+  return algorithm == SQLCIPHER_HMAC_SHA1 ? 20 : 32;
+}
+
+static void sqlcipher_hw_sha_compress(sqlcipher_hw_sha_ctx *ctx, const unsigned char *data, int nblocks) {
+  if(ctx->algorithm == SQLCIPHER_HMAC_SHA1) {
+    sqlcipher_hw_sha1_compress(ctx->state, data, nblocks);
+  } else {
+    sqlcipher_hw_sha256_compress(ctx->state, data, nblocks);
+  }
+}
+
+static void sqlcipher_hw_sha_init(sqlcipher_hw_sha_ctx *ctx, int algorithm) {
+  static const uint32_t sha1_iv[8] = {
+    0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0, 0, 0, 0
+  };
+  static const uint32_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+  };
+  ctx->algorithm = algorithm;
+  memcpy(ctx->state, algorithm == SQLCIPHER_HMAC_SHA1 ? sha1_iv : sha256_iv, sizeof(ctx->state));
+  ctx->block_sz = 0;
+  ctx->length = 0;
+}
+
+static void sqlcipher_hw_sha_update(sqlcipher_hw_sha_ctx *ctx, const unsigned char *in, int in_sz) {
+  int n;
+  ctx->length += in_sz;
+  if(ctx->block_sz > 0) {
+    n = SQLCIPHER_HW_SHA_BLOCK_SZ - ctx->block_sz;
+    if(n > in_sz) n = in_sz;
+    memcpy(ctx->block + ctx->block_sz, in, n);
+    ctx->block_sz += n;
+    in += n;
+    in_sz -= n;
+    if(ctx->block_sz < SQLCIPHER_HW_SHA_BLOCK_SZ) return;
+    sqlcipher_hw_sha_compress(ctx, ctx->block, 1);
+    ctx->block_sz = 0;
+  }
+  /* the whole page is compressed in place without being copied to the block buffer */
+  n = in_sz / SQLCIPHER_HW_SHA_BLOCK_SZ;
+  if(n > 0) {
+    sqlcipher_hw_sha_compress(ctx, in, n);
+    in += n * SQLCIPHER_HW_SHA_BLOCK_SZ;
+    in_sz -= n * SQLCIPHER_HW_SHA_BLOCK_SZ;
+  }
+  memcpy(ctx->block, in, in_sz);
+  ctx->block_sz = in_sz;
+}
+
+static void sqlcipher_hw_sha_final(sqlcipher_hw_sha_ctx *ctx, unsigned char *out) {
+  uint64_t bits = ctx->length * 8;
+  int i;
+  ctx->block[ctx->block_sz++] = 0x80;
+  if(ctx->block_sz > SQLCIPHER_HW_SHA_BLOCK_SZ - 8) {
+    memset(ctx->block + ctx->block_sz, 0, SQLCIPHER_HW_SHA_BLOCK_SZ - ctx->block_sz);
+    sqlcipher_hw_sha_compress(ctx, ctx->block, 1);
+    ctx->block_sz = 0;
+  }
+  memset(ctx->block + ctx->block_sz, 0, SQLCIPHER_HW_SHA_BLOCK_SZ - 8 - ctx->block_sz);
+  for(i = 0; i < 8; i++) {
+    ctx->block[SQLCIPHER_HW_SHA_BLOCK_SZ - 1 - i] = (unsigned char) (bits >> (i * 8));
+  }
+  sqlcipher_hw_sha_compress(ctx, ctx->block, 1);
+  for(i = 0; i < sqlcipher_hw_sha_digest_sz(ctx->algorithm) / 4; i++) {
+    out[i * 4] = (unsigned char) (ctx->state[i] >> 24);
+    out[i * 4 + 1] = (unsigned char) (ctx->state[i] >> 16);
+    out[i * 4 + 2] = (unsigned char) (ctx->state[i] >> 8);
+    out[i * 4 + 3] = (unsigned char) ctx->state[i];
+  }
+}
+
+static int sqlcipher_hw_hmac(void *ctx, int algorithm, unsigned char *hmac_key, int key_sz, unsigned char *in, int in_sz, unsigned char *in2, int in2_sz, unsigned char *out) {
+  unsigned char pad[SQLCIPHER_HW_SHA_BLOCK_SZ];
+  unsigned char inner[32];
+  sqlcipher_hw_sha_ctx sha;
+  int i;
+  if(in == NULL) return SQLITE_ERROR;
+  if((algorithm != SQLCIPHER_HMAC_SHA1 && algorithm != SQLCIPHER_HMAC_SHA256)
+     || key_sz > SQLCIPHER_HW_SHA_BLOCK_SZ) {
+    return sqlcipher_hw_base_hmac(ctx, algorithm, hmac_key, key_sz, in, in_sz, in2, in2_sz, out);
+  }
+
+  memset(pad, 0x36, sizeof(pad));
+  for(i = 0; i < key_sz; i++) pad[i] ^= hmac_key[i];
+  sqlcipher_hw_sha_init(&sha, algorithm);
+  sqlcipher_hw_sha_update(&sha, pad, sizeof(pad));
+  sqlcipher_hw_sha_update(&sha, in, in_sz);
+  if(in2 != NULL) sqlcipher_hw_sha_update(&sha, in2, in2_sz);
+  sqlcipher_hw_sha_final(&sha, inner);
+
+  memset(pad, 0x5c, sizeof(pad));
+  for(i = 0; i < key_sz; i++) pad[i] ^= hmac_key[i];
+  sqlcipher_hw_sha_init(&sha, algorithm);
+  sqlcipher_hw_sha_update(&sha, pad, sizeof(pad));
+  sqlcipher_hw_sha_update(&sha, inner, sqlcipher_hw_sha_digest_sz(algorithm));
+  sqlcipher_hw_sha_final(&sha, out);
+
+  sqlcipher_memset(pad, 0, sizeof(pad));
+  sqlcipher_memset(inner, 0, sizeof(inner));
+  sqlcipher_memset(&sha, 0, sizeof(sha));
+  return SQLITE_OK;
+}
+
+int sqlcipher_hw_setup(sqlcipher_provider *p) {
+  unsigned int eax, ebx, ecx, edx;
+  int sse41 = 0;
+  if(__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    sse41 = (ecx & bit_SSE4_1) != 0;
+    if(sse41 && (ecx & bit_AES) && p->cipher != NULL) {
+      sqlcipher_hw_base_cipher = p->cipher;
+      p->cipher = sqlcipher_hw_cipher;
+    }
+  }
+  if(sse41 && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)
+     && (ebx & bit_SHA) && p->hmac != NULL) {
+    sqlcipher_hw_base_hmac = p->hmac;
+    p->hmac = sqlcipher_hw_hmac;
+  }
+  return SQLITE_OK;
+}
+
+#else /* SQLCIPHER_CRYPTO_HW_X86 */
+
+/* The default provider is already hardware accelerated on ARM, see above. */
+int sqlcipher_hw_setup(sqlcipher_provider *p) {
+  return SQLITE_OK;
+}
+
+#endif /* SQLCIPHER_CRYPTO_HW_X86 */
+#endif
+/* END SQLCIPHER */
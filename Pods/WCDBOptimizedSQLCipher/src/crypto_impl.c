@@ -216,6 +216,11 @@ void sqlcipher_activate() {
     sqlcipher_openssl_setup(p);
 #else
 #error "NO DEFAULT SQLCIPHER CRYPTO PROVIDER DEFINED"
+#endif
+#ifndef SQLCIPHER_OMIT_CRYPTO_HW
+    /* replace the page cipher and hmac of the default provider with the hardware accelerated ones if available */
+    extern int sqlcipher_hw_setup(sqlcipher_provider *p);
+    sqlcipher_hw_setup(p);
 #endif
     CODEC_TRACE("sqlcipher_activate: calling sqlcipher_register_provider(%p)\n", p);
     sqlcipher_register_provider(p);
@@ -1534,6 +1539,18 @@ int sqlcipher_codec_hmac_sha1(const codec_ctx *ctx, const unsigned char *hmac_ke
   return ctx->provider->hmac(ctx->provider_ctx, SQLCIPHER_HMAC_SHA1, (unsigned char *)hmac_key, key_sz, in, in_sz, in2, in2_sz, out);
 }
 
+int sqlcipher_codec_keyed_hash(void *iCtx, const void *key, int nKey, const void *data, int nData, void *out) {
+  codec_ctx *ctx = (codec_ctx *) iCtx;
+  unsigned char empty = 0;
+  if(ctx == NULL) return SQLITE_ERROR;
+  /* providers reject null input even if it is empty */
+  if(data == NULL || nData == 0) {
+    data = &empty;
+    nData = 0;
+  }
+  return ctx->provider->hmac(ctx->provider_ctx, SQLCIPHER_HMAC_SHA256, (unsigned char *)key, nKey, (unsigned char *)data, nData, NULL, 0, out);
+}
+
 
 #endif
 /* END SQLCIPHER */
@@ -2366,6 +2366,31 @@ void *sqlite3_wal_checkpoint_handler(sqlite3 *db,
   return 0;
 #endif
 }
+
+/*
+** Passively checkpoint at most nFrame frames of database zDb, so that a
+** large wal can be drained in several short steps.
+*/
+int sqlite3_wal_checkpoint_frames(sqlite3 *db,
+                                  const char *zDb,
+                                  int nFrame,
+                                  int *pnLog,
+                                  int *pnCkpt){
+#ifndef SQLITE_OMIT_WAL
+  int rc;
+#ifdef SQLITE_ENABLE_API_ARMOR
+  if( !sqlite3SafetyCheckOk(db) ) return SQLITE_MISUSE_BKPT;
+#endif
+  db->nCkptFrame = nFrame>0 ? nFrame : 0;
+  rc = sqlite3_wal_checkpoint_v2(db, zDb, SQLITE_CHECKPOINT_PASSIVE, pnLog, pnCkpt);
+  db->nCkptFrame = 0;
+  return rc;
+#else
+  if( pnLog ) *pnLog = -1;
+  if( pnCkpt ) *pnCkpt = -1;
+  return SQLITE_OK;
+#endif
+}
 #endif //SQLITE_WCDB_CHECKPOINT_HANDLER
 
 #ifndef SQLITE_OMIT_WAL
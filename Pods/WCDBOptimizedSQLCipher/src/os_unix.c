@@ -179,11 +179,16 @@
 #define IS_LOCK_ERROR(x)  ((x != SQLITE_OK) && (x != SQLITE_BUSY))
 
 #ifdef SQLITE_WCDB_LOCK_HOOK
+/*
+** The context points to a pointer kept by the file for the hook, which is NULL
+** when the file is opened. The hook can keep its own state of the file in it,
+** so that it does not need to look up the state by path for each lock event.
+*/
 struct UnixLockHook {
-  void (*xWillLock)(void *parameter, const char* path, int lock);
-  void (*xLockDidChange)(void *parameter, const char* path, int lock);
-  void (*xWillShmLock)(void *parameter, const char* path, int flags, int mask);
-  void (*xShmLockDidChange)(void *parameter, const char* path, void* id, int sharedMask, int exclMask);
+  void (*xWillLock)(void *parameter, const char* path, void **context, int lock);
+  void (*xLockDidChange)(void *parameter, const char* path, void **context, int lock);
+  void (*xWillShmLock)(void *parameter, const char* path, void **context, int flags, int mask);
+  void (*xShmLockDidChange)(void *parameter, const char* path, void **context, void* id, int sharedMask, int exclMask);
   void *pArg;
 };
 typedef struct UnixLockHook UnixLockHook;
@@ -191,10 +196,10 @@ typedef struct UnixLockHook UnixLockHook;
 SQLITE_WSD static UnixLockHook unixLockHook = { 0 };
 #define unixLockHook GLOBAL(UnixLockHook *, unixLockHook)
 
-int sqlite3_lock_hook(void (*xWillLock)(void *pArg, const char* zPath, int eLock),
-                      void (*xLockDidChange)(void *pArg, const char* zPath, int eLock),
-                      void (*xWillShmLock)(void *pArg, const char* zPath, int flags, int mask),
-                      void (*xShmLockDidChange)(void *pArg, const char* zPath, void* id, int sharedMask, int exclMask),
+int sqlite3_lock_hook(void (*xWillLock)(void *pArg, const char* zPath, void **pCtx, int eLock),
+                      void (*xLockDidChange)(void *pArg, const char* zPath, void **pCtx, int eLock),
+                      void (*xWillShmLock)(void *pArg, const char* zPath, void **pCtx, int flags, int mask),
+                      void (*xShmLockDidChange)(void *pArg, const char* zPath, void **pCtx, void* id, int sharedMask, int exclMask),
                       void *pArg) {
   if( sqlite3GlobalConfig.isInit ) return SQLITE_MISUSE_BKPT;
   unixLockHook.xWillLock = xWillLock;
@@ -240,6 +245,9 @@ struct unixFile {
   void *lockingContext;               /* Locking style specific state */
   UnixUnusedFd *pPreallocatedUnused;  /* Pre-allocated UnixUnusedFd */
   const char *zPath;                  /* Name of the file */
+#ifdef SQLITE_WCDB_LOCK_HOOK
+  void *pLockHookCtx;                 /* Context of lock hook for this file */
+#endif
   unixShm *pShm;                      /* Shared memory segment information */
   int szChunk;                        /* Configured by FCNTL_CHUNK_SIZE */
 #if SQLITE_MAX_MMAP_SIZE>0
@@ -1387,7 +1395,7 @@ static void releaseInodeInfo(unixFile *pFile){
       }
 #ifdef SQLITE_WCDB_LOCK_HOOK
       if (unixLockHook.xLockDidChange != NULL) {
-        unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, NO_LOCK);
+        unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, &pFile->pLockHookCtx, NO_LOCK);
       }
 #endif
       sqlite3_mutex_free(pInode->pLockMutex);
@@ -1771,7 +1779,7 @@ static int unixLock(sqlite3_file *id, int eFileLock){
 
 #ifdef SQLITE_WCDB_LOCK_HOOK
   if (unixLockHook.xWillLock != NULL) {
-    unixLockHook.xWillLock(unixLockHook.pArg, pFile->zPath, eFileLock);
+    unixLockHook.xWillLock(unixLockHook.pArg, pFile->zPath, &pFile->pLockHookCtx, eFileLock);
   }
 #endif
     
@@ -1917,7 +1925,7 @@ static int unixLock(sqlite3_file *id, int eFileLock){
     pInode->eFileLock = eFileLock;
 #ifdef SQLITE_WCDB_LOCK_HOOK
     if (unixLockHook.xLockDidChange != NULL) {
-      unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, pInode->eFileLock);
+      unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, &pFile->pLockHookCtx, pInode->eFileLock);
     }
 #endif
   }else if( eFileLock==EXCLUSIVE_LOCK ){
@@ -1925,7 +1933,7 @@ static int unixLock(sqlite3_file *id, int eFileLock){
     pInode->eFileLock = PENDING_LOCK;
 #ifdef SQLITE_WCDB_LOCK_HOOK
     if (unixLockHook.xLockDidChange != NULL) {
-      unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, pInode->eFileLock);
+      unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, &pFile->pLockHookCtx, pInode->eFileLock);
     }
 #endif
   }
@@ -2076,7 +2084,7 @@ static int posixUnlock(sqlite3_file *id, int eFileLock, int handleNFSUnlock){
       pInode->eFileLock = SHARED_LOCK;
 #ifdef SQLITE_WCDB_LOCK_HOOK
       if (unixLockHook.xLockDidChange != NULL) {
-        unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, pInode->eFileLock);
+        unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, &pFile->pLockHookCtx, pInode->eFileLock);
       }
 #endif
     }else{
@@ -2099,7 +2107,7 @@ static int posixUnlock(sqlite3_file *id, int eFileLock, int handleNFSUnlock){
         pInode->eFileLock = NO_LOCK;
 #ifdef SQLITE_WCDB_LOCK_HOOK
         if (unixLockHook.xLockDidChange != NULL) {
-          unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, pInode->eFileLock);
+          unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, &pFile->pLockHookCtx, pInode->eFileLock);
         }
 #endif
       }else{
@@ -2109,7 +2117,7 @@ static int posixUnlock(sqlite3_file *id, int eFileLock, int handleNFSUnlock){
         pFile->eFileLock = NO_LOCK;
 #ifdef SQLITE_WCDB_LOCK_HOOK
         if (unixLockHook.xLockDidChange != NULL) {
-          unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, pInode->eFileLock);
+          unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, &pFile->pLockHookCtx, pInode->eFileLock);
         }
 #endif
       }
@@ -3020,7 +3028,7 @@ static int afpLock(sqlite3_file *id, int eFileLock){
   
 #ifdef SQLITE_WCDB_LOCK_HOOK
   if (unixLockHook.xWillLock != NULL) {
-    unixLockHook.xWillLock(unixLockHook.pArg, pFile->zPath, eFileLock);
+    unixLockHook.xWillLock(unixLockHook.pArg, pFile->zPath, &pFile->pLockHookCtx, eFileLock);
   }
 #endif
 
@@ -3159,7 +3167,7 @@ static int afpLock(sqlite3_file *id, int eFileLock){
     pInode->eFileLock = eFileLock;
 #ifdef SQLITE_WCDB_LOCK_HOOK
     if (unixLockHook.xLockDidChange != NULL) {
-      unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, pInode->eFileLock);
+      unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, &pFile->pLockHookCtx, pInode->eFileLock);
     }
 #endif
   }else if( eFileLock==EXCLUSIVE_LOCK ){
@@ -3167,7 +3175,7 @@ static int afpLock(sqlite3_file *id, int eFileLock){
     pInode->eFileLock = PENDING_LOCK;
 #ifdef SQLITE_WCDB_LOCK_HOOK
     if (unixLockHook.xLockDidChange != NULL) {
-      unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, pInode->eFileLock);
+      unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, &pFile->pLockHookCtx, pInode->eFileLock);
     }
 #endif
   }
@@ -3252,7 +3260,7 @@ static int afpUnlock(sqlite3_file *id, int eFileLock) {
       pInode->eFileLock = SHARED_LOCK;
 #ifdef SQLITE_WCDB_LOCK_HOOK
       if (unixLockHook.xLockDidChange != NULL) {
-        unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, pInode->eFileLock);
+        unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, &pFile->pLockHookCtx, pInode->eFileLock);
       }
 #endif
     }
@@ -3277,7 +3285,7 @@ static int afpUnlock(sqlite3_file *id, int eFileLock) {
         pFile->eFileLock = NO_LOCK;
 #ifdef SQLITE_WCDB_LOCK_HOOK
         if (unixLockHook.xLockDidChange != NULL) {
-          unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, pInode->eFileLock);
+          unixLockHook.xLockDidChange(unixLockHook.pArg, pFile->zPath, &pFile->pLockHookCtx, pInode->eFileLock);
         }
 #endif
       }
@@ -4927,6 +4935,7 @@ static int unixShmLock(
   if (unixLockHook.xWillShmLock != NULL && (flags & SQLITE_SHM_LOCK) != 0) {
     unixLockHook.xWillShmLock(unixLockHook.pArg,
                               pDbFd->zPath,
+                              &pDbFd->pLockHookCtx,
                               flags & (SQLITE_SHM_SHARED | SQLITE_SHM_EXCLUSIVE),
                               mask);
   }
@@ -4956,7 +4965,7 @@ static int unixShmLock(
       p->sharedMask &= ~mask;
 #ifdef SQLITE_WCDB_LOCK_HOOK
       if (unixLockHook.xShmLockDidChange != NULL) {
-        unixLockHook.xShmLockDidChange(unixLockHook.pArg, pDbFd->zPath, p, p->sharedMask, p->exclMask);
+        unixLockHook.xShmLockDidChange(unixLockHook.pArg, pDbFd->zPath, &pDbFd->pLockHookCtx, p, p->sharedMask, p->exclMask);
       }
 #endif
     }
@@ -4989,7 +4998,7 @@ static int unixShmLock(
       p->sharedMask |= mask;
 #ifdef SQLITE_WCDB_LOCK_HOOK
       if (unixLockHook.xShmLockDidChange != NULL) {
-          unixLockHook.xShmLockDidChange(unixLockHook.pArg, pDbFd->zPath, p, p->sharedMask, p->exclMask);
+          unixLockHook.xShmLockDidChange(unixLockHook.pArg, pDbFd->zPath, &pDbFd->pLockHookCtx, p, p->sharedMask, p->exclMask);
       }
 #endif
     }
@@ -5014,7 +5023,7 @@ static int unixShmLock(
         p->exclMask |= mask;
 #ifdef SQLITE_WCDB_LOCK_HOOK
         if (unixLockHook.xShmLockDidChange != NULL) {
-            unixLockHook.xShmLockDidChange(unixLockHook.pArg, pDbFd->zPath, p, p->sharedMask, p->exclMask);
+            unixLockHook.xShmLockDidChange(unixLockHook.pArg, pDbFd->zPath, &pDbFd->pLockHookCtx, p, p->sharedMask, p->exclMask);
         }
 #endif
       }
@@ -5077,7 +5086,7 @@ static int unixShmUnmap(
   /* Free the connection p */
 #ifdef SQLITE_WCDB_LOCK_HOOK
   if (unixLockHook.xShmLockDidChange != NULL) {
-    unixLockHook.xShmLockDidChange(unixLockHook.pArg, pDbFd->zPath, p, 0, 0);
+    unixLockHook.xShmLockDidChange(unixLockHook.pArg, pDbFd->zPath, &pDbFd->pLockHookCtx, p, 0, 0);
   }
 #endif
   sqlite3_free(p);
@@ -54,11 +54,12 @@ SQLITE_API int sqlite3_table_config_auto_increment(
 #ifdef SQLITE_WCDB_LOCK_HOOK
 /*
  ** Register handlers when lock state changed.
+ ** pCtx points to a pointer kept by the file for the handlers, which is NULL when the file is opened.
  */
-SQLITE_API int sqlite3_lock_hook(void (*xWillLock)(void *pArg, const char* zPath, int eLock),
-                      void (*xLockDidChange)(void *pArg, const char* zPath, int eLock),
-                      void (*xWillShmLock)(void *pArg, const char* zPath, int flags, int mask),
-                      void (*xShmLockDidChange)(void *pArg, const char* zPath, void* id, int sharedMask, int exclMask),
+SQLITE_API int sqlite3_lock_hook(void (*xWillLock)(void *pArg, const char* zPath, void **pCtx, int eLock),
+                      void (*xLockDidChange)(void *pArg, const char* zPath, void **pCtx, int eLock),
+                      void (*xWillShmLock)(void *pArg, const char* zPath, void **pCtx, int flags, int mask),
+                      void (*xShmLockDidChange)(void *pArg, const char* zPath, void **pCtx, void* id, int sharedMask, int exclMask),
                       void *pArg);
 #endif //SQLITE_WCDB_LOCK_HOOK
 
@@ -68,6 +69,11 @@ SQLITE_API int sqlite3_lock_hook(void (*xWillLock)(void *pArg, const char* zPath
  ** Register a handler when checkpoint did happen.
  */
 SQLITE_API void *sqlite3_wal_checkpoint_handler(sqlite3 *, void (*xCallback)(void*, sqlite3*, const char *), void*);
+
+/*
+ ** Passive checkpoint that backfills at most nFrame frames. nFrame <= 0 for no limit.
+ */
+SQLITE_API int sqlite3_wal_checkpoint_frames(sqlite3 *, const char *zDb, int nFrame, int *pnLog, int *pnCkpt);
 #endif // SQLITE_WCDB_CHECKPOINT_HANDLER
 
 #ifdef SQLITE_WCDB_SUSPEND
@@ -87,9 +93,22 @@ void sqlite3_revertCommitOrder(sqlite3 *db);
 void* sqlite3_getCipherContext(sqlite3 *db, const char* schema);
 
 int sqlcipher_codec_ctx_get_reservesize(void *ctx);
+int sqlcipher_codec_ctx_get_kdf_iter(void *ctx);
+int sqlcipher_codec_ctx_get_kdf_algorithm(void *ctx);
+int sqlcipher_codec_ctx_get_hmac_algorithm(void *ctx);
+
+/*
+ ** HMAC-SHA256 of data with key by the crypto provider of codec context. out must be at least 32 bytes.
+ */
+int sqlcipher_codec_keyed_hash(void *iCtx, const void *key, int nKey, const void *data, int nData, void *out);
 
 void* sqlite3Codec(void *iCtx, void *data, unsigned int pgno, int mode);
 
+/*
+ ** Decrypt contiguous pages to the buffer of caller and return the number of pages decrypted.
+ */
+int sqlite3CodecDecryptPages(void *iCtx, const void *data, void *out, unsigned int pgno, int nPage);
+
 int sqlcipher_find_db_index(sqlite3 *db, const char *zDb);
 void sqlite3CodecGetKey(sqlite3* db, int nDb, void **zKey, int *nKey);
 
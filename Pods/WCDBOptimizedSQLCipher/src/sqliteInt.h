@@ -1450,6 +1450,7 @@ struct sqlite3 {
 #ifdef SQLITE_WCDB_CHECKPOINT_HANDLER
   void (*xCheckpointCallback)(void *, sqlite3 *, const char *);
   void *pCheckpointArg;
+  int nCkptFrame;               /* Max frames backfilled by a checkpoint. 0 for no limit */
 #endif
 #endif
   void(*xCollNeeded)(void*,sqlite3*,int eTextRep,const char*);
@@ -1862,6 +1862,13 @@ static int walCheckpoint(
     */
     mxSafeFrame = pWal->hdr.mxFrame;
     mxPage = pWal->hdr.nPage;
+#ifdef SQLITE_WCDB_CHECKPOINT_HANDLER
+    /* A frame-limited checkpoint only backfills the next nCkptFrame frames,
+    ** as if the frames beyond them were in use by a reader. */
+    if( db->nCkptFrame>0 && mxSafeFrame-pInfo->nBackfill>(u32)db->nCkptFrame ){
+      mxSafeFrame = pInfo->nBackfill + db->nCkptFrame;
+    }
+#endif
     for(i=1; i<WAL_NREADER; i++){
       /* Thread-sanitizer reports that the following is an unsafe read,
       ** as some other thread may be in the process of updating the value